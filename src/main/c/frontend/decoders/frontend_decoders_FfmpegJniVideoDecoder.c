@@ -48,21 +48,72 @@ struct context0 {
 };
 
 /**
- * Instantiates an AVFormatContext using media to determine the format.
- * @param context the address the instance of AVFormatContext is written into
- * @param media the encoded video
+ * Instantiates an AVFormatContext using media to determine the format. The context and the AVIOContext reading media
+ * must be freed with free_video_format_context whether this function succeeds or not.
+ * @param context the address the instance of AVFormatContext is written into; NULL is written on failure
+ * @param io_context the address the instance of AVIOContext is written into; it's written before the format context
+ *                   is opened, since a failed opening frees the format context but not the AVIOContext
+ * @param media the encoded video allocated with av_malloc
  * @param media_size the size of media
  * @return 0 on success, <0 on error
  */
-static int retrieve_video_format_context(AVFormatContext **context, uint8_t *media, size_t media_size) {
-	AVIOContext *io_context = avio_alloc_context(media, media_size, 0, NULL, NULL, NULL, NULL);
+static int retrieve_video_format_context(
+	AVFormatContext **context, AVIOContext **io_context, uint8_t *media, size_t media_size
+) {
+	*context = NULL;
+	*io_context = avio_alloc_context(media, media_size, 0, NULL, NULL, NULL, NULL);
+	if (!*io_context) return AVERROR(ENOMEM);
 	*context = avformat_alloc_context();
-	(*context)->pb = io_context;
+	if (!*context) return AVERROR(ENOMEM);
+	(*context)->pb = *io_context;
 	int error_code = avformat_open_input(context, NULL, NULL, NULL);
 	if (error_code) return error_code;
 	return avformat_find_stream_info(*context, NULL);
 }
 
+/**
+ * Frees the contexts instantiated by retrieve_video_format_context and the encoded video they read.
+ * @param context the address of the AVFormatContext instance, which may be NULL
+ * @param io_context the address of the AVIOContext instance, which may be NULL
+ * @param media the encoded video passed to retrieve_video_format_context; it's freed directly only if the AVIOContext
+ *              wasn't allocated, since the AVIOContext may replace its buffer
+ */
+static void free_video_format_context(AVFormatContext **context, AVIOContext **io_context, uint8_t *media) {
+	avformat_close_input(context);
+	if (*io_context) {
+		av_freep(&((*io_context)->buffer));
+		avio_context_free(io_context);
+	} else {
+		av_free(media);
+	}
+}
+
+/**
+ * Copies the region of the java array into a new buffer allocated with av_malloc. If the allocation fails,
+ * a DecodingException is thrown; if the copying fails, the exception thrown by the JVM is left pending.
+ * @param env the java environment
+ * @param array the java array
+ * @param offset the index of the first copied byte
+ * @param length the amount of copied bytes
+ * @param exception_class the class of DecodingException
+ * @return the buffer, or NULL if an exception is pending
+ */
+static uint8_t *copy_byte_array_region(
+	JNIEnv *env, jbyteArray array, jint offset, jint length, jclass exception_class
+) {
+	uint8_t *buffer = av_malloc(length);
+	if (!buffer) {
+		(*env)->ThrowNew(env, exception_class, "Couldn't allocate the buffer of the video clip");
+		return NULL;
+	}
+	(*env)->GetByteArrayRegion(env, array, offset, length, (jbyte *) buffer);
+	if ((*env)->ExceptionCheck(env)) {
+		av_free(buffer);
+		return NULL;
+	}
+	return buffer;
+}
+
 /**
  * Instantiates an AVCodecContext given the specified parameters.
  * @param context the address the instance of AVCodecContext is written into
@@ -178,7 +229,9 @@ static jobject convert_to_java_frame(
  * @param obj the caller
  * @param context_address the memory address of the allocated context data structure containing the necessary data
  * @param context_type the type of the context data structure
- * @param encoded_video the video clip
+ * @param encoded_video the java array containing the video clip
+ * @param encoded_video_offset the index of the first byte of the video clip in encoded_video
+ * @param encoded_video_length the size of the video clip
  * @param offset the number of frames to skip
  * @param total the number of frames to decode
  * @return the java array containing Image instances
@@ -189,6 +242,8 @@ JNIEXPORT jobjectArray JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_deco
 	jlong context_address,
 	jint context_type,
 	jbyteArray encoded_video,
+	jint encoded_video_offset,
+	jint encoded_video_length,
 	jint offset,
 	jint total
 ) {
@@ -197,15 +252,18 @@ JNIEXPORT jobjectArray JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_deco
 	if (context_type == 0) {
 		struct context0 *context = (struct context0 *) context_address;
 
-		// retrieving primitives from the array
-		jsize encoded_video_size = (*env)->GetArrayLength(env, encoded_video);
-		jbyte *encoded_video_data = (*env)->GetByteArrayElements(env, encoded_video, NULL);
+		// copying only the video clip out of the array, which may contain other data
+		jsize encoded_video_size = encoded_video_length;
+		uint8_t *encoded_video_data =
+			copy_byte_array_region(env, encoded_video, encoded_video_offset, encoded_video_size, exception_class);
+		if (!encoded_video_data) return NULL;
 
 		AVFormatContext *format_context;
-		int error_code = retrieve_video_format_context(&format_context, encoded_video_data, encoded_video_size);
+		AVIOContext *io_context;
+		int error_code =
+			retrieve_video_format_context(&format_context, &io_context, encoded_video_data, encoded_video_size);
 		if (error_code) {
-			avio_context_free(&(format_context->pb));
-			avformat_close_input(&format_context);
+			free_video_format_context(&format_context, &io_context, encoded_video_data);
 
 			char error_mes[256];
 			snprintf(error_mes, sizeof(error_mes), "Demuxing failed, error code: %d", error_code);
@@ -224,8 +282,7 @@ JNIEXPORT jobjectArray JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_deco
 			// extracting a packet containing one encoded frame
 			error_code = av_read_frame(format_context, packet);
 			if (error_code) {
-				avio_context_free(&(format_context->pb));
-				avformat_close_input(&format_context);
+				free_video_format_context(&format_context, &io_context, encoded_video_data);
 
 				char error_mes[256];
 				snprintf(error_mes, sizeof(error_mes), "AVPacket initialization failed, error code: %d", error_code);
@@ -236,8 +293,7 @@ JNIEXPORT jobjectArray JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_deco
 			// sending the packet to the decoding pipeline
 			int error_code = avcodec_send_packet(context->codec_context, context->packet);
 			if (error_code) {
-				avio_context_free(&(format_context->pb));
-				avformat_close_input(&format_context);
+				free_video_format_context(&format_context, &io_context, encoded_video_data);
 
 				char error_mes[256];
 				snprintf(error_mes, sizeof(error_mes), "Decoding failed, error code %d", error_code);
@@ -249,8 +305,7 @@ JNIEXPORT jobjectArray JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_deco
 			error_code = avcodec_receive_frame(context->codec_context, context->frame);
 			if (error_code) {
 				av_packet_unref(context->packet);
-				avio_context_free(&(format_context->pb));
-				avformat_close_input(&format_context);
+				free_video_format_context(&format_context, &io_context, encoded_video_data);
 
 				char error_mes[216];
 				snprintf(error_mes, sizeof(error_mes), "Decoding failed, error code %d", error_code);
@@ -267,8 +322,7 @@ JNIEXPORT jobjectArray JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_deco
         	av_packet_unref(context->packet);
         }
 
-		avio_context_free(&(format_context->pb));
-		avformat_close_input(&format_context);
+		free_video_format_context(&format_context, &io_context, encoded_video_data);
 
 		// creating a new java array containing all the decoded frames
 		jclass image_cls = (*env)->FindClass(env, "java/awt/Image");
@@ -319,25 +373,45 @@ JNIEXPORT jint JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_frames (
  * encoded_video.
  * @param env the java environment
  * @param obj the caller
- * @param encoded_video the video clip
+ * @param encoded_video the java array containing the video clip
+ * @param encoded_video_offset the index of the first byte of the video clip in encoded_video
+ * @param encoded_video_length the size of the video clip
  * @param context_type the type of the context data structure
  * @return the memory address of the allocated data structure
  */
 JNIEXPORT jlong JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_initContext(
-	JNIEnv *env, jobject obj, jbyteArray encoded_video, jint context_type
+	JNIEnv *env,
+	jobject obj,
+	jbyteArray encoded_video,
+	jint encoded_video_offset,
+	jint encoded_video_length,
+	jint context_type
 ) {
 	jclass exception_class = (*env)->FindClass(env, "frontend/exceptions/DecodingException");
 
 	if (context_type == 0) {
 		struct context0 *context = calloc(1, sizeof(struct context0));
+		if (!context) {
+			(*env)->ThrowNew(env, exception_class, "Couldn't allocate the context");
+			return (uint64_t)NULL;
+		}
 
-		// extracting primitives from the array
-		jsize encoded_video_size = (*env)->GetArrayLength(env, encoded_video);
-		jbyte *encoded_video_data = (*env)->GetByteArrayElements(env, encoded_video, NULL);
+		// copying only the video clip out of the array, which may contain other data
+		jsize encoded_video_size = encoded_video_length;
+		uint8_t *encoded_video_data =
+			copy_byte_array_region(env, encoded_video, encoded_video_offset, encoded_video_size, exception_class);
+		if (!encoded_video_data) {
+			free(context);
+			return (uint64_t)NULL;
+		}
 
 		AVFormatContext *format_context;
-        int error_code = retrieve_video_format_context(&format_context, encoded_video_data, encoded_video_size);
+		AVIOContext *io_context;
+        int error_code =
+        	retrieve_video_format_context(&format_context, &io_context, encoded_video_data, encoded_video_size);
         if (error_code) {
+        	free_video_format_context(&format_context, &io_context, encoded_video_data);
+        	free(context);
         	char error_mes[256];
         	snprintf(error_mes, sizeof(error_mes), "Demuxing failed, error code: %d", error_code);
         	(*env)->ThrowNew(env, exception_class, error_mes);
@@ -351,9 +425,10 @@ JNIEXPORT jlong JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_initContext
         enum AVPixelFormat pixel_format = vid_stream->codecpar->format;
 
         error_code = retrieve_codec_context(&(context->codec_context), vid_stream->codecpar);
-		avio_context_free(&(format_context->pb));
-		avformat_close_input(&format_context);
+		free_video_format_context(&format_context, &io_context, encoded_video_data);
         if (error_code) {
+        	avcodec_free_context(&(context->codec_context));
+        	free(context);
         	char error_mes[256];
         	snprintf(error_mes, sizeof(error_mes), "Context initialization failed, error code: %d", error_code);
         	(*env)->ThrowNew(env, exception_class, error_mes);
@@ -374,6 +449,8 @@ JNIEXPORT jlong JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_initContext
 				NULL
         	);
         if (!(context->sws_context)) {
+        	avcodec_free_context(&(context->codec_context));
+        	free(context);
         	char error_mes[256];
         	snprintf(error_mes, sizeof(error_mes), "SWS context initialization failed, error code: %d", error_code);
         	(*env)->ThrowNew(env, exception_class, error_mes);
@@ -29,10 +29,10 @@ extern "C" {
 /*
  * Class:     frontend_decoders_FfmpegJniVideoDecoder
  * Method:    decodeFrames
- * Signature: (JI[BII)[Ljava/lang/Object;
+ * Signature: (JI[BIIII)[Ljava/lang/Object;
  */
 JNIEXPORT jobjectArray JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_decodeFrames
-  (JNIEnv *, jobject, jlong, jint, jbyteArray, jint, jint);
+  (JNIEnv *, jobject, jlong, jint, jbyteArray, jint, jint, jint, jint);
 
 /*
  * Class:     frontend_decoders_FfmpegJniVideoDecoder
@@ -45,10 +45,10 @@ JNIEXPORT jint JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_frames
 /*
  * Class:     frontend_decoders_FfmpegJniVideoDecoder
  * Method:    initContext
- * Signature: ([BI)J
+ * Signature: ([BIII)J
  */
 JNIEXPORT jlong JNICALL Java_frontend_decoders_FfmpegJniVideoDecoder_initContext
-  (JNIEnv *, jobject, jbyteArray, jint);
+  (JNIEnv *, jobject, jbyteArray, jint, jint, jint);
 
 /*
  * Class:     frontend_decoders_FfmpegJniVideoDecoder
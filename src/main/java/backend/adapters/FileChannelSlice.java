@@ -0,0 +1,207 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.adapters;
+
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.FileChannel;
+import java.nio.channels.FileLock;
+import java.nio.channels.NonWritableChannelException;
+import java.nio.channels.ReadableByteChannel;
+import java.nio.channels.WritableByteChannel;
+
+/**
+ * FileChannelSlice is a read-only view of a contiguous region of another {@link FileChannel}. The positions of
+ * the slice are relative to the beginning of the region, and the slice never reads beyond its end. Every slice keeps
+ * its own position and reads the underlying channel with the positional operations, so any amount of slices of
+ * the same channel may be read concurrently. Closing a slice doesn't close the underlying channel, but it runs
+ * the action the slice was constructed with, so the owner of the underlying channel can tell when the slice is no
+ * longer read.<br>
+ * Since the slice is a {@link FileChannel} itself, {@link #transferTo(long, long, WritableByteChannel)} and
+ * {@link #map(MapMode, long, long)} are delegated to the underlying channel. Note that transferTo avoids copying
+ * the data only when the target is a file or a socket channel; the servlet responses are neither, so the slices
+ * served to the clients are read through a buffer like any other channel.
+ */
+public class FileChannelSlice extends FileChannel {
+
+	private final Logger logger = LoggerFactory.getLogger(FileChannelSlice.class);
+
+	private final FileChannel fileChannel;
+
+	private final long offset;
+
+	private final long length;
+
+	private final Runnable onClose;
+
+	private long position = 0;
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param fileChannel the underlying channel
+	 * @param offset the position in the underlying channel at which the region begins
+	 * @param length the length of the region
+	 */
+	public FileChannelSlice(@Nonnull FileChannel fileChannel, long offset, long length) {
+		this(fileChannel, offset, length, () -> { });
+	}
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param fileChannel the underlying channel
+	 * @param offset the position in the underlying channel at which the region begins
+	 * @param length the length of the region
+	 * @param onClose the action run when this slice is closed
+	 */
+	public FileChannelSlice(@Nonnull FileChannel fileChannel, long offset, long length, @Nonnull Runnable onClose) {
+		if (offset < 0 || length < 0) throw new IllegalArgumentException("The offset and the length can't be negative");
+		this.fileChannel = fileChannel;
+		this.offset = offset;
+		this.length = length;
+		this.onClose = onClose;
+
+		logger.debug("{} instantiated, FileChannel: {}, offset: {}, length: {}", this, fileChannel, offset, length);
+	}
+
+	@Override
+	public synchronized int read(ByteBuffer dst) throws IOException {
+		int bytesRead = read(dst, position);
+		if (bytesRead > 0) position += bytesRead;
+		return bytesRead;
+	}
+
+	@Override
+	public synchronized long read(ByteBuffer[] dsts, int dstsOffset, int dstsLength) throws IOException {
+		long totalBytesRead = 0;
+		for (int i = dstsOffset; i < dstsOffset + dstsLength; i++) {
+			int bytesRead = read(dsts[i]);
+			if (bytesRead == -1) return totalBytesRead == 0 ? -1 : totalBytesRead;
+			totalBytesRead += bytesRead;
+			if (dsts[i].hasRemaining()) break;
+		}
+		return totalBytesRead;
+	}
+
+	@Override
+	public int read(ByteBuffer dst, long position) throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		if (position < 0) throw new IllegalArgumentException("The position can't be negative");
+		if (position >= length) return -1;
+		if (!dst.hasRemaining()) return 0;
+
+		int limit = dst.limit();
+		dst.limit(dst.position() + (int) Math.min(dst.remaining(), length - position));
+		try {
+			return fileChannel.read(dst, offset + position);
+		} finally {
+			dst.limit(limit);
+		}
+	}
+
+	@Override
+	public int write(ByteBuffer src) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public long write(ByteBuffer[] srcs, int srcsOffset, int srcsLength) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public int write(ByteBuffer src, long position) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public synchronized long position() throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		return position;
+	}
+
+	@Override
+	public synchronized FileChannel position(long newPosition) throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		if (newPosition < 0) throw new IllegalArgumentException("The position can't be negative");
+		position = newPosition;
+		return this;
+	}
+
+	@Override
+	public long size() throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		return length;
+	}
+
+	@Override
+	public FileChannel truncate(long size) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public void force(boolean metaData) { }
+
+	@Override
+	public long transferTo(long position, long count, WritableByteChannel target) throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		if (position < 0 || count < 0) {
+			throw new IllegalArgumentException("The position and the count can't be negative");
+		}
+		if (position >= length) return 0;
+		return fileChannel.transferTo(offset + position, Math.min(count, length - position), target);
+	}
+
+	@Override
+	public long transferFrom(ReadableByteChannel src, long position, long count) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public MappedByteBuffer map(MapMode mode, long position, long size) throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		if (mode != MapMode.READ_ONLY) throw new NonWritableChannelException();
+		if (position < 0 || size < 0 || position + size > length) {
+			throw new IllegalArgumentException("The mapped region exceeds the slice");
+		}
+		return fileChannel.map(mode, offset + position, size);
+	}
+
+	@Override
+	public FileLock lock(long position, long size, boolean shared) {
+		throw new UnsupportedOperationException("A slice can't be locked");
+	}
+
+	@Override
+	public FileLock tryLock(long position, long size, boolean shared) {
+		throw new UnsupportedOperationException("A slice can't be locked");
+	}
+
+	@Override
+	protected void implCloseChannel() {
+		onClose.run();
+		logger.debug("{} closed", this);
+	}
+}
@@ -0,0 +1,120 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.adapters;
+
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.lang.foreign.MemorySegment;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.NonWritableChannelException;
+import java.nio.channels.SeekableByteChannel;
+
+/**
+ * A read-only implementation of {@link SeekableByteChannel} backed by a {@link MemorySegment}, e.g. a memory-mapped
+ * file. The segment may be shared by any amount of channels, since every channel keeps its own position. The action
+ * passed to the constructor is run once, when the channel is closed, so the owner of the segment knows when
+ * the channel no longer reads it.
+ */
+public class MemorySegmentChannel implements SeekableByteChannel {
+
+	private final Logger logger = LoggerFactory.getLogger(MemorySegmentChannel.class);
+
+	private final MemorySegment segment;
+
+	private final Runnable onClose;
+
+	private long position = 0;
+
+	private volatile boolean isOpen = true;
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param segment the source data for this channel
+	 * @param onClose the action run when this channel is closed
+	 */
+	public MemorySegmentChannel(@Nonnull MemorySegment segment, @Nonnull Runnable onClose) {
+		this.segment = segment;
+		this.onClose = onClose;
+
+		logger.debug("{} instantiated, segment size: {}", this, segment.byteSize());
+	}
+
+	@Override
+	public synchronized int read(ByteBuffer byteBuffer) throws IOException {
+		if (byteBuffer == null) throw new NullPointerException();
+		if (!isOpen()) throw new ClosedChannelException();
+		if (byteBuffer.isReadOnly()) throw new IllegalArgumentException();
+		if (byteBuffer.remaining() == 0) return 0;
+		if (position >= segment.byteSize()) return -1;
+
+		int bytesRead = (int) Math.min(byteBuffer.remaining(), segment.byteSize() - position);
+		byteBuffer.put(segment.asSlice(position, bytesRead).asByteBuffer());
+		position += bytesRead;
+		return bytesRead;
+	}
+
+	@Override
+	public int write(ByteBuffer byteBuffer) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public synchronized long position() throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		return position;
+	}
+
+	@Override
+	public synchronized SeekableByteChannel position(long newPosition) throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		if (newPosition < 0) throw new IllegalArgumentException();
+		position = newPosition;
+		return this;
+	}
+
+	@Override
+	public long size() throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		return segment.byteSize();
+	}
+
+	@Override
+	public SeekableByteChannel truncate(long size) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public boolean isOpen() {
+		return isOpen;
+	}
+
+	@Override
+	public synchronized void close() {
+		if (isOpen()) {
+			isOpen = false;
+			onClose.run();
+			logger.debug("{} closed", this);
+		}
+	}
+}
@@ -0,0 +1,166 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.adapters;
+
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.EOFException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.NonWritableChannelException;
+import java.nio.channels.SeekableByteChannel;
+
+/**
+ * A read-only implementation of {@link SeekableByteChannel} that streams a remote resource of a known size, e.g.
+ * an object fetched with a ranged HTTP request. The content isn't buffered: the channel reads the current stream as
+ * the caller reads the channel. Changing the position closes the current stream, and the next read opens a new one
+ * starting at the new position with the {@link RangeOpener} passed to the constructor.
+ */
+public class RangedStreamChannel implements SeekableByteChannel {
+
+	/**
+	 * RangeOpener opens a stream of the resource starting at the specified position.
+	 */
+	@FunctionalInterface
+	public interface RangeOpener {
+
+		/**
+		 * Opens a stream of the resource starting at the position.
+		 * @param position the position of the first byte of the stream; less than the size of the resource
+		 * @return the stream
+		 * @throws IOException if the stream can't be opened
+		 */
+		@Nonnull
+		InputStream open(long position) throws IOException;
+	}
+
+	private static final int BUFFER_SIZE = 64 * 1024;
+
+	private final Logger logger = LoggerFactory.getLogger(RangedStreamChannel.class);
+
+	private final long size;
+
+	private final RangeOpener rangeOpener;
+
+	private InputStream stream;
+
+	private byte[] buffer = null;
+
+	private long position = 0;
+
+	private volatile boolean isOpen = true;
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param stream the stream of the resource starting at the position 0, or null to open it on the first read
+	 * @param size the size of the resource
+	 * @param rangeOpener the opener of the streams starting at other positions
+	 */
+	public RangedStreamChannel(@Nullable InputStream stream, long size, @Nonnull RangeOpener rangeOpener) {
+		if (size < 0) throw new IllegalArgumentException("The size is negative");
+		this.stream = stream;
+		this.size = size;
+		this.rangeOpener = rangeOpener;
+
+		logger.debug("{} instantiated, size: {}", this, size);
+	}
+
+	@Override
+	public synchronized int read(ByteBuffer byteBuffer) throws IOException {
+		if (byteBuffer == null) throw new NullPointerException();
+		if (!isOpen()) throw new ClosedChannelException();
+		if (byteBuffer.isReadOnly()) throw new IllegalArgumentException();
+		if (byteBuffer.remaining() == 0) return 0;
+		if (position >= size) return -1;
+
+		if (stream == null) stream = rangeOpener.open(position);
+		int length = (int) Math.min(byteBuffer.remaining(), size - position);
+		int bytesRead;
+		if (byteBuffer.hasArray()) {
+			bytesRead = stream.read(byteBuffer.array(), byteBuffer.arrayOffset() + byteBuffer.position(), length);
+			if (bytesRead > 0) byteBuffer.position(byteBuffer.position() + bytesRead);
+		} else {
+			if (buffer == null) buffer = new byte[BUFFER_SIZE];
+			bytesRead = stream.read(buffer, 0, Math.min(length, BUFFER_SIZE));
+			if (bytesRead > 0) byteBuffer.put(buffer, 0, bytesRead);
+		}
+		if (bytesRead == -1) throw new EOFException("The stream ended at " + position + " of " + size + " bytes");
+		position += bytesRead;
+		return bytesRead;
+	}
+
+	@Override
+	public int write(ByteBuffer byteBuffer) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public synchronized long position() throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		return position;
+	}
+
+	@Override
+	public synchronized SeekableByteChannel position(long newPosition) throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		if (newPosition < 0) throw new IllegalArgumentException();
+		if (newPosition != position) {
+			closeStream();
+			position = newPosition;
+		}
+		return this;
+	}
+
+	@Override
+	public long size() throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		return size;
+	}
+
+	@Override
+	public SeekableByteChannel truncate(long size) {
+		throw new NonWritableChannelException();
+	}
+
+	@Override
+	public boolean isOpen() {
+		return isOpen;
+	}
+
+	@Override
+	public synchronized void close() {
+		if (isOpen()) {
+			isOpen = false;
+			closeStream();
+			logger.debug("{} closed", this);
+		}
+	}
+
+	private void closeStream() {
+		if (stream != null) {
+			try { stream.close(); } catch (Exception ignored) { }
+			stream = null;
+		}
+	}
+}
@@ -24,13 +24,97 @@ import jakarta.annotation.Nonnull;
 import java.io.IOException;
 import java.io.OutputStream;
 import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.ClosedChannelException;
 import java.nio.channels.ReadableByteChannel;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.channels.WritableByteChannel;
 
 /**
- * A set of methods to provide basic IO utilities.
+ * A set of methods to provide basic IO utilities. The buffers used to transfer the data are acquired from
+ * a {@link DirectBufferPool}, which can be replaced with {@link #setBufferPool(DirectBufferPool)}. The data written
+ * into an {@link OutputStream}, e.g. the servlet output stream of a response, is transferred through pooled heap
+ * buffers whose backing arrays are written into the stream directly; a direct buffer would be copied into a heap array
+ * by the stream anyway. Only the data written into other channels is transferred through pooled direct buffers.
  */
 public class DataStreams {
 
+	private static volatile DirectBufferPool bufferPool = new DirectBufferPool(
+		DirectBufferPool.DEFAULT_CHUNK_SIZE, DirectBufferPool.DEFAULT_BUFFERS_PER_SIZE_CLASS
+	);
+
+	/**
+	 * OutputStreamChannel writes into an {@link OutputStream}. Unlike the channel returned by
+	 * {@link Channels#newChannel(OutputStream)}, which copies every buffer into a temporary array of its own, it writes
+	 * the backing array of a heap buffer into the stream directly. Closing the channel closes the stream.
+	 */
+	private static class OutputStreamChannel implements WritableByteChannel {
+
+		private final OutputStream output;
+
+		private volatile boolean open = true;
+
+		private OutputStreamChannel(OutputStream output) {
+			this.output = output;
+		}
+
+		@Override
+		public int write(ByteBuffer source) throws IOException {
+			if (!open) throw new ClosedChannelException();
+			int length = source.remaining();
+			if (source.hasArray()) {
+				output.write(source.array(), source.arrayOffset() + source.position(), length);
+				source.position(source.limit());
+			} else {
+				byte[] array = new byte[length];
+				source.get(array);
+				output.write(array);
+			}
+			return length;
+		}
+
+		@Override
+		public boolean isOpen() {
+			return open;
+		}
+
+		@Override
+		public void close() throws IOException {
+			open = false;
+			output.close();
+		}
+	}
+
+	/**
+	 * Returns the pool the buffers are acquired from.
+	 * @return the buffer pool
+	 */
+	@Nonnull
+	public static DirectBufferPool getBufferPool() {
+		return bufferPool;
+	}
+
+	/**
+	 * Sets the pool the buffers are acquired from.
+	 * @param pool the buffer pool
+	 */
+	public static void setBufferPool(@Nonnull DirectBufferPool pool) {
+		bufferPool = pool;
+	}
+
+	/**
+	 * Returns output as a {@link WritableByteChannel}. If output already implements it, output itself is returned;
+	 * otherwise output is wrapped into a channel that the data is transferred into through heap buffers, which it
+	 * writes into output without copying them.
+	 * @param output the output stream
+	 * @return the channel writing into output
+	 */
+	@Nonnull
+	public static WritableByteChannel channel(@Nonnull OutputStream output) {
+		if (output instanceof WritableByteChannel writableByteChannel) return writableByteChannel;
+		return new OutputStreamChannel(output);
+	}
+
 	/**
 	 * Transfers all available data from input to output. This method blocks until the data is transferred.
 	 * @param input the source of the data
@@ -38,13 +122,68 @@ public class DataStreams {
 	 * @throws IOException if some I/O exception occurs
 	 */
 	public static void passData(@Nonnull ReadableByteChannel input, @Nonnull OutputStream output) throws IOException {
-		byte[] array = new byte[1024 * 8];
-		ByteBuffer buffer = ByteBuffer.wrap(array);
-		while (true) {
-			int bytesRead = input.read(buffer);
-			if (bytesRead == -1) return;
-			output.write(array, 0, bytesRead);
-			buffer.position(0);
+		passData(input, channel(output));
+	}
+
+	/**
+	 * Transfers all available data from input to output. This method blocks until the data is transferred.
+	 * @param input the source of the data
+	 * @param output the destination of the data
+	 * @throws IOException if some I/O exception occurs
+	 */
+	public static void passData(
+		@Nonnull ReadableByteChannel input, @Nonnull WritableByteChannel output
+	) throws IOException {
+		DirectBufferPool pool = bufferPool;
+		long expectedSize = input instanceof SeekableByteChannel seekableByteChannel ?
+			seekableByteChannel.size() - seekableByteChannel.position() :
+			pool.getChunkSize();
+		ByteBuffer buffer = acquire(pool, expectedSize, output);
+		try {
+			while (input.read(buffer) != -1) {
+				buffer.flip();
+				while (buffer.hasRemaining()) output.write(buffer);
+				buffer.clear();
+			}
+		} finally {
+			pool.release(buffer);
 		}
 	}
+
+	/**
+	 * Transfers exactly length bytes from input to output starting at the input's current position. The data is
+	 * copied through a pooled buffer in chunks. This method blocks until the data is transferred.
+	 * @param input the source of the data
+	 * @param length the amount of bytes to transfer
+	 * @param output the destination of the data
+	 * @throws IOException if some I/O exception occurs, or input reaches the end of stream before length bytes
+	 *                     are transferred
+	 */
+	public static void transferData(
+		@Nonnull SeekableByteChannel input, long length, @Nonnull WritableByteChannel output
+	) throws IOException {
+		assert length >= 0;
+
+		DirectBufferPool pool = bufferPool;
+		ByteBuffer buffer = acquire(pool, length, output);
+		try {
+			long remaining = length;
+			while (remaining > 0) {
+				buffer.limit((int) Math.min(buffer.capacity(), remaining));
+				int bytesRead = input.read(buffer);
+				if (bytesRead == -1) throw new IOException("Unexpected end of stream");
+				buffer.flip();
+				while (buffer.hasRemaining()) output.write(buffer);
+				buffer.clear();
+				remaining -= bytesRead;
+			}
+		} finally {
+			pool.release(buffer);
+		}
+	}
+
+	// The streams take their data from heap arrays, so they are written from heap buffers
+	private static ByteBuffer acquire(DirectBufferPool pool, long size, WritableByteChannel output) {
+		return output instanceof OutputStreamChannel ? pool.acquireHeap(size) : pool.acquire(size);
+	}
 }
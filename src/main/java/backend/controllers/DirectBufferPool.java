@@ -0,0 +1,185 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.controllers;
+
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * DirectBufferPool is a thread-safe pool of direct {@link ByteBuffer}s used on the server I/O path, along with heap
+ * buffers for the transfers into output streams, which take their data from heap arrays. The buffers are grouped into
+ * size classes, which are powers of two starting at {@link #SMALLEST_SIZE_CLASS} and ending at the chunk size, so
+ * small transfers don't occupy large buffers; the direct and the heap buffers have size classes of their own.
+ * A request for more than the chunk size is served with a buffer of the chunk size, and the data is transferred in
+ * several chunks.<br>
+ * Every size class keeps a limited amount of buffers; a buffer released into a full size class is left to the garbage
+ * collector. The pool counts hits, the acquisitions served with a pooled buffer, and misses, the acquisitions that
+ * required a new allocation.
+ */
+public class DirectBufferPool {
+
+	/**
+	 * The smallest allowed chunk size.
+	 */
+	public static final int MINIMUM_CHUNK_SIZE = 64 * 1024;
+
+	/**
+	 * The largest allowed chunk size.
+	 */
+	public static final int MAXIMUM_CHUNK_SIZE = 1024 * 1024;
+
+	/**
+	 * The chunk size used if it's not configured.
+	 */
+	public static final int DEFAULT_CHUNK_SIZE = 256 * 1024;
+
+	/**
+	 * The amount of buffers every size class keeps if it's not configured.
+	 */
+	public static final int DEFAULT_BUFFERS_PER_SIZE_CLASS = 32;
+
+	/**
+	 * The capacity of the buffers of the smallest size class.
+	 */
+	public static final int SMALLEST_SIZE_CLASS = 8 * 1024;
+
+	private final Logger logger = LoggerFactory.getLogger(DirectBufferPool.class);
+
+	private final int chunkSize;
+
+	private final List<ArrayBlockingQueue<ByteBuffer>> sizeClasses = new ArrayList<>();
+
+	private final List<ArrayBlockingQueue<ByteBuffer>> heapSizeClasses = new ArrayList<>();
+
+	private final LongAdder hits = new LongAdder();
+
+	private final LongAdder misses = new LongAdder();
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param chunkSize the capacity of the buffers of the largest size class; must be a power of two between
+	 *                  {@link #MINIMUM_CHUNK_SIZE} and {@link #MAXIMUM_CHUNK_SIZE}
+	 * @param buffersPerSizeClass the maximum amount of buffers every size class keeps
+	 */
+	public DirectBufferPool(int chunkSize, int buffersPerSizeClass) {
+		if (chunkSize < MINIMUM_CHUNK_SIZE || chunkSize > MAXIMUM_CHUNK_SIZE || Integer.bitCount(chunkSize) != 1) {
+			throw new IllegalArgumentException(
+				"The chunk size must be a power of two between " + MINIMUM_CHUNK_SIZE + " and " + MAXIMUM_CHUNK_SIZE
+			);
+		}
+		if (buffersPerSizeClass < 1) {
+			throw new IllegalArgumentException("The amount of buffers per size class must be positive");
+		}
+		this.chunkSize = chunkSize;
+		for (int capacity = SMALLEST_SIZE_CLASS; capacity <= chunkSize; capacity <<= 1) {
+			sizeClasses.add(new ArrayBlockingQueue<>(buffersPerSizeClass));
+			heapSizeClasses.add(new ArrayBlockingQueue<>(buffersPerSizeClass));
+		}
+
+		logger.debug(
+			"{} instantiated, chunkSize: {}, buffersPerSizeClass: {}", this, chunkSize, buffersPerSizeClass
+		);
+	}
+
+	/**
+	 * Returns a cleared direct buffer that is able to hold size bytes, or the buffer of the chunk size if size exceeds
+	 * it. The buffer must be returned to the pool with {@link #release(ByteBuffer)} once it's no longer used.
+	 * @param size the amount of bytes the caller intends to put into the buffer
+	 * @return the direct buffer
+	 */
+	@Nonnull
+	public ByteBuffer acquire(long size) {
+		return acquire(size, true);
+	}
+
+	/**
+	 * Returns a cleared heap buffer that is able to hold size bytes, or the buffer of the chunk size if size exceeds
+	 * it. The buffer must be returned to the pool with {@link #release(ByteBuffer)} once it's no longer used.
+	 * @param size the amount of bytes the caller intends to put into the buffer
+	 * @return the heap buffer
+	 */
+	@Nonnull
+	public ByteBuffer acquireHeap(long size) {
+		return acquire(size, false);
+	}
+
+	/**
+	 * Returns the buffer to the pool. Buffers that weren't acquired from a pool of this configuration are ignored.
+	 * @param buffer the buffer
+	 */
+	public void release(@Nonnull ByteBuffer buffer) {
+		int capacity = buffer.capacity();
+		if (capacity < SMALLEST_SIZE_CLASS || capacity > chunkSize || Integer.bitCount(capacity) != 1) return;
+		if (buffer.isDirect()) {
+			sizeClasses.get(sizeClassOf(capacity)).offer(buffer.clear());
+		} else if (buffer.hasArray() && buffer.arrayOffset() == 0 && buffer.array().length == capacity) {
+			heapSizeClasses.get(sizeClassOf(capacity)).offer(buffer.clear());
+		}
+	}
+
+	/**
+	 * Returns the capacity of the buffers of the largest size class.
+	 * @return the chunk size
+	 */
+	public int getChunkSize() {
+		return chunkSize;
+	}
+
+	/**
+	 * Returns the amount of acquisitions that were served with a pooled buffer.
+	 * @return the amount of hits
+	 */
+	public long getHits() {
+		return hits.sum();
+	}
+
+	/**
+	 * Returns the amount of acquisitions that required allocating a new buffer.
+	 * @return the amount of misses
+	 */
+	public long getMisses() {
+		return misses.sum();
+	}
+
+	private ByteBuffer acquire(long size, boolean direct) {
+		int sizeClass = sizeClassOf((int) Math.min(Math.max(size, 1), chunkSize));
+		ByteBuffer buffer = (direct ? sizeClasses : heapSizeClasses).get(sizeClass).poll();
+		if (buffer != null) {
+			hits.increment();
+			return buffer.clear();
+		}
+		misses.increment();
+		int capacity = SMALLEST_SIZE_CLASS << sizeClass;
+		return direct ? ByteBuffer.allocateDirect(capacity) : ByteBuffer.allocate(capacity);
+	}
+
+	private static int sizeClassOf(int size) {
+		if (size <= SMALLEST_SIZE_CLASS) return 0;
+		int capacity = Integer.highestOneBit(size - 1) << 1;
+		return Integer.numberOfTrailingZeros(capacity) - Integer.numberOfTrailingZeros(SMALLEST_SIZE_CLASS);
+	}
+}
@@ -19,6 +19,8 @@
 
 package backend.controllers;
 
+import backend.converters.MediaFetchFramedBinaryConverter;
+import backend.converters.MediaFetchHttpMessageConverter;
 import backend.exceptions.InvalidParameterException;
 import backend.models.WebRequestOriginator;
 import backend.models.MediaFetch;
@@ -29,10 +31,15 @@ import jakarta.servlet.http.HttpServletResponse;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 import org.springframework.beans.factory.annotation.Autowired;
+import org.springframework.http.HttpHeaders;
+import org.springframework.http.InvalidMediaTypeException;
+import org.springframework.http.MediaType;
 import org.springframework.web.bind.annotation.GetMapping;
+import org.springframework.web.bind.annotation.RequestHeader;
 import org.springframework.web.bind.annotation.RequestMapping;
 import org.springframework.web.bind.annotation.RequestParam;
 import org.springframework.web.bind.annotation.RestController;
+import org.springframework.web.servlet.mvc.method.annotation.StreamingResponseBody;
 
 import java.util.UUID;
 import java.util.concurrent.Callable;
@@ -46,14 +53,44 @@ import java.util.concurrent.Callable;
 @RequestMapping("/")
 public class HttpRequestController {
 
+	/**
+	 * The header of a truncated FETCH response that specifies the offset of the first clip that wasn't returned.
+	 */
+	public static final String CONTINUATION_OFFSET_HEADER = "Rubus-Continuation-Offset";
+
+	/**
+	 * The content type of LIST and INFO responses. Only the responses of this type are compressed, so media is never
+	 * compressed.
+	 */
+	public static final String METADATA_MEDIA_TYPE = "application/bson";
+
+	/**
+	 * The LIST search mode that matches whole words of the search query; it's used if no search mode is specified.
+	 */
+	public static final String FULL_TEXT_SEARCH_MODE = "full_text";
+
+	/**
+	 * The LIST search mode that matches the titles containing the search query, including partial words, for
+	 * the search-as-you-type suggestions; it requires a limit and doesn't support cursors.
+	 */
+	public static final String PREFIX_SEARCH_MODE = "prefix";
+
 	private final Logger logger = LoggerFactory.getLogger(HttpRequestController.class);
 
 	@Autowired
 	private RequestProcessor requestProcessor;
 
+	@Autowired
+	private MediaFetchHttpMessageConverter mediaFetchHttpMessageConverter;
+
 	@GetMapping(params = "request_type=LIST")
 	public Callable<MediaList> listRequest(
-		@RequestParam("search_query") String searchQuery, HttpServletResponse response, HttpServletRequest request
+		@RequestParam("search_query") String searchQuery,
+		@RequestParam(value = "limit", required = false) Integer limit,
+		@RequestParam(value = "cursor", required = false) String cursor,
+		@RequestParam(value = "search_mode", required = false) String searchMode,
+		HttpServletResponse response,
+		HttpServletRequest request
 	) {
 		if (logger.isInfoEnabled()) {
 			logger.info(
@@ -63,8 +100,18 @@ public class HttpRequestController {
 			);
 		}
 		return () -> {
-			response.setContentType("application/octet-stream");
-			return requestProcessor.listRequest(searchQuery, new WebRequestOriginator(request.getSession().getId()));
+			response.setContentType(METADATA_MEDIA_TYPE);
+			WebRequestOriginator requestOriginator = new WebRequestOriginator(request.getSession().getId());
+			if (PREFIX_SEARCH_MODE.equals(searchMode)) {
+				if (limit == null || cursor != null) throw new InvalidParameterException();
+				return requestProcessor.suggestRequest(searchQuery, limit, requestOriginator);
+			}
+			if (searchMode != null && !FULL_TEXT_SEARCH_MODE.equals(searchMode)) throw new InvalidParameterException();
+			if (limit == null) {
+				if (cursor != null) throw new InvalidParameterException();
+				return requestProcessor.listRequest(searchQuery, requestOriginator);
+			}
+			return requestProcessor.listRequest(searchQuery, limit, cursor, requestOriginator);
 		};
 	}
 
@@ -80,7 +127,7 @@ public class HttpRequestController {
 			);
 		}
 		return () -> {
-			response.setContentType("application/octet-stream");
+			response.setContentType(METADATA_MEDIA_TYPE);
 			UUID id;
 			try {
 				id = UUID.fromString(mediaId);
@@ -92,10 +139,11 @@ public class HttpRequestController {
 	}
 
 	@GetMapping(params = "request_type=FETCH")
-	public Callable<MediaFetch> fetchRequest(
+	public StreamingResponseBody fetchRequest(
 		@RequestParam("media_id") String mediaId,
 		@RequestParam("clip_offset") int clipOffset,
 		@RequestParam("clip_amount") int clipAmount,
+		@RequestHeader(value = HttpHeaders.ACCEPT, required = false) String accept,
 		HttpServletResponse response,
 		HttpServletRequest request
 	) {
@@ -106,19 +154,44 @@ public class HttpRequestController {
 				constructFullURL(request.getRequestURL().toString(), request.getQueryString())
 			);
 		}
-		return () -> {
-			response.setContentType("application/octet-stream");
+		// the body is written by the async executor with blocking writes, so a slow client holds back the transfer
+		// rather than the data being buffered, and it occupies a virtual thread instead of a container thread
+		return outputStream -> {
 			UUID id;
 			try {
 				id = UUID.fromString(mediaId);
 			} catch (IllegalArgumentException e) {
 				throw new InvalidParameterException();
 			}
-			return requestProcessor
+			MediaFetch mediaFetch = requestProcessor
 				.fetchRequest(id, clipOffset, clipAmount, new WebRequestOriginator(request.getSession().getId()));
+			int returnedAmount = mediaFetch.video().length;
+			if (returnedAmount < clipAmount) {
+				response.setHeader(CONTINUATION_OFFSET_HEADER, Integer.toString(clipOffset + returnedAmount));
+			}
+			MediaType contentType = isFramedFormatAccepted(accept) ?
+				MediaType.parseMediaType(MediaFetchFramedBinaryConverter.MEDIA_TYPE) :
+				MediaType.APPLICATION_OCTET_STREAM;
+			response.setContentType(contentType.toString());
+			mediaFetchHttpMessageConverter.write(mediaFetch, contentType, DataStreams.channel(outputStream));
 		};
 	}
 
+	private boolean isFramedFormatAccepted(String accept) {
+		if (accept == null) return false;
+		MediaType framedMediaType = MediaType.parseMediaType(MediaFetchFramedBinaryConverter.MEDIA_TYPE);
+		try {
+			return MediaType
+				.parseMediaTypes(accept)
+				.stream()
+				.anyMatch(
+					mediaType -> framedMediaType.equalsTypeAndSubtype(mediaType) && mediaType.getQualityValue() > 0
+				);
+		} catch (InvalidMediaTypeException e) {
+			return false;
+		}
+	}
+
 	private String constructFullURL(String url, String urlParameters) {
 		StringBuilder uri = new StringBuilder(url);
 		if (!urlParameters.isEmpty()) uri.append("?").append(urlParameters);
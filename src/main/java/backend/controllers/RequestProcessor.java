@@ -21,27 +21,42 @@ package backend.controllers;
 
 import backend.authontication.Authenticator;
 import backend.exceptions.InvalidParameterException;
+import backend.exceptions.QueryingException;
 import backend.interactors.MediaProvider;
 import backend.models.*;
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import java.io.IOException;
 import java.nio.channels.SeekableByteChannel;
 import java.util.*;
 
 /**
  * RequestProcessor defines a set of methods to process web requests and generate respective responses.
- * The methods are called by framework-extended classes and their results converted to appropriate formats.
+ * The methods are called by framework-extended classes and their results converted to appropriate formats.<br>
+ * The size of a FETCH response is limited by the maximum amount of clips and the maximum amount of bytes per request.
+ * If the requested clips exceed either limit, the response is truncated to the clips that fit; the client continues
+ * from the offset that follows the last returned clip.
  */
 public class RequestProcessor {
 
+	/**
+	 * The minimum length of the prefix the media are suggested for.
+	 */
+	public static final int MIN_PREFIX_LENGTH = 3;
+
 	private final Logger logger = LoggerFactory.getLogger(RequestProcessor.class);
 
 	private MediaProvider mediaProvider;
 
 	private Authenticator authenticator;
 
+	private volatile int maxClipsPerFetch = Integer.MAX_VALUE;
+
+	private volatile long maxBytesPerFetch = Long.MAX_VALUE;
+
 	/**
 	 * Constructs an instance of this class.
 	 * @param mediaProvider the {@link MediaProvider} instance
@@ -85,6 +100,61 @@ public class RequestProcessor {
 		);
 	}
 
+	/**
+	 * Requests a single page of media that match the specified search query. The media are ordered by how well they
+	 * match the search query; the cursor of the returned page is passed to request the following page.
+	 * @param searchQuery the search query
+	 * @param limit the maximum amount of media in the page
+	 * @param cursor the cursor of the previous page, or null to request the first page
+	 * @param requestOriginator the client that made the request
+	 * @return a {@link MediaList} instance
+	 * @throws InvalidParameterException if limit isn't positive or cursor is invalid
+	 * @throws backend.exceptions.AuthenticationException if authentication fails
+	 */
+	public MediaList listRequest(
+		@Nonnull String searchQuery, int limit, @Nullable String cursor, @Nonnull RequestOriginator requestOriginator
+	) throws InvalidParameterException {
+		if (limit <= 0) throw new InvalidParameterException();
+
+		Viewer viewer = authenticator.authenticate(requestOriginator);
+		MediaPage page;
+		try {
+			page = getMediaProvider().searchMedia(viewer, searchQuery, limit, cursor);
+		} catch (IllegalArgumentException e) {
+			throw new InvalidParameterException(e);
+		}
+		LinkedHashMap<UUID, String> pageMedia = new LinkedHashMap<>();
+		for (Media media: page.media()) {
+			pageMedia.put(media.getID(), media.getTitle());
+		}
+		return new MediaList(pageMedia, page.cursor());
+	}
+
+	/**
+	 * Requests at most limit media whose title contains the prefix, e.g. the beginning of a word the user is still
+	 * typing. The media are ordered by how well their title matches the prefix, and the result isn't paged.
+	 * The prefix must be at least {@link #MIN_PREFIX_LENGTH} characters long without the surrounding whitespace, since
+	 * a shorter one matches too many titles and can't be served by a trigram index.
+	 * @param prefix the prefix
+	 * @param limit the maximum amount of media
+	 * @param requestOriginator the client that made the request
+	 * @return a {@link MediaList} instance
+	 * @throws InvalidParameterException if limit isn't positive or the prefix is too short
+	 * @throws backend.exceptions.AuthenticationException if authentication fails
+	 */
+	public MediaList suggestRequest(
+		@Nonnull String prefix, int limit, @Nonnull RequestOriginator requestOriginator
+	) throws InvalidParameterException {
+		if (limit <= 0 || prefix.strip().length() < MIN_PREFIX_LENGTH) throw new InvalidParameterException();
+
+		Viewer viewer = authenticator.authenticate(requestOriginator);
+		LinkedHashMap<UUID, String> suggestions = new LinkedHashMap<>();
+		for (Media media: getMediaProvider().suggestMedia(viewer, prefix, limit)) {
+			suggestions.put(media.getID(), media.getTitle());
+		}
+		return new MediaList(suggestions);
+	}
+
 	/**
 	 * Requests additional information about the specified media.
 	 * @param mediaId the media id associated with the media
@@ -101,14 +171,17 @@ public class RequestProcessor {
 	}
 
 	/**
-	 * Requests content of the specified media.
+	 * Requests content of the specified media. The response contains at most {@link #getMaxClipsPerFetch()} clips,
+	 * and the total size of the clips doesn't exceed {@link #getMaxBytesPerFetch()} unless the first clip alone does,
+	 * so the response always contains at least one clip.
 	 * @param mediaId the media id associated with the media
 	 * @param offset how many clips to skip
 	 * @param amount the total amount of clips
 	 * @param requestOriginator the client that made the request
-	 * @return a {@link MediaFetch} instance
+	 * @return a {@link MediaFetch} instance, which may contain fewer clips than requested
 	 * @throws InvalidParameterException if the parameters are invalid
 	 * @throws backend.exceptions.AuthenticationException if authentication fails
+	 * @throws QueryingException if the sizes of the clips can't be retrieved
 	 */
 	public MediaFetch fetchRequest(
 		@Nonnull UUID mediaId, int offset, int amount, @Nonnull RequestOriginator requestOriginator
@@ -119,11 +192,60 @@ public class RequestProcessor {
 		Media media = mediaProvider.getMedia(viewer, mediaId);
 		if (media == null || media.getDuration() < offset + amount) throw new InvalidParameterException();
 
-		SeekableByteChannel[] audioClips = media.retrieveAudioClips(offset, amount);
-		SeekableByteChannel[] videoClips = media.retrieveVideoClips(offset, amount);
+		int cappedAmount = Math.min(amount, getMaxClipsPerFetch());
+		SeekableByteChannel[] audioClips = media.retrieveAudioClips(offset, cappedAmount);
+		SeekableByteChannel[] videoClips;
+		try {
+			videoClips = media.retrieveVideoClips(offset, cappedAmount);
+		} catch (RuntimeException e) {
+			close(audioClips, 0);
+			throw e;
+		}
+
+		int fittingAmount = fittingAmount(videoClips, audioClips);
+		if (fittingAmount < videoClips.length) {
+			close(videoClips, fittingAmount);
+			close(audioClips, fittingAmount);
+			videoClips = Arrays.copyOf(videoClips, fittingAmount);
+			audioClips = Arrays.copyOf(audioClips, fittingAmount);
+		}
 		return new MediaFetch(media.getID(), offset, videoClips, audioClips);
 	}
 
+	/**
+	 * Returns the maximum amount of clips a FETCH response contains.
+	 * @return the maximum amount of clips per FETCH request
+	 */
+	public int getMaxClipsPerFetch() {
+		return maxClipsPerFetch;
+	}
+
+	/**
+	 * Sets the maximum amount of clips a FETCH response contains.
+	 * @param maxClips the maximum amount of clips per FETCH request, must be positive
+	 */
+	public void setMaxClipsPerFetch(int maxClips) {
+		if (maxClips <= 0) throw new IllegalArgumentException("The maximum amount of clips must be positive");
+		maxClipsPerFetch = maxClips;
+	}
+
+	/**
+	 * Returns the maximum total size in bytes of the clips a FETCH response contains.
+	 * @return the maximum amount of bytes per FETCH request
+	 */
+	public long getMaxBytesPerFetch() {
+		return maxBytesPerFetch;
+	}
+
+	/**
+	 * Sets the maximum total size in bytes of the clips a FETCH response contains.
+	 * @param maxBytes the maximum amount of bytes per FETCH request, must be positive
+	 */
+	public void setMaxBytesPerFetch(long maxBytes) {
+		if (maxBytes <= 0) throw new IllegalArgumentException("The maximum amount of bytes must be positive");
+		maxBytesPerFetch = maxBytes;
+	}
+
 	/**
 	 * Returns the current {@link Authenticator} instance.
 	 * @return the current {@link Authenticator} instance
@@ -157,4 +279,28 @@ public class RequestProcessor {
 	public void setMediaProvider(@Nonnull MediaProvider newMediaProvider) {
 		mediaProvider = newMediaProvider;
 	}
+
+	private int fittingAmount(SeekableByteChannel[] videoClips, SeekableByteChannel[] audioClips) {
+		long budget = getMaxBytesPerFetch();
+		if (budget == Long.MAX_VALUE) return videoClips.length;
+		try {
+			long total = 0;
+			for (int i = 0; i < videoClips.length; i++) {
+				total += videoClips[i].size() - videoClips[i].position();
+				total += audioClips[i].size() - audioClips[i].position();
+				if (total > budget) return Math.max(i, 1);
+			}
+			return videoClips.length;
+		} catch (IOException e) {
+			close(videoClips, 0);
+			close(audioClips, 0);
+			throw new QueryingException(e);
+		}
+	}
+
+	private void close(SeekableByteChannel[] channels, int from) {
+		for (int i = from; i < channels.length; i++) {
+			try { channels[i].close(); } catch (Exception ignored) { }
+		}
+	}
 }
@@ -19,10 +19,12 @@
 
 package backend.converters;
 
+import backend.controllers.DataStreams;
 import jakarta.annotation.Nonnull;
 
 import java.io.IOException;
 import java.nio.channels.SeekableByteChannel;
+import java.nio.channels.WritableByteChannel;
 
 /**
  * BinaryConverter converts models from/into binary format.
@@ -48,4 +50,18 @@ public interface BinaryConverter<T> {
 	@Nonnull
 	T convert(@Nonnull SeekableByteChannel input) throws IOException;
 
+	/**
+	 * Converts the model instance into binary and writes the result to output. The binary representation is the same
+	 * as the one returned by {@link #convert(Object)}; implementations may override this method to avoid
+	 * materializing the whole representation in memory.
+	 * @param input the model instance
+	 * @param output the destination of the converted model
+	 * @throws IOException if some I/O exception occurs
+	 */
+	default void convert(@Nonnull T input, @Nonnull WritableByteChannel output) throws IOException {
+		try (SeekableByteChannel seekableByteChannel = convert(input)) {
+			DataStreams.passData(seekableByteChannel, output);
+		}
+	}
+
 }
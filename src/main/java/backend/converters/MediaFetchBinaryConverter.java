@@ -20,6 +20,7 @@
 package backend.converters;
 
 import backend.adapters.ArraySeekableByteChannel;
+import backend.controllers.DataStreams;
 import backend.models.MediaFetch;
 import jakarta.annotation.Nonnull;
 import org.bson.*;
@@ -30,12 +31,18 @@ import org.bson.io.BasicOutputBuffer;
 
 import java.io.IOException;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.channels.SeekableByteChannel;
+import java.nio.channels.WritableByteChannel;
+import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.UUID;
 
 /**
- * Converts {@link MediaFetch} from/into binary format.
+ * Converts {@link MediaFetch} from/into binary format.<br>
+ * {@link #convert(MediaFetch, WritableByteChannel)} produces the same BSON document as {@link #convert(MediaFetch)},
+ * but writes the BSON framing itself and transfers the clips directly from their channels, so the memory it requires
+ * doesn't depend on the size of the clips.
  */
 public class MediaFetchBinaryConverter implements BinaryConverter<MediaFetch> {
 
@@ -69,6 +76,40 @@ public class MediaFetchBinaryConverter implements BinaryConverter<MediaFetch> {
 		}
 	}
 
+	@Override
+	public void convert(@Nonnull MediaFetch input, @Nonnull WritableByteChannel output) throws IOException {
+		byte[] id = input.id().toString().getBytes(StandardCharsets.UTF_8);
+		long[] videoSizes = new long[input.video().length];
+		for (int i = 0; i < videoSizes.length; i++) {
+			videoSizes[i] = input.video()[i].size() - input.video()[i].position();
+		}
+		long[] audioSizes = new long[input.audio().length];
+		for (int i = 0; i < audioSizes.length; i++) {
+			audioSizes[i] = input.audio()[i].size() - input.audio()[i].position();
+		}
+
+		long videoArraySize = bsonBinaryArraySize(videoSizes);
+		long audioArraySize = bsonBinaryArraySize(audioSizes);
+		long documentSize =
+			4 +
+			1 + 3 + 4 + id.length + 1 +
+			1 + 7 + 4 +
+			1 + 6 + videoArraySize +
+			1 + 6 + audioArraySize +
+			1;
+		if (documentSize > Integer.MAX_VALUE) throw new IOException("The BSON document is too large");
+
+		ByteBuffer header = ByteBuffer.allocate(4 + 4 + 4 + id.length + 1 + 1 + 7 + 4).order(ByteOrder.LITTLE_ENDIAN);
+		header.putInt((int) documentSize);
+		header.put((byte) BsonType.STRING.getValue()).put(cString("id")).putInt(id.length + 1).put(id).put((byte) 0);
+		header.put((byte) BsonType.INT32.getValue()).put(cString("offset")).putInt(input.offset());
+		writeFully(header.flip(), output);
+
+		writeBsonBinaryArray("video", input.video(), videoSizes, videoArraySize, output);
+		writeBsonBinaryArray("audio", input.audio(), audioSizes, audioArraySize, output);
+		writeFully(ByteBuffer.wrap(new byte[] {0}), output);
+	}
+
 	@Nonnull
 	@Override
 	public MediaFetch convert(@Nonnull SeekableByteChannel input) throws IOException {
@@ -98,6 +139,47 @@ public class MediaFetchBinaryConverter implements BinaryConverter<MediaFetch> {
 		}
 	}
 
+	private void writeBsonBinaryArray(
+		String name, SeekableByteChannel[] clips, long[] sizes, long arraySize, WritableByteChannel output
+	) throws IOException {
+		byte[] cName = cString(name);
+		ByteBuffer header = ByteBuffer.allocate(1 + cName.length + 4).order(ByteOrder.LITTLE_ENDIAN);
+		header.put((byte) BsonType.ARRAY.getValue()).put(cName).putInt((int) arraySize);
+		writeFully(header.flip(), output);
+
+		for (int i = 0; i < clips.length; i++) {
+			byte[] key = cString(Integer.toString(i));
+			ByteBuffer elementHeader = ByteBuffer.allocate(1 + key.length + 4 + 1).order(ByteOrder.LITTLE_ENDIAN);
+			elementHeader
+				.put((byte) BsonType.BINARY.getValue())
+				.put(key)
+				.putInt((int) sizes[i])
+				.put(BsonBinarySubType.BINARY.getValue());
+			writeFully(elementHeader.flip(), output);
+			DataStreams.transferData(clips[i], sizes[i], output);
+		}
+		writeFully(ByteBuffer.wrap(new byte[] {0}), output);
+	}
+
+	private long bsonBinaryArraySize(long[] sizes) {
+		long arraySize = 4 + 1;
+		for (int i = 0; i < sizes.length; i++) {
+			arraySize += 1 + Integer.toString(i).length() + 1 + 4 + 1 + sizes[i];
+		}
+		return arraySize;
+	}
+
+	private byte[] cString(String value) {
+		byte[] bytes = value.getBytes(StandardCharsets.UTF_8);
+		byte[] cString = new byte[bytes.length + 1];
+		System.arraycopy(bytes, 0, cString, 0, bytes.length);
+		return cString;
+	}
+
+	private void writeFully(ByteBuffer buffer, WritableByteChannel output) throws IOException {
+		while (buffer.hasRemaining()) output.write(buffer);
+	}
+
 	private byte[] toByteArray(SeekableByteChannel sbc) throws IOException {
 		byte[] output = new byte[(int) sbc.size()];
 		int byteRead = 0;
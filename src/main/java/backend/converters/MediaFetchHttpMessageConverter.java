@@ -32,16 +32,25 @@ import org.springframework.stereotype.Component;
 
 import java.io.IOException;
 import java.nio.channels.SeekableByteChannel;
+import java.nio.channels.WritableByteChannel;
 import java.util.List;
 
 /**
- * Converts {@link MediaFetch} into an HTTP response.<br>
- * Not intended to be used directly.
+ * Converts {@link MediaFetch} into an HTTP response. The response body is BSON unless the content type is
+ * {@link MediaFetchFramedBinaryConverter#MEDIA_TYPE}, in which case the framed format is used.<br>
+ * Not intended to be used directly except for {@link #write(MediaFetch, MediaType, WritableByteChannel)}, which
+ * streams the response on behalf of the controllers.
  */
 @Component
 public class MediaFetchHttpMessageConverter implements HttpMessageConverter<MediaFetch> {
 
+	private static final MediaType FRAMED_MEDIA_TYPE =
+		MediaType.parseMediaType(MediaFetchFramedBinaryConverter.MEDIA_TYPE);
+
 	private final BinaryConverter<MediaFetch> mediaFetchBinaryConverter = new MediaFetchBinaryConverter();
+
+	private final BinaryConverter<MediaFetch> mediaFetchFramedBinaryConverter = new MediaFetchFramedBinaryConverter();
+
 	@Override
 	public boolean canRead(@Nonnull Class<?> clazz, MediaType mediaType) {
 		return false;
@@ -55,7 +64,7 @@ public class MediaFetchHttpMessageConverter implements HttpMessageConverter<Medi
 	@Nonnull
 	@Override
 	public List<MediaType> getSupportedMediaTypes() {
-		return List.of(MediaType.APPLICATION_OCTET_STREAM);
+		return List.of(MediaType.APPLICATION_OCTET_STREAM, FRAMED_MEDIA_TYPE);
 	}
 
 	@Nonnull
@@ -70,8 +79,27 @@ public class MediaFetchHttpMessageConverter implements HttpMessageConverter<Medi
 	public void write(
 		@Nonnull MediaFetch mediaFetch, MediaType contentType, HttpOutputMessage outputMessage
 	) throws IOException, HttpMessageNotWritableException {
-		try (SeekableByteChannel seekableByteChannel = mediaFetchBinaryConverter.convert(mediaFetch)) {
-			DataStreams.passData(seekableByteChannel, outputMessage.getBody());
+		write(mediaFetch, contentType, DataStreams.channel(outputMessage.getBody()));
+	}
+
+	/**
+	 * Writes mediaFetch into output in the format that corresponds to contentType and closes the clip channels of
+	 * mediaFetch. The clips are transferred one chunk at a time, so the memory the method occupies doesn't depend on
+	 * the size of mediaFetch, and a slow output blocks the transfer instead of accumulating the data.
+	 * @param mediaFetch the media fetch
+	 * @param contentType the content type of the response, or null if it's not specified
+	 * @param output the destination of the data
+	 * @throws IOException if some I/O exception occurs
+	 */
+	public void write(
+		@Nonnull MediaFetch mediaFetch, MediaType contentType, @Nonnull WritableByteChannel output
+	) throws IOException {
+		BinaryConverter<MediaFetch> converter =
+			contentType != null && FRAMED_MEDIA_TYPE.equalsTypeAndSubtype(contentType) ?
+				mediaFetchFramedBinaryConverter :
+				mediaFetchBinaryConverter;
+		try {
+			converter.convert(mediaFetch, output);
 		} finally {
 			for (SeekableByteChannel channel: mediaFetch.video()) {
 				try { channel.close(); } catch (Exception ignored) { }
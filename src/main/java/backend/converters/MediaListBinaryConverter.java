@@ -31,7 +31,7 @@ import org.bson.io.BasicOutputBuffer;
 import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.nio.channels.SeekableByteChannel;
-import java.util.HashMap;
+import java.util.LinkedHashMap;
 import java.util.UUID;
 
 /**
@@ -52,6 +52,7 @@ public class MediaListBinaryConverter implements BinaryConverter<MediaList> {
 				.toList()
 		);
 		bsonDocument.put("media", media);
+		if (input.cursor() != null) bsonDocument.put("cursor", new BsonString(input.cursor()));
 
 		try (
 			BasicOutputBuffer basicOutputBuffer = new BasicOutputBuffer();
@@ -74,12 +75,13 @@ public class MediaListBinaryConverter implements BinaryConverter<MediaList> {
 			BsonDocument bsonDocument = bsonDocumentCodec.decode(bsonBinaryReader, DecoderContext.builder().build());
 
 			BsonDocument media = bsonDocument.getDocument("media");
+			BsonString cursor = bsonDocument.getString("cursor", null);
 			return new MediaList(
 				media
 					.entrySet()
 					.stream()
 					.reduce(
-						new HashMap<>(),
+						new LinkedHashMap<>(),
 						(map, entry) -> {
 							map.put(UUID.fromString(entry.getKey()), entry.getValue().asString().getValue());
 							return map;
@@ -88,7 +90,8 @@ public class MediaListBinaryConverter implements BinaryConverter<MediaList> {
 							map1.putAll(map2);
 							return map1;
 						}
-					)
+					),
+				cursor == null ? null : cursor.getValue()
 			);
 		}
 	}
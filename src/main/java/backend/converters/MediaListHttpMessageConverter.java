@@ -20,6 +20,7 @@
 package backend.converters;
 
 import backend.controllers.DataStreams;
+import backend.controllers.HttpRequestController;
 import backend.models.MediaList;
 import jakarta.annotation.Nonnull;
 import org.springframework.http.HttpInputMessage;
@@ -41,6 +42,9 @@ import java.util.List;
 @Component
 public class MediaListHttpMessageConverter implements HttpMessageConverter<MediaList> {
 
+	private static final MediaType METADATA_MEDIA_TYPE =
+		MediaType.parseMediaType(HttpRequestController.METADATA_MEDIA_TYPE);
+
 	private final BinaryConverter<MediaList> mediaListBinaryConverter = new MediaListBinaryConverter();
 
 	@Override
@@ -56,7 +60,7 @@ public class MediaListHttpMessageConverter implements HttpMessageConverter<Media
 	@Nonnull
 	@Override
 	public List<MediaType> getSupportedMediaTypes() {
-		return List.of(MediaType.APPLICATION_OCTET_STREAM);
+		return List.of(METADATA_MEDIA_TYPE, MediaType.APPLICATION_OCTET_STREAM);
 	}
 
 	@Nonnull
@@ -0,0 +1,147 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.ingestion;
+
+import backend.main.Config;
+import backend.main.RubusConfiguration;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import javax.sql.DataSource;
+import java.io.IOException;
+import java.net.URI;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.sql.Connection;
+import java.sql.PreparedStatement;
+import java.sql.SQLException;
+import java.util.Comparator;
+import java.util.UUID;
+import java.util.stream.Stream;
+
+/**
+ * MediaIngestionTool is a command-line tool that adds a single media to the server. It segments the source file with
+ * {@link MediaSegmenter} into a new directory, named after the id of the media, under the content root, and then
+ * inserts the media into the 'media' table of the database specified in ${rubus.workingDir}/rubus.conf. If
+ * the segmentation fails, the directory is removed. The tool is launched from the server jar:
+ * <pre>
+ * java -Drubus.workingDir=... -Drubus.db.user=... -Drubus.db.password=... \
+ *     -Dloader.main=backend.ingestion.MediaIngestionTool -cp RubusServer-VERSION.jar \
+ *     org.springframework.boot.loader.launch.PropertiesLauncher SOURCE TITLE CONTENT_ROOT
+ * </pre>
+ * The following system properties are optional:
+ * <ul>
+ *     <li>rubus.ingestion.parallelism is the maximum amount of clips encoded at once; the default value is
+ *     the amount of available processors</li>
+ *     <li>rubus.ingestion.ffmpeg is the location of the ffmpeg executable; the default value is "ffmpeg"</li>
+ *     <li>rubus.ingestion.ffprobe is the location of the ffprobe executable; the default value is "ffprobe"</li>
+ *     <li>rubus.ingestion.packed specifies if the clips are packed into a single file with {@link MediaPacker};
+ *     the default value is false</li>
+ * </ul>
+ */
+public class MediaIngestionTool {
+
+	private final static Logger logger = LoggerFactory.getLogger(MediaIngestionTool.class);
+
+	public static void main(String[] args) throws Exception {
+		if (args.length != 3) {
+			System.err.println("Usage: MediaIngestionTool SOURCE TITLE CONTENT_ROOT");
+			System.exit(2);
+		}
+		Path source = Path.of(args[0]);
+		String title = args[1];
+		Path contentRoot = Path.of(args[2]).toAbsolutePath();
+		Config config = new Config(Path.of(System.getProperty("rubus.workingDir"), "rubus.conf"));
+		MediaSegmenter mediaSegmenter = new MediaSegmenter(
+			System.getProperty("rubus.ingestion.ffmpeg", "ffmpeg"),
+			System.getProperty("rubus.ingestion.ffprobe", "ffprobe"),
+			Integer.getInteger("rubus.ingestion.parallelism", Runtime.getRuntime().availableProcessors())
+		);
+
+		UUID mediaId = UUID.randomUUID();
+		Path destination = contentRoot.resolve(mediaId.toString());
+		MediaSegmenter.Report report;
+		try {
+			report = mediaSegmenter.segment(source, destination);
+			if (Boolean.getBoolean("rubus.ingestion.packed")) {
+				MediaPacker.pack(destination);
+				MediaPacker.removeClips(destination);
+			}
+		} catch (IOException | InterruptedException e) {
+			logger.error("Couldn't segment {}", source, e);
+			System.err.println("Couldn't segment " + source + ": " + e.getMessage());
+			deleteDirectory(destination);
+			System.exit(1);
+			return;
+		}
+		System.out.printf(
+			"Encoded %d clips (%d s, %d fps) in %.1f s, speed: %.2fx%n",
+			report.clips(),
+			report.duration(),
+			report.frameRate(),
+			report.elapsedNanos() / 1e9,
+			report.speed()
+		);
+
+		URI mediaContentUri = destination.toUri();
+		try {
+			insertMedia(
+				RubusConfiguration.postgresDataSource(
+					config, System.getProperty("rubus.db.user"), System.getProperty("rubus.db.password")
+				),
+				mediaId,
+				title,
+				report.duration(),
+				mediaContentUri
+			);
+		} catch (SQLException e) {
+			logger.error("Couldn't insert media {}", mediaId, e);
+			System.err.println(
+				"Couldn't insert the media, the clips remain in " + destination + ": " + e.getMessage()
+			);
+			System.exit(1);
+			return;
+		}
+		System.out.println("Added media " + mediaId + " located at " + mediaContentUri);
+	}
+
+	private static void insertMedia(DataSource dataSource, UUID id, String title, int duration, URI mediaContentUri)
+		throws SQLException {
+		try (
+			Connection connection = dataSource.getConnection();
+			PreparedStatement statement = connection.prepareStatement(
+				"INSERT INTO media (id, title, duration, media_content_uri) VALUES (?, ?, ?, ?);"
+			)
+		) {
+			statement.setString(1, id.toString());
+			statement.setString(2, title);
+			statement.setInt(3, duration);
+			statement.setString(4, mediaContentUri.toString());
+			statement.executeUpdate();
+		}
+	}
+
+	private static void deleteDirectory(Path directory) throws IOException {
+		if (!Files.exists(directory)) return;
+		try (Stream<Path> paths = Files.walk(directory)) {
+			for (Path path: paths.sorted(Comparator.reverseOrder()).toList()) Files.delete(path);
+		}
+	}
+}
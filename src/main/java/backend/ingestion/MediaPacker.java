@@ -0,0 +1,164 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.ingestion;
+
+import backend.querying.PackedQueryingStrategy;
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+import java.util.stream.Stream;
+
+/**
+ * MediaPacker packs the clips of a media, stored as a file per clip, into a single pack file that
+ * {@link PackedQueryingStrategy} reads. The clips are ordered by their sequential numbers and the video clip precedes
+ * the audio clip of the same second, so the clips of consecutive seconds are adjacent in the pack file. The pack file
+ * is written next to the clips under a temporary name and then renamed, so the server never sees a partial file.<br>
+ * The class can be run as a command-line tool to pack the clips of an existing media:
+ * <pre>
+ * java -Dloader.main=backend.ingestion.MediaPacker -cp RubusServer-VERSION.jar \
+ *     org.springframework.boot.loader.launch.PropertiesLauncher DIRECTORY [--remove-clips]
+ * </pre>
+ */
+public class MediaPacker {
+
+	private static final Pattern CLIP_NAME = Pattern.compile("([va])(\\d+)");
+
+	private final static Logger logger = LoggerFactory.getLogger(MediaPacker.class);
+
+	private record Clip(String name, Path path, long size) { }
+
+	/**
+	 * Packs the clips of the media located in the directory into {@link PackedQueryingStrategy#PACK_FILE_NAME} in
+	 * the same directory, replacing the previous pack file if it exists.
+	 * @param directory the directory of the media
+	 * @return the location of the pack file
+	 * @throws IOException if the clips can't be read or the pack file can't be written
+	 */
+	@Nonnull
+	public static Path pack(@Nonnull Path directory) throws IOException {
+		List<Clip> clips = listClips(directory);
+		int indexLength = 0;
+		for (Clip clip: clips) indexLength += Short.BYTES + clip.name().getBytes(StandardCharsets.UTF_8).length + 16;
+
+		ByteBuffer header = ByteBuffer.allocate(PackedQueryingStrategy.HEADER_LENGTH + indexLength);
+		header.put(PackedQueryingStrategy.MAGIC.getBytes(StandardCharsets.US_ASCII));
+		header.putInt(PackedQueryingStrategy.VERSION);
+		header.putInt(clips.size());
+		header.putInt(indexLength);
+		long offset = header.capacity();
+		for (Clip clip: clips) {
+			byte[] name = clip.name().getBytes(StandardCharsets.UTF_8);
+			header.putShort((short) name.length);
+			header.put(name);
+			header.putLong(offset);
+			header.putLong(clip.size());
+			offset += clip.size();
+		}
+		header.flip();
+
+		Path packFile = directory.resolve(PackedQueryingStrategy.PACK_FILE_NAME);
+		Path temporaryFile = directory.resolve(PackedQueryingStrategy.PACK_FILE_NAME + ".tmp");
+		try (
+			FileChannel output = FileChannel.open(
+				temporaryFile,
+				StandardOpenOption.CREATE,
+				StandardOpenOption.TRUNCATE_EXISTING,
+				StandardOpenOption.WRITE
+			)
+		) {
+			while (header.hasRemaining()) output.write(header);
+			for (Clip clip: clips) {
+				try (FileChannel input = FileChannel.open(clip.path(), StandardOpenOption.READ)) {
+					long transferred = 0;
+					while (transferred < clip.size()) {
+						long bytesTransferred = input.transferTo(transferred, clip.size() - transferred, output);
+						if (bytesTransferred <= 0) throw new IOException(clip.path() + " was modified while packing");
+						transferred += bytesTransferred;
+					}
+				}
+			}
+			output.force(true);
+		} catch (IOException e) {
+			Files.deleteIfExists(temporaryFile);
+			throw e;
+		}
+		Files.move(temporaryFile, packFile, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+
+		logger.info("Packed {} clips of {} into {}, size: {}", clips.size(), directory, packFile, offset);
+		return packFile;
+	}
+
+	/**
+	 * Removes the clips of the media located in the directory, e.g. after they have been packed.
+	 * @param directory the directory of the media
+	 * @throws IOException if the clips can't be removed
+	 */
+	public static void removeClips(@Nonnull Path directory) throws IOException {
+		for (Clip clip: listClips(directory)) Files.delete(clip.path());
+	}
+
+	private static List<Clip> listClips(Path directory) throws IOException {
+		List<Clip> clips = new ArrayList<>();
+		try (Stream<Path> paths = Files.list(directory)) {
+			for (Path path: paths.toList()) {
+				String name = path.getFileName().toString();
+				if (CLIP_NAME.matcher(name).matches() && Files.isRegularFile(path)) {
+					clips.add(new Clip(name, path, Files.size(path)));
+				}
+			}
+		}
+		// v0, a0, v1, a1, ...
+		clips.sort(
+			Comparator.comparingLong(MediaPacker::clipNumber).thenComparing(clip -> clip.name().startsWith("a"))
+		);
+		return clips;
+	}
+
+	private static long clipNumber(Clip clip) {
+		Matcher matcher = CLIP_NAME.matcher(clip.name());
+		if (!matcher.matches()) throw new IllegalArgumentException(clip.name());
+		return Long.parseLong(matcher.group(2));
+	}
+
+	public static void main(String[] args) throws IOException {
+		if (args.length < 1 || args.length > 2 || args.length == 2 && !args[1].equals("--remove-clips")) {
+			System.err.println("Usage: MediaPacker DIRECTORY [--remove-clips]");
+			System.exit(2);
+		}
+		Path directory = Path.of(args[0]);
+		Path packFile = pack(directory);
+		if (args.length == 2) removeClips(directory);
+		System.out.println("Packed the clips of " + directory + " into " + packFile);
+	}
+}
@@ -0,0 +1,349 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.ingestion;
+
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.FutureTask;
+
+/**
+ * MediaSegmenter splits a source file into the resources of a single media: one-second video clips named v0..vN and
+ * one-second audio clips named a0..aN, written into a destination directory the way {@link
+ * backend.querying.FSQueryingStrategy} expects them. The clips are encoded by the ffmpeg executable, which is built on
+ * the same libraries the client decodes the clips with.<br>
+ * Every clip is encoded by its own ffmpeg process, and the processes run in parallel, each of them restricted to
+ * a single thread, so the encoding is spread across the cores clip by clip. A video clip is encoded from the exact
+ * second of the source it represents, so it starts with a keyframe, and it holds exactly as many frames as the frame
+ * rate of the source rounded to an integer; the last clip is padded with the last frame of the source. Video clips
+ * are H.264 streams in MP4 containers with the metadata at the beginning of the file, and audio clips are 16-bit PCM
+ * WAV files, the last one padded with silence. A source without an audio stream gets silent audio clips: a single
+ * second of silence is encoded once and copied as every audio clip, so the media can still be played.<br>
+ * Encoding clip by clip opens and seeks the source once per clip, which a single segmenting encode per track, cutting
+ * at forced keyframes, would avoid. It's still preferred because every clip starts and ends at the exact second it
+ * represents, while the segment muxer cuts the audio at packet boundaries, and because the clips of a single track
+ * are encoded on as many cores as the parallelism allows rather than on the threads of a single encoder.
+ */
+public class MediaSegmenter {
+
+	/**
+	 * CommandRunner runs an external command and returns what the command has written to its standard output.
+	 */
+	@FunctionalInterface
+	public interface CommandRunner {
+
+		/**
+		 * Runs the command and waits for it to finish.
+		 * @param command the command and its arguments
+		 * @return the output of the command
+		 * @throws IOException if the command can't be run or finishes unsuccessfully
+		 * @throws InterruptedException if the current thread is interrupted while waiting
+		 */
+		@Nonnull
+		String run(@Nonnull List<String> command) throws IOException, InterruptedException;
+	}
+
+	/**
+	 * Report describes a finished segmentation.
+	 * @param duration the duration of the media in seconds, which is the amount of the video clips
+	 * @param frameRate the amount of frames every video clip holds
+	 * @param clips the amount of encoded clips, both video and audio
+	 * @param elapsedNanos the amount of nanoseconds the encoding took
+	 */
+	public record Report(int duration, int frameRate, int clips, long elapsedNanos) {
+
+		/**
+		 * Returns the encoding speed, i.e. how many seconds of the media were encoded per second.
+		 * @return the encoding speed
+		 */
+		public double speed() {
+			return duration / (Math.max(elapsedNanos, 1) / 1e9);
+		}
+	}
+
+	private final Logger logger = LoggerFactory.getLogger(MediaSegmenter.class);
+
+	private final String ffmpeg;
+
+	private final String ffprobe;
+
+	private final int parallelism;
+
+	private final CommandRunner commandRunner;
+
+	/**
+	 * Constructs an instance of this class that runs the ffmpeg and ffprobe executables as operating system processes.
+	 * @param ffmpeg the location of the ffmpeg executable, or its name if it's on the path
+	 * @param ffprobe the location of the ffprobe executable, or its name if it's on the path
+	 * @param parallelism the maximum amount of clips encoded at once; must be positive
+	 */
+	public MediaSegmenter(@Nonnull String ffmpeg, @Nonnull String ffprobe, int parallelism) {
+		this(ffmpeg, ffprobe, parallelism, MediaSegmenter::runProcess);
+	}
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param ffmpeg the location of the ffmpeg executable, or its name if it's on the path
+	 * @param ffprobe the location of the ffprobe executable, or its name if it's on the path
+	 * @param parallelism the maximum amount of clips encoded at once; must be positive
+	 * @param commandRunner the {@link CommandRunner} instance that runs ffmpeg and ffprobe
+	 */
+	public MediaSegmenter(
+		@Nonnull String ffmpeg, @Nonnull String ffprobe, int parallelism, @Nonnull CommandRunner commandRunner
+	) {
+		if (parallelism <= 0) throw new IllegalArgumentException("The parallelism must be positive");
+		this.ffmpeg = ffmpeg;
+		this.ffprobe = ffprobe;
+		this.parallelism = parallelism;
+		this.commandRunner = commandRunner;
+
+		logger.debug(
+			"{} instantiated, ffmpeg: {}, ffprobe: {}, parallelism: {}, CommandRunner: {}",
+			this,
+			ffmpeg,
+			ffprobe,
+			parallelism,
+			commandRunner
+		);
+	}
+
+	/**
+	 * Encodes the clips of the source into the destination directory, creating the directory if it doesn't exist.
+	 * If encoding of any clip fails, the encoding of the rest of the clips is cancelled.
+	 * @param source the source file
+	 * @param destination the destination directory
+	 * @return the {@link Report} instance
+	 * @throws IOException if the source can't be probed or a clip can't be encoded
+	 * @throws InterruptedException if the current thread is interrupted while waiting for the encoding
+	 */
+	@Nonnull
+	public Report segment(@Nonnull Path source, @Nonnull Path destination) throws IOException, InterruptedException {
+		int duration = probeDuration(source);
+		int frameRate = probeFrameRate(source);
+		boolean audio = probeAudio(source);
+		Files.createDirectories(destination);
+
+		long start = System.nanoTime();
+		List<Future<String>> encodings = new ArrayList<>(duration * 2);
+		try (ExecutorService executorService = Executors.newFixedThreadPool(parallelism)) {
+			try {
+				for (int second = 0; second < duration; second++) {
+					List<String> videoCommand =
+						videoClipCommand(source, destination.resolve("v" + second), second, frameRate);
+					encodings.add(executorService.submit(() -> commandRunner.run(videoCommand)));
+					if (!audio) continue;
+					List<String> audioCommand = audioClipCommand(source, destination.resolve("a" + second), second);
+					encodings.add(executorService.submit(() -> commandRunner.run(audioCommand)));
+				}
+				if (!audio) {
+					List<String> silenceCommand = silentClipCommand(destination.resolve("a0"));
+					encodings.add(executorService.submit(() -> commandRunner.run(silenceCommand)));
+				}
+				for (Future<String> encoding: encodings) encoding.get();
+			} catch (ExecutionException e) {
+				executorService.shutdownNow();
+				if (e.getCause() instanceof IOException ioException) throw ioException;
+				throw new IOException(e.getCause());
+			} catch (InterruptedException e) {
+				executorService.shutdownNow();
+				throw e;
+			}
+		}
+		if (!audio) {
+			for (int second = 1; second < duration; second++) {
+				Files.copy(
+					destination.resolve("a0"),
+					destination.resolve("a" + second),
+					StandardCopyOption.REPLACE_EXISTING
+				);
+			}
+		}
+		Report report = new Report(duration, frameRate, duration * 2, System.nanoTime() - start);
+
+		logger.info(
+			"{} segmented {} into {} clips in {} ms, speed: {}x",
+			this,
+			source,
+			report.clips(),
+			report.elapsedNanos() / 1_000_000,
+			String.format("%.2f", report.speed())
+		);
+		return report;
+	}
+
+	/**
+	 * Returns the duration of the source in seconds, rounded up.
+	 * @param source the source file
+	 * @return the duration of the source
+	 * @throws IOException if the source can't be probed
+	 * @throws InterruptedException if the current thread is interrupted while waiting for ffprobe
+	 */
+	public int probeDuration(@Nonnull Path source) throws IOException, InterruptedException {
+		String output = commandRunner.run(List.of(
+			ffprobe,
+			"-v", "error",
+			"-show_entries", "format=duration",
+			"-of", "default=noprint_wrappers=1:nokey=1",
+			source.toString()
+		)).strip();
+		try {
+			int duration = (int) Math.ceil(Double.parseDouble(output));
+			if (duration <= 0) throw new IOException("The source " + source + " is empty");
+			return duration;
+		} catch (NumberFormatException e) {
+			throw new IOException("Couldn't probe the duration of " + source + ": " + output, e);
+		}
+	}
+
+	/**
+	 * Returns the frame rate of the first video stream of the source, rounded to an integer.
+	 * @param source the source file
+	 * @return the frame rate of the source
+	 * @throws IOException if the source can't be probed
+	 * @throws InterruptedException if the current thread is interrupted while waiting for ffprobe
+	 */
+	public int probeFrameRate(@Nonnull Path source) throws IOException, InterruptedException {
+		String output = commandRunner.run(List.of(
+			ffprobe,
+			"-v", "error",
+			"-select_streams", "v:0",
+			"-show_entries", "stream=r_frame_rate",
+			"-of", "default=noprint_wrappers=1:nokey=1",
+			source.toString()
+		)).strip();
+		try {
+			// The frame rate is a fraction, e.g. 30000/1001
+			int separator = output.indexOf('/');
+			double frameRate = separator < 0 ?
+				Double.parseDouble(output) :
+				Double.parseDouble(output.substring(0, separator)) /
+					Double.parseDouble(output.substring(separator + 1));
+			if (!Double.isFinite(frameRate) || Math.round(frameRate) <= 0) throw new NumberFormatException();
+			return (int) Math.round(frameRate);
+		} catch (NumberFormatException e) {
+			throw new IOException("Couldn't probe the frame rate of " + source + ": " + output, e);
+		}
+	}
+
+	/**
+	 * Returns whether the source has an audio stream.
+	 * @param source the source file
+	 * @return true if the source has an audio stream, false otherwise
+	 * @throws IOException if the source can't be probed
+	 * @throws InterruptedException if the current thread is interrupted while waiting for ffprobe
+	 */
+	public boolean probeAudio(@Nonnull Path source) throws IOException, InterruptedException {
+		return !commandRunner.run(List.of(
+			ffprobe,
+			"-v", "error",
+			"-select_streams", "a:0",
+			"-show_entries", "stream=codec_type",
+			"-of", "default=noprint_wrappers=1:nokey=1",
+			source.toString()
+		)).isBlank();
+	}
+
+	private List<String> videoClipCommand(Path source, Path clip, int second, int frameRate) {
+		return List.of(
+			ffmpeg,
+			"-v", "error",
+			"-y",
+			"-ss", Integer.toString(second),
+			"-i", source.toString(),
+			"-map", "0:v:0",
+			"-vf", "fps=" + frameRate + ",tpad=stop_mode=clone:stop_duration=1",
+			"-frames:v", Integer.toString(frameRate),
+			"-c:v", "libx264",
+			"-g", Integer.toString(frameRate),
+			"-threads", "1",
+			"-f", "mp4",
+			"-movflags", "+faststart",
+			clip.toString()
+		);
+	}
+
+	private List<String> audioClipCommand(Path source, Path clip, int second) {
+		return List.of(
+			ffmpeg,
+			"-v", "error",
+			"-y",
+			"-ss", Integer.toString(second),
+			"-i", source.toString(),
+			"-map", "0:a:0",
+			"-af", "apad",
+			"-t", "1",
+			"-c:a", "pcm_s16le",
+			"-threads", "1",
+			"-f", "wav",
+			clip.toString()
+		);
+	}
+
+	private List<String> silentClipCommand(Path clip) {
+		return List.of(
+			ffmpeg,
+			"-v", "error",
+			"-y",
+			"-f", "lavfi",
+			"-i", "anullsrc=channel_layout=stereo:sample_rate=48000",
+			"-t", "1",
+			"-c:a", "pcm_s16le",
+			"-threads", "1",
+			"-f", "wav",
+			clip.toString()
+		);
+	}
+
+	// Only the standard output is returned, so the warnings the command writes to its standard error can't be mistaken
+	// for its result; the standard error is read concurrently, so neither pipe fills up and blocks the command
+	private static String runProcess(List<String> command) throws IOException, InterruptedException {
+		Process process = new ProcessBuilder(command).start();
+		try {
+			FutureTask<byte[]> errorOutput = new FutureTask<>(process.getErrorStream()::readAllBytes);
+			Thread.ofVirtual().start(errorOutput);
+			String output = new String(process.getInputStream().readAllBytes(), StandardCharsets.UTF_8);
+			int exitCode = process.waitFor();
+			if (exitCode != 0) {
+				String errors;
+				try {
+					errors = new String(errorOutput.get(), StandardCharsets.UTF_8);
+				} catch (ExecutionException e) {
+					errors = "the standard error couldn't be read";
+				}
+				throw new IOException(command.getFirst() + " exited with code " + exitCode + ": " + errors.strip());
+			}
+			return output;
+		} finally {
+			process.destroyForcibly();
+		}
+	}
+}
@@ -21,6 +21,7 @@ package backend.interactors;
 
 import backend.exceptions.AuthorizationException;
 import backend.models.Media;
+import backend.models.MediaPage;
 import backend.models.Viewer;
 import backend.authorization.ActionType;
 import backend.authorization.ViewerAuthorizer;
@@ -106,4 +107,24 @@ public class DefaultMediaProvider implements MediaProvider {
 		}
 		return mediaDataAccess.searchMedia(searchQuery);
 	}
+
+	@Nonnull
+	@Override
+	public MediaPage searchMedia(
+		@Nonnull Viewer viewer, @Nonnull String searchQuery, int limit, @Nullable String cursor
+	) {
+		if (!viewerAuthorizer.validate(viewer, ActionType.READ)) {
+			throw new AuthorizationException("The viewer " + viewer + "isn't authorized");
+		}
+		return mediaDataAccess.searchMedia(searchQuery, limit, cursor);
+	}
+
+	@Nonnull
+	@Override
+	public Media[] suggestMedia(@Nonnull Viewer viewer, @Nonnull String prefix, int limit) {
+		if (!viewerAuthorizer.validate(viewer, ActionType.READ)) {
+			throw new AuthorizationException("The viewer " + viewer + "isn't authorized");
+		}
+		return mediaDataAccess.suggestMedia(prefix, limit);
+	}
 }
@@ -21,6 +21,7 @@ package backend.interactors;
 
 import backend.exceptions.CommonDataAccessException;
 import backend.models.Media;
+import backend.models.MediaPage;
 import jakarta.annotation.Nonnull;
 import jakarta.annotation.Nullable;
 
@@ -57,4 +58,31 @@ public interface MediaDataAccess {
 	 */
 	@Nonnull
 	Media[] searchMedia(@Nonnull String searchQuery) throws CommonDataAccessException;
+
+	/**
+	 * Returns a single page of media that match the search query. The media are ordered by how well they match
+	 * the search query, and the order is stable, so paging through the result with the returned cursors neither skips
+	 * nor repeats media unless the storage facilities are modified in the meanwhile.
+	 * @param searchQuery the search query
+	 * @param limit the maximum amount of media the page contains; must be positive
+	 * @param cursor the cursor of the previous page, or null to request the first page
+	 * @return the {@link MediaPage} instance
+	 * @throws CommonDataAccessException if the storage facilities can't be accessed
+	 * @throws IllegalArgumentException if the limit isn't positive or the cursor is malformed
+	 */
+	@Nonnull
+	MediaPage searchMedia(@Nonnull String searchQuery, int limit, @Nullable String cursor)
+		throws CommonDataAccessException;
+
+	/**
+	 * Returns at most limit media whose title contains the prefix, e.g. the beginning of a word the user is still
+	 * typing. The media are ordered by how well their title matches the prefix.
+	 * @param prefix the prefix
+	 * @param limit the maximum amount of media to return; must be positive
+	 * @return an array of {@link Media} instances that match the prefix
+	 * @throws CommonDataAccessException if the storage facilities can't be accessed
+	 * @throws IllegalArgumentException if the limit isn't positive
+	 */
+	@Nonnull
+	Media[] suggestMedia(@Nonnull String prefix, int limit) throws CommonDataAccessException;
 }
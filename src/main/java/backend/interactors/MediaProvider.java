@@ -21,6 +21,7 @@ package backend.interactors;
 
 import backend.exceptions.CommonSecurityException;
 import backend.models.Media;
+import backend.models.MediaPage;
 import backend.models.Viewer;
 import jakarta.annotation.Nonnull;
 import jakarta.annotation.Nullable;
@@ -61,4 +62,30 @@ public interface MediaProvider {
 	@Nonnull
 	Media[] searchMedia(@Nonnull Viewer viewer, @Nonnull String searchQuery) throws CommonSecurityException;
 
+	/**
+	 * Returns a single page of media that match the search query, ordered by how well they match it.
+	 * @param viewer the viewer making the request
+	 * @param searchQuery the search query
+	 * @param limit the maximum amount of media the page contains; must be positive
+	 * @param cursor the cursor of the previous page, or null to request the first page
+	 * @return the {@link MediaPage} instance
+	 * @throws CommonSecurityException if the viewer is not permitted to access the requested media
+	 * @throws IllegalArgumentException if the limit isn't positive or the cursor is malformed
+	 */
+	@Nonnull
+	MediaPage searchMedia(@Nonnull Viewer viewer, @Nonnull String searchQuery, int limit, @Nullable String cursor)
+		throws CommonSecurityException;
+
+	/**
+	 * Returns at most limit media whose title contains the prefix, ordered by how well their title matches it.
+	 * @param viewer the viewer making the request
+	 * @param prefix the prefix
+	 * @param limit the maximum amount of media to return; must be positive
+	 * @return an array of {@link Media} instances that match the prefix
+	 * @throws CommonSecurityException if the viewer is not permitted to access the requested media
+	 * @throws IllegalArgumentException if the limit isn't positive
+	 */
+	@Nonnull
+	Media[] suggestMedia(@Nonnull Viewer viewer, @Nonnull String prefix, int limit) throws CommonSecurityException;
+
 }
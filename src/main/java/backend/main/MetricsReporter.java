@@ -0,0 +1,113 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.main;
+
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.util.LinkedHashMap;
+import java.util.Locale;
+import java.util.Map;
+import java.util.StringJoiner;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.TimeUnit;
+import java.util.function.Supplier;
+
+/**
+ * MetricsReporter periodically logs the values of the registered metrics in a single INFO line, e.g.
+ * {@code Metrics: media-cache-hits=10, media-cache-misses=2}, in the order the metrics were registered. A metric is
+ * a named supplier that is called on every report, so it's usually a getter of a component that counts its events.
+ * The floating-point values are logged with 3 decimal places. Nothing is logged while no metric is registered.
+ */
+public class MetricsReporter implements AutoCloseable {
+
+	/**
+	 * The amount of seconds between the reports if it's not configured.
+	 */
+	public static final int DEFAULT_INTERVAL = 60;
+
+	private final Logger logger = LoggerFactory.getLogger(MetricsReporter.class);
+
+	// Guarded by itself
+	private final Map<String, Supplier<?>> metrics = new LinkedHashMap<>();
+
+	private final ScheduledExecutorService reporter;
+
+	/**
+	 * Constructs an instance of this class and schedules the reports.
+	 * @param interval the amount of seconds between the reports; must be positive
+	 */
+	public MetricsReporter(int interval) {
+		if (interval <= 0) throw new IllegalArgumentException("The interval must be positive");
+		reporter = Executors.newSingleThreadScheduledExecutor(
+			Thread.ofPlatform().daemon().name("metrics-reporter").factory()
+		);
+		reporter.scheduleAtFixedRate(this::reportQuietly, interval, interval, TimeUnit.SECONDS);
+
+		logger.debug("{} instantiated, interval: {}", this, interval);
+	}
+
+	/**
+	 * Registers the metric, replacing the metric registered with the same name.
+	 * @param name the name of the metric
+	 * @param metric the supplier of the metric's current value
+	 */
+	public void register(@Nonnull String name, @Nonnull Supplier<?> metric) {
+		synchronized (metrics) {
+			metrics.put(name, metric);
+		}
+	}
+
+	/**
+	 * Returns the current values of the registered metrics, the way they are logged.
+	 * @return the comma-separated name=value pairs
+	 */
+	@Nonnull
+	public String report() {
+		StringJoiner report = new StringJoiner(", ");
+		synchronized (metrics) {
+			for (Map.Entry<String, Supplier<?>> metric: metrics.entrySet()) {
+				report.add(metric.getKey() + "=" + format(metric.getValue().get()));
+			}
+		}
+		return report.toString();
+	}
+
+	@Override
+	public void close() {
+		reporter.shutdownNow();
+	}
+
+	private void reportQuietly() {
+		try {
+			String report = report();
+			if (!report.isEmpty()) logger.info("Metrics: {}", report);
+		} catch (RuntimeException e) {
+			logger.warn("{} couldn't report the metrics", this, e);
+		}
+	}
+
+	private static String format(Object value) {
+		if (value instanceof Double || value instanceof Float) return String.format(Locale.ROOT, "%.3f", value);
+		return String.valueOf(value);
+	}
+}
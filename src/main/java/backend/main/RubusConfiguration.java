@@ -21,18 +21,34 @@ package backend.main;
 
 import backend.authontication.Authenticator;
 import backend.authontication.DefaultAuthenticator;
+import backend.controllers.DataStreams;
+import backend.controllers.DirectBufferPool;
+import backend.controllers.HttpRequestController;
 import backend.controllers.RequestProcessor;
 import backend.interactors.DefaultMediaProvider;
 import backend.interactors.MediaDataAccess;
 import backend.interactors.MediaProvider;
+import backend.persistence.CatalogMediaDataAccess;
+import backend.persistence.ConnectionPoolMetrics;
+import backend.persistence.MediaCache;
+import backend.persistence.MediaChangeObserver;
 import backend.persistence.PostgresAccessStrategy;
+import backend.persistence.PostgresMediaChangeListener;
 import backend.persistence.SerializableTransactionFailureAdvising;
 import backend.persistence.SqlAccessStrategy;
 import backend.persistence.SqlMediaDataAccess;
+import backend.querying.ClipCache;
 import backend.querying.DefaultQueryingStrategyFactory;
+import backend.querying.HttpOriginClient;
+import backend.querying.MappedRegionCache;
 import backend.querying.QueryingStrategyFactory;
+import backend.querying.ReadCoalescer;
+import backend.querying.S3Client;
 import backend.authorization.BasicViewerAuthorizer;
 import backend.authorization.ViewerAuthorizer;
+import com.zaxxer.hikari.HikariConfig;
+import com.zaxxer.hikari.HikariDataSource;
+import jakarta.annotation.Nonnull;
 import org.postgresql.ds.PGSimpleDataSource;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -40,11 +56,13 @@ import org.springframework.beans.factory.annotation.Value;
 import org.springframework.boot.Banner;
 import org.springframework.boot.SpringApplication;
 import org.springframework.boot.autoconfigure.SpringBootApplication;
+import org.springframework.boot.web.server.Compression;
 import org.springframework.boot.web.server.ConfigurableWebServerFactory;
 import org.springframework.boot.web.server.Ssl;
 import org.springframework.boot.web.server.WebServerFactoryCustomizer;
 import org.springframework.context.annotation.Bean;
 import org.springframework.context.annotation.ComponentScan;
+import org.springframework.context.annotation.Primary;
 import org.springframework.core.annotation.Order;
 import org.springframework.core.task.AsyncTaskExecutor;
 import org.springframework.core.task.SimpleAsyncTaskExecutor;
@@ -53,13 +71,20 @@ import org.springframework.jdbc.support.JdbcTransactionManager;
 import org.springframework.transaction.PlatformTransactionManager;
 import org.springframework.transaction.annotation.EnableTransactionManagement;
 import org.springframework.transaction.annotation.RollbackOn;
+import org.springframework.web.context.request.NativeWebRequest;
+import org.springframework.web.context.request.async.AsyncWebRequest;
+import org.springframework.web.context.request.async.CallableProcessingInterceptor;
+import org.springframework.web.servlet.config.annotation.AsyncSupportConfigurer;
+import org.springframework.web.servlet.config.annotation.WebMvcConfigurer;
 
 import javax.sql.DataSource;
 import java.io.IOException;
 import java.net.InetAddress;
+import java.net.URI;
 import java.net.UnknownHostException;
 import java.nio.file.Path;
 import java.util.Arrays;
+import java.util.concurrent.Callable;
 
 /**
  * Configuration, dependency injection, and embedded container launch.
@@ -82,22 +107,37 @@ public class RubusConfiguration {
 		}
 	}
 
+	@Bean
+	ConnectionPoolMetrics connectionPoolMetrics() {
+		return new ConnectionPoolMetrics();
+	}
+
 	@Bean
 	DataSource dataSource(
 		Config config,
+		ConnectionPoolMetrics connectionPoolMetrics,
 		@Value("${rubus.db.user}") String user,
 		@Value("${rubus.db.password}") String password
 	) {
-		PGSimpleDataSource dataSource = new PGSimpleDataSource();
-		dataSource.setUser(user);
-		dataSource.setPassword(password);
-		String databaseAddress = config.get("database-address");
-		dataSource.setServerNames(new String[] {databaseAddress});
-		int databasePort = Integer.parseInt(config.get("database-port"));
-		dataSource.setPortNumbers(new int[] {databasePort});
-		String databaseName = config.get("database-name");
-		dataSource.setDatabaseName(databaseName);
-		return dataSource;
+		// The requests are served by virtual threads, which aren't limited in number, so the pool size is what limits
+		// the amount of concurrent database queries; the threads that don't fit wait for a connection instead
+		HikariConfig hikariConfig = new HikariConfig();
+		hikariConfig.setPoolName("rubus-db-pool");
+		hikariConfig.setDataSource(postgresDataSource(config, user, password));
+		String poolSize = config.get("database-pool-size");
+		hikariConfig.setMaximumPoolSize(poolSize == null ? 10 : Integer.parseInt(poolSize));
+		String minIdle = config.get("database-pool-min-idle");
+		if (minIdle != null) hikariConfig.setMinimumIdle(Integer.parseInt(minIdle));
+		String idleTimeout = config.get("database-pool-idle-timeout");
+		if (idleTimeout != null) hikariConfig.setIdleTimeout(Long.parseLong(idleTimeout) * 1000);
+		String maxLifetime = config.get("database-pool-max-lifetime");
+		if (maxLifetime != null) hikariConfig.setMaxLifetime(Long.parseLong(maxLifetime) * 1000);
+		String connectionTimeout = config.get("database-pool-connection-timeout");
+		if (connectionTimeout != null) hikariConfig.setConnectionTimeout(Long.parseLong(connectionTimeout) * 1000);
+		String keepaliveTime = config.get("database-pool-keepalive-time");
+		if (keepaliveTime != null) hikariConfig.setKeepaliveTime(Long.parseLong(keepaliveTime) * 1000);
+		hikariConfig.setMetricsTrackerFactory(connectionPoolMetrics);
+		return new HikariDataSource(hikariConfig);
 	}
 
 	@Bean
@@ -121,14 +161,94 @@ public class RubusConfiguration {
 		return new SerializableTransactionFailureAdvising(retryAttempts);
 	}
 
+	@Bean
+	DirectBufferPool directBufferPool(Config config) {
+		String chunkSize = config.get("io-chunk-size");
+		String buffersPerSizeClass = config.get("io-buffer-pool-size");
+		DirectBufferPool directBufferPool = new DirectBufferPool(
+			chunkSize == null ? DirectBufferPool.DEFAULT_CHUNK_SIZE : Integer.parseInt(chunkSize),
+			buffersPerSizeClass == null ?
+				DirectBufferPool.DEFAULT_BUFFERS_PER_SIZE_CLASS :
+				Integer.parseInt(buffersPerSizeClass)
+		);
+		DataStreams.setBufferPool(directBufferPool);
+		return directBufferPool;
+	}
+
 	@Bean
 	ViewerAuthorizer viewerValidator() {
 		return new BasicViewerAuthorizer();
 	}
 
 	@Bean
-	QueryingStrategyFactory queryingStrategyFactory() {
-		return new DefaultQueryingStrategyFactory();
+	QueryingStrategyFactory queryingStrategyFactory(Config config) throws IOException {
+		String contentRootCacheSize = config.get("content-root-cache-size");
+		DefaultQueryingStrategyFactory queryingStrategyFactory = new DefaultQueryingStrategyFactory(
+			contentRootCacheSize == null ?
+				DefaultQueryingStrategyFactory.DEFAULT_CAPACITY :
+				Integer.parseInt(contentRootCacheSize)
+		);
+		if (Boolean.parseBoolean(config.get("mmap-enabled"))) {
+			String budget = config.get("mmap-budget");
+			String threshold = config.get("mmap-threshold");
+			queryingStrategyFactory.setMappedRegionCache(
+				new MappedRegionCache(
+					budget == null ? MappedRegionCache.DEFAULT_BUDGET : Long.parseLong(budget),
+					threshold == null ? MappedRegionCache.DEFAULT_MAP_THRESHOLD : Integer.parseInt(threshold)
+				)
+			);
+		}
+		String revalidationInterval = config.get("content-root-revalidation-interval");
+		if (revalidationInterval != null) {
+			queryingStrategyFactory.setRevalidationInterval(Integer.parseInt(revalidationInterval));
+		}
+		String openParallelism = config.get("open-parallelism");
+		if (openParallelism != null) queryingStrategyFactory.setOpenParallelism(Integer.parseInt(openParallelism));
+		String readAheadClips = config.get("read-ahead-clips");
+		if (readAheadClips != null) queryingStrategyFactory.setReadAheadClips(Integer.parseInt(readAheadClips));
+		String readAheadRoots = config.get("read-ahead-roots");
+		if (readAheadRoots != null) {
+			queryingStrategyFactory.setReadAheadRoots(
+				Arrays.stream(readAheadRoots.split(","))
+					.map(String::strip)
+					.filter(root -> !root.isEmpty())
+					.map(Path::of)
+					.toList()
+			);
+		}
+		String s3Region = config.get("s3-region");
+		String s3Endpoint = config.get("s3-endpoint");
+		if (s3Region != null || s3Endpoint != null) {
+			String region = s3Region == null ? S3Client.DEFAULT_REGION : s3Region;
+			queryingStrategyFactory.setS3Client(
+				new S3Client(
+					s3Endpoint == null ? S3Client.defaultEndpoint(region) : URI.create(s3Endpoint),
+					region,
+					config.get("s3-access-key"),
+					config.get("s3-secret-key")
+				)
+			);
+		}
+		String originCacheLocation = config.get("origin-cache-location");
+		if (originCacheLocation != null) {
+			String capacity = config.get("origin-cache-size");
+			queryingStrategyFactory.setHttpOriginClient(
+				new HttpOriginClient(
+					Path.of(originCacheLocation),
+					capacity == null ? HttpOriginClient.DEFAULT_CAPACITY : Long.parseLong(capacity)
+				)
+			);
+		}
+		if (Boolean.parseBoolean(config.get("clip-cache-enabled"))) {
+			String capacity = config.get("clip-cache-size");
+			queryingStrategyFactory.setClipCache(
+				new ClipCache(capacity == null ? ClipCache.DEFAULT_CAPACITY : Long.parseLong(capacity))
+			);
+		}
+		if (Boolean.parseBoolean(config.get("read-coalescing-enabled"))) {
+			queryingStrategyFactory.setReadCoalescer(new ReadCoalescer(ReadCoalescer.DEFAULT_MAX_PAYLOAD_SIZE));
+		}
+		return queryingStrategyFactory;
 	}
 
 	@Bean
@@ -137,10 +257,94 @@ public class RubusConfiguration {
 	}
 
 	@Bean
-	MediaDataAccess mediaDataAccess(
-		QueryingStrategyFactory queryingStrategyFactory, SqlAccessStrategy sqlAccessStrategy
+	MediaCache mediaCache(Config config) {
+		String capacity = config.get("media-cache-size");
+		String ttl = config.get("media-cache-ttl");
+		return new MediaCache(
+			capacity == null ? MediaCache.DEFAULT_CAPACITY : Integer.parseInt(capacity),
+			ttl == null ? MediaCache.DEFAULT_TTL : Integer.parseInt(ttl)
+		);
+	}
+
+	@Bean
+	MetricsReporter metricsReporter(
+		Config config,
+		MediaCache mediaCache,
+		ConnectionPoolMetrics connectionPoolMetrics,
+		DirectBufferPool directBufferPool,
+		QueryingStrategyFactory queryingStrategyFactory
+	) {
+		String interval = config.get("metrics-report-interval");
+		MetricsReporter metricsReporter = new MetricsReporter(
+			interval == null ? MetricsReporter.DEFAULT_INTERVAL : Integer.parseInt(interval)
+		);
+		metricsReporter.register("media-cache-hits", mediaCache::getHits);
+		metricsReporter.register("media-cache-misses", mediaCache::getMisses);
+		metricsReporter.register("db-pool-acquisitions", connectionPoolMetrics::getAcquisitions);
+		metricsReporter.register("db-pool-average-wait-nanos", connectionPoolMetrics::getAverageWaitNanos);
+		metricsReporter.register("db-pool-max-wait-nanos", connectionPoolMetrics::getMaxWaitNanos);
+		metricsReporter.register("db-pool-timeouts", connectionPoolMetrics::getTimeouts);
+		metricsReporter.register("db-pool-pending-threads", connectionPoolMetrics::getPendingThreads);
+		metricsReporter.register("db-pool-utilization", connectionPoolMetrics::getUtilization);
+		metricsReporter.register("io-buffer-pool-hits", directBufferPool::getHits);
+		metricsReporter.register("io-buffer-pool-misses", directBufferPool::getMisses);
+		if (queryingStrategyFactory instanceof DefaultQueryingStrategyFactory defaultQueryingStrategyFactory) {
+			ClipCache clipCache = defaultQueryingStrategyFactory.getClipCache();
+			if (clipCache != null) {
+				metricsReporter.register("clip-cache-hit-ratio", clipCache::getHitRatio);
+				metricsReporter.register("clip-cache-rejections", clipCache::getRejections);
+				metricsReporter.register("clip-cache-cached-bytes", clipCache::getCachedBytes);
+			}
+			if (defaultQueryingStrategyFactory.getReadAheadClips() > 0) {
+				metricsReporter.register("read-ahead-warmed-bytes", defaultQueryingStrategyFactory::getWarmedBytes);
+			}
+			ReadCoalescer readCoalescer = defaultQueryingStrategyFactory.getReadCoalescer();
+			if (readCoalescer != null) {
+				metricsReporter.register("read-coalescer-reads", readCoalescer::getReads);
+				metricsReporter.register("read-coalescer-coalesce-ratio", readCoalescer::getCoalesceRatio);
+			}
+		}
+		return metricsReporter;
+	}
+
+	@Bean
+	PostgresMediaChangeListener postgresMediaChangeListener(
+		Config config,
+		MediaCache mediaCache,
+		MediaDataAccess mediaDataAccess,
+		@Value("${rubus.db.user}") String user,
+		@Value("${rubus.db.password}") String password
+	) {
+		// The cache is invalidated before the catalog reloads the changed media, so the catalog doesn't reload them
+		// from the cache
+		MediaChangeObserver[] observers = mediaDataAccess instanceof CatalogMediaDataAccess catalogMediaDataAccess ?
+			new MediaChangeObserver[] {mediaCache, catalogMediaDataAccess} :
+			new MediaChangeObserver[] {mediaCache};
+		// The listener holds its connection for as long as the server runs, so the connection doesn't come from
+		// the pool
+		return new PostgresMediaChangeListener(postgresDataSource(config, user, password), observers);
+	}
+
+	@Bean
+	SqlMediaDataAccess sqlMediaDataAccess(
+		QueryingStrategyFactory queryingStrategyFactory, SqlAccessStrategy sqlAccessStrategy, MediaCache mediaCache
 	) {
-		return new SqlMediaDataAccess(queryingStrategyFactory, sqlAccessStrategy);
+		SqlMediaDataAccess sqlMediaDataAccess = new SqlMediaDataAccess(queryingStrategyFactory, sqlAccessStrategy);
+		sqlMediaDataAccess.setMediaCache(mediaCache);
+		return sqlMediaDataAccess;
+	}
+
+	@Primary
+	@Bean
+	MediaDataAccess mediaDataAccess(Config config, SqlMediaDataAccess sqlMediaDataAccess) {
+		if (!Boolean.parseBoolean(config.get("media-catalog-enabled"))) return sqlMediaDataAccess;
+		String refreshInterval = config.get("media-catalog-refresh-interval");
+		return new CatalogMediaDataAccess(
+			sqlMediaDataAccess,
+			refreshInterval == null ?
+				CatalogMediaDataAccess.DEFAULT_REFRESH_INTERVAL :
+				Integer.parseInt(refreshInterval)
+		);
 	}
 
 	@Bean
@@ -154,8 +358,13 @@ public class RubusConfiguration {
 	}
 
 	@Bean
-	RequestProcessor requestProcessor(MediaProvider mediaProvider, Authenticator authenticator) {
-		return new RequestProcessor(mediaProvider, authenticator);
+	RequestProcessor requestProcessor(Config config, MediaProvider mediaProvider, Authenticator authenticator) {
+		RequestProcessor requestProcessor = new RequestProcessor(mediaProvider, authenticator);
+		String maxClips = config.get("fetch-max-clips");
+		if (maxClips != null) requestProcessor.setMaxClipsPerFetch(Integer.parseInt(maxClips));
+		String maxBytes = config.get("fetch-max-bytes");
+		if (maxBytes != null) requestProcessor.setMaxBytesPerFetch(Long.parseLong(maxBytes));
+		return requestProcessor;
 	}
 
 	@Bean
@@ -167,6 +376,10 @@ public class RubusConfiguration {
 		String privateKeyLocation = config.get("private-key-location");
 		int listeningPort = Integer.parseInt(config.get("listening-port"));
 		InetAddress bindAddress = InetAddress.getByName(config.get("bind-address"));
+		String metadataCompressionEnabled = config.get("metadata-compression-enabled");
+		Compression compression = new Compression();
+		compression.setEnabled(metadataCompressionEnabled == null || Boolean.parseBoolean(metadataCompressionEnabled));
+		compression.setMimeTypes(new String[] {HttpRequestController.METADATA_MEDIA_TYPE});
 		return factory -> {
 			if (privateKeyLocation != null && certificateLocation != null && secureConnectionEnabled) {
 				Ssl ssl = new Ssl();
@@ -174,6 +387,7 @@ public class RubusConfiguration {
 				ssl.setCertificatePrivateKey("file:" + privateKeyLocation);
 				factory.setSsl(ssl);
 			}
+			factory.setCompression(compression);
 			factory.setPort(listeningPort);
 			factory.setAddress(bindAddress);
 		};
@@ -186,6 +400,39 @@ public class RubusConfiguration {
 		return simpleAsyncTaskExecutor;
 	}
 
+	@Bean
+	WebMvcConfigurer asyncSupportConfigurer() {
+		return new WebMvcConfigurer() {
+			@Override
+			public void configureAsyncSupport(@Nonnull AsyncSupportConfigurer configurer) {
+				configurer.registerCallableInterceptors(new FetchTimeoutInterceptor());
+			}
+		};
+	}
+
+	/**
+	 * Returns an unpooled {@link DataSource} of the database specified in the config.
+	 * @param config the config
+	 * @param user the database user
+	 * @param password the password of the database user
+	 * @return the {@link PGSimpleDataSource} instance
+	 */
+	public static PGSimpleDataSource postgresDataSource(Config config, String user, String password) {
+		PGSimpleDataSource dataSource = new PGSimpleDataSource();
+		dataSource.setUser(user);
+		dataSource.setPassword(password);
+		String databaseAddress = config.get("database-address");
+		dataSource.setServerNames(new String[] {databaseAddress});
+		int databasePort = Integer.parseInt(config.get("database-port"));
+		dataSource.setPortNumbers(new int[] {databasePort});
+		String databaseName = config.get("database-name");
+		dataSource.setDatabaseName(databaseName);
+		// The statements are prepared on the server on their first execution rather than the fifth; the pooled
+		// connections keep them in their statement caches
+		dataSource.setPrepareThreshold(1);
+		return dataSource;
+	}
+
 	public static void main(String[] args) {
 		if (logger.isInfoEnabled()) {
 			logger.info("Starting process with arguments: {}", Arrays.toString(args));
@@ -194,4 +441,20 @@ public class RubusConfiguration {
 		springApplication.setBannerMode(Banner.Mode.OFF);
 		springApplication.run(args);
 	}
+
+	/**
+	 * FetchTimeoutInterceptor lifts the asynchronous request timeout of the FETCH requests only. Their responses are
+	 * written for as long as the client needs to receive them, and a stalled client is cut off by the write timeout of
+	 * the container instead. The LIST and INFO requests keep the default timeout, so one hanging on the database or on
+	 * the connection pool doesn't occupy its request forever.
+	 */
+	private static class FetchTimeoutInterceptor implements CallableProcessingInterceptor {
+
+		@Override
+		public <T> void beforeConcurrentHandling(@Nonnull NativeWebRequest request, @Nonnull Callable<T> task) {
+			if (!"FETCH".equals(request.getParameter("request_type"))) return;
+			// The request is the one whose asynchronous processing is about to start, so its timeout can still be set
+			if (request instanceof AsyncWebRequest asyncWebRequest) asyncWebRequest.setTimeout(-1L);
+		}
+	}
 }
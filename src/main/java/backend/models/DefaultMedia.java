@@ -20,6 +20,8 @@
 package backend.models;
 
 import backend.exceptions.QueryingException;
+import backend.exceptions.QueryingStrategyFactoryException;
+import backend.querying.QueryingStrategyFactory;
 import backend.querying.QueryingStrategyInterface;
 import jakarta.annotation.Nonnull;
 import org.slf4j.Logger;
@@ -30,7 +32,11 @@ import java.nio.channels.SeekableByteChannel;
 import java.util.UUID;
 
 /**
- * A concrete implementation of {@link Media}.
+ * A concrete implementation of {@link Media}. The querying strategy is either passed on construction or requested
+ * from a {@link QueryingStrategyFactory} every time the media content is retrieved, so media that are only listed
+ * don't pay for resolving their content location. The factory caches its strategies and may close one to replace it,
+ * e.g. when its content root changes, so the media don't keep the strategy they got; a retrieval that fails because its
+ * strategy was replaced meanwhile is retried once with the current one.
  */
 public class DefaultMedia implements Media {
 
@@ -44,7 +50,9 @@ public class DefaultMedia implements Media {
 
 	private final URI contentUri;
 
-	private QueryingStrategyInterface qsi;
+	private final QueryingStrategyFactory queryingStrategyFactory;
+
+	private volatile QueryingStrategyInterface qsi;
 
 	/**
 	 * Constructs an instance of this class.
@@ -67,6 +75,7 @@ public class DefaultMedia implements Media {
 		this.title = title;
 		this.duration = duration;
 		this.contentUri = contentUri;
+		this.queryingStrategyFactory = null;
 		setQueryingStrategy(queryingStrategyInterface);
 
 		logger.debug(
@@ -79,6 +88,40 @@ public class DefaultMedia implements Media {
 		);
 	}
 
+	/**
+	 * Constructs an instance of this class that requests its querying strategy from the factory on every retrieval of
+	 * the media content.
+	 * @param id the media id
+	 * @param title the title
+	 * @param duration the duration
+	 * @param contentUri the URI of the media content
+	 * @param queryingStrategyFactory the factory that provides the querying strategy for contentUri
+	 */
+	public DefaultMedia(
+		@Nonnull UUID id,
+		@Nonnull String title,
+		int duration,
+		@Nonnull URI contentUri,
+		@Nonnull QueryingStrategyFactory queryingStrategyFactory
+	) {
+		assert duration > 0;
+
+		this.id = id;
+		this.title = title;
+		this.duration = duration;
+		this.contentUri = contentUri;
+		this.queryingStrategyFactory = queryingStrategyFactory;
+
+		logger.debug(
+			"{} instantiated, id: {}, title: {}, duration: {} QueryingStrategyFactory: {}",
+			this,
+			id,
+			title,
+			duration,
+			queryingStrategyFactory
+		);
+	}
+
 	@Nonnull
 	@Override
 	public UUID getID() {
@@ -118,7 +161,7 @@ public class DefaultMedia implements Media {
 		for (int arrayIndex = 0; arrayIndex < audioClipsNames.length; arrayIndex++) {
 			audioClipsNames[arrayIndex] = "a" + (arrayIndex + offset);
 		}
-		return qsi.query(audioClipsNames);
+		return query(audioClipsNames);
 	}
 
 	/**
@@ -137,23 +180,47 @@ public class DefaultMedia implements Media {
 		for (int arrayIndex = 0; arrayIndex < videoClipsNames.length; arrayIndex++) {
 			videoClipsNames[arrayIndex] = "v" + (arrayIndex + offset);
 		}
-		return qsi.query(videoClipsNames);
+		return query(videoClipsNames);
 	}
 
 	/**
-	 * Returns the current {@link QueryingStrategyInterface} instance.
+	 * Returns the current {@link QueryingStrategyInterface} instance. If the media was constructed with
+	 * a {@link QueryingStrategyFactory} and no strategy has been set since, it's requested from the factory on every
+	 * call, so it mustn't be kept by the callers.
 	 * @return the current {@link QueryingStrategyInterface} instance
+	 * @throws QueryingException if the querying strategy can't be instantiated
 	 */
 	@Nonnull
-	public QueryingStrategyInterface getQueryingStrategy() {
-		return qsi;
+	public QueryingStrategyInterface getQueryingStrategy() throws QueryingException {
+		QueryingStrategyInterface result = qsi;
+		if (result != null) return result;
+		try {
+			return queryingStrategyFactory.getQueryingStrategy(contentUri);
+		} catch (QueryingStrategyFactoryException e) {
+			logger.error("{} couldn't instantiate querying strategy for {}", this, contentUri, e);
+			throw new QueryingException(e);
+		}
 	}
 
 	/**
-	 * Sets a new {@link QueryingStrategyInterface} instance.
+	 * Sets a new {@link QueryingStrategyInterface} instance, which is used instead of the factory's from now on.
 	 * @param newQueryingStrategy a new {@link QueryingStrategyInterface} instance
 	 */
 	public void setQueryingStrategy(@Nonnull QueryingStrategyInterface newQueryingStrategy) {
 		qsi = newQueryingStrategy;
 	}
+
+	// The factory may close the strategy between the request and the query to replace it, in which case the query
+	// fails and is retried once with the replacement
+	private SeekableByteChannel[] query(String[] names) throws QueryingException {
+		QueryingStrategyInterface queryingStrategy = getQueryingStrategy();
+		try {
+			return queryingStrategy.query(names);
+		} catch (QueryingException e) {
+			if (qsi != null) throw e;
+			QueryingStrategyInterface currentQueryingStrategy = getQueryingStrategy();
+			if (currentQueryingStrategy == queryingStrategy) throw e;
+			return currentQueryingStrategy.query(names);
+		}
+	}
 }
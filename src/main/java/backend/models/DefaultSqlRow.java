@@ -61,6 +61,12 @@ public class DefaultSqlRow implements SqlRow {
 		return value == null ? 0 : (int) value;
 	}
 
+	@Override
+	public float getFloat(@Nonnull String columnName) {
+		Object value = mapping.get(columnName);
+		return value == null ? 0 : ((Number) value).floatValue();
+	}
+
 	@Nullable
 	@Override
 	public String getString(@Nonnull String columnName) {
@@ -0,0 +1,74 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.models;
+
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * IndexedSqlRow is an implementation of {@link SqlRow} that stores the values of the row in an array in the order of
+ * the columns. The mapping of the columns' names to the positions in the array is shared by all the rows of the same
+ * result, so a row costs a single array instead of a map of its own.
+ * @param columnsIndexes the mapping of the columns' names to the positions of their values
+ * @param values the values of the row
+ */
+public record IndexedSqlRow(@Nonnull Map<String, Integer> columnsIndexes, @Nonnull Object[] values) implements SqlRow {
+
+	/**
+	 * Creates the mapping of the columns' names to the positions of their values that the rows of the same result
+	 * share.
+	 * @param columnsNames the columns' names in the order of their values
+	 * @return the mapping of the columns' names to their positions
+	 */
+	@Nonnull
+	public static Map<String, Integer> indexColumns(@Nonnull String... columnsNames) {
+		HashMap<String, Integer> columnsIndexes = HashMap.newHashMap(columnsNames.length);
+		for (int i = 0; i < columnsNames.length; i++) {
+			columnsIndexes.put(columnsNames[i], i);
+		}
+		return Map.copyOf(columnsIndexes);
+	}
+
+	@Override
+	public int getInt(@Nonnull String columnName) {
+		Object value = valueOf(columnName);
+		return value == null ? 0 : ((Number) value).intValue();
+	}
+
+	@Override
+	public float getFloat(@Nonnull String columnName) {
+		Object value = valueOf(columnName);
+		return value == null ? 0 : ((Number) value).floatValue();
+	}
+
+	@Nullable
+	@Override
+	public String getString(@Nonnull String columnName) {
+		return (String) valueOf(columnName);
+	}
+
+	private Object valueOf(String columnName) {
+		Integer index = columnsIndexes.get(columnName);
+		return index == null ? null : values[index];
+	}
+}
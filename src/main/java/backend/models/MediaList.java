@@ -20,12 +20,24 @@
 package backend.models;
 
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 
 import java.util.Map;
 import java.util.UUID;
 
 /**
- * MediaLists stores id-title pairs.
- * @param media the map containing id-title pairs
+ * MediaLists stores id-title pairs. A MediaList can be a single page of a larger result; in this case cursor identifies
+ * the position the next page starts at.
+ * @param media the map containing id-title pairs in the order of the result
+ * @param cursor the opaque value to request the next page with, or null if there are no more pages
  */
-public record MediaList(@Nonnull Map<UUID, String> media) { }
+public record MediaList(@Nonnull Map<UUID, String> media, @Nullable String cursor) {
+
+	/**
+	 * Constructs a MediaList that isn't followed by other pages.
+	 * @param media the map containing id-title pairs
+	 */
+	public MediaList(@Nonnull Map<UUID, String> media) {
+		this(media, null);
+	}
+}
@@ -34,6 +34,13 @@ public interface SqlRow {
 	 */
 	int getInt(@Nonnull String columnName);
 
+	/**
+	 * Returns the value of the specified column. If the value is null, 0 is returned.
+	 * @param columnName the column name
+	 * @return the value of the specified column
+	 */
+	float getFloat(@Nonnull String columnName);
+
 	/**
 	 * Returns the value of the specified column.
 	 * @param columnName the column name
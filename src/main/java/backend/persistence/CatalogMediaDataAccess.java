@@ -0,0 +1,422 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import backend.exceptions.CommonDataAccessException;
+import backend.interactors.MediaDataAccess;
+import backend.models.Media;
+import backend.models.MediaPage;
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.PriorityQueue;
+import java.util.Set;
+import java.util.UUID;
+import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * CatalogMediaDataAccess serves media from an in-memory catalog, so listing, searching, and looking up media don't
+ * access the storage facilities. The catalog holds every media along with an inverted index over the words of their
+ * titles. It's loaded from another {@link MediaDataAccess} instance, the source of truth, when this instance is
+ * constructed, and then it's refreshed in the background:
+ * <ul>
+ *     <li>every refresh interval, the whole catalog is reloaded and compared with the current one; the unchanged media
+ *     keep their entries, so their titles aren't indexed again. The media request their querying strategies on every
+ *     retrieval, so a content root that changed, e.g. was packed, is served by its current strategy without waiting
+ *     for a refresh</li>
+ *     <li>a media reported by {@link #mediaChanged(UUID)} is reloaded on its own</li>
+ * </ul>
+ * The search matches the media whose title contains every word of the search query. Unlike the full-text search of
+ * a database, the words are only compared case-insensitively, without stemming and stop words, and the search query
+ * syntax isn't interpreted. The media are ranked by the share of their title words that occur in the search query,
+ * which isn't comparable with the rank of the database search, so the search results and their order may differ
+ * from those of the source. To keep paging consistent, the cursors issued by the catalog are tagged with
+ * {@link #CURSOR_TAG}: a page requested with an untagged cursor, i.e. one issued by the source while the catalog
+ * wasn't loaded, is served by the source, so the pages of a search never mix the two orders. A blank search query
+ * matches every media, and the catalog keeps them ordered by id, so its pages are served without sorting.<br>
+ * A media that isn't in the catalog is looked up in the source, so a media added since the last refresh can be
+ * retrieved by its id right away. Suggestions are always served by the source, and so is every request until
+ * the catalog is loaded.
+ */
+public class CatalogMediaDataAccess implements MediaDataAccess, MediaChangeObserver, AutoCloseable {
+
+	/**
+	 * The amount of seconds between the full refreshes of the catalog if it's not configured.
+	 */
+	public static final int DEFAULT_REFRESH_INTERVAL = 300;
+
+	/**
+	 * The prefix of the cursors issued by the catalog.
+	 */
+	public static final String CURSOR_TAG = "catalog:";
+
+	private static final Comparator<Match> RANK_ORDER = (match1, match2) -> {
+		int comparison = Float.compare(match2.rank(), match1.rank());
+		return comparison != 0 ? comparison : match1.entry().id().compareTo(match2.entry().id());
+	};
+
+	private final Logger logger = LoggerFactory.getLogger(CatalogMediaDataAccess.class);
+
+	private final MediaDataAccess source;
+
+	private final ScheduledExecutorService refresher;
+
+	private final Object refreshLock = new Object();
+
+	private volatile Catalog catalog = null;
+
+	private record Entry(Media media, String id, List<String> words, Set<String> distinctWords) {
+
+		static Entry of(Media media) {
+			List<String> words = words(media.getTitle());
+			return new Entry(media, media.getID().toString(), words, Set.copyOf(words));
+		}
+	}
+
+	private record Catalog(Map<UUID, Entry> entries, Map<String, List<Entry>> index, List<Entry> byId) { }
+
+	private record Match(Entry entry, float rank) { }
+
+	private record Cursor(float rank, String id) { }
+
+	/**
+	 * Constructs an instance of this class and loads the catalog. If the catalog can't be loaded, the requests are
+	 * served by the source until one of the following refreshes succeeds.
+	 * @param source the {@link MediaDataAccess} instance the catalog is loaded from
+	 * @param refreshInterval the amount of seconds between the full refreshes of the catalog; must be positive
+	 */
+	public CatalogMediaDataAccess(@Nonnull MediaDataAccess source, int refreshInterval) {
+		if (refreshInterval <= 0) throw new IllegalArgumentException("The refresh interval must be positive");
+		this.source = source;
+		refresher = Executors.newSingleThreadScheduledExecutor(
+			Thread.ofPlatform().daemon().name("media-catalog-refresher").factory()
+		);
+		refreshQuietly();
+		refresher.scheduleWithFixedDelay(this::refreshQuietly, refreshInterval, refreshInterval, TimeUnit.SECONDS);
+
+		logger.debug("{} instantiated, MediaDataAccess: {}, refreshInterval: {}", this, source, refreshInterval);
+	}
+
+	@Nonnull
+	@Override
+	public Media[] getMedia() throws CommonDataAccessException {
+		Catalog current = catalog;
+		if (current == null) return source.getMedia();
+		return current.entries().values().stream().map(Entry::media).toArray(Media[]::new);
+	}
+
+	@Nullable
+	@Override
+	public Media getMedia(@Nonnull UUID mediaId) throws CommonDataAccessException {
+		Catalog current = catalog;
+		if (current != null) {
+			Entry entry = current.entries().get(mediaId);
+			if (entry != null) return entry.media();
+		}
+		return source.getMedia(mediaId);
+	}
+
+	@Nonnull
+	@Override
+	public Media[] searchMedia(@Nonnull String searchQuery) throws CommonDataAccessException {
+		Catalog current = catalog;
+		if (current == null) return source.searchMedia(searchQuery);
+		Set<String> queryWords = new HashSet<>(words(searchQuery));
+		if (queryWords.isEmpty()) return current.byId().stream().map(Entry::media).toArray(Media[]::new);
+		List<Match> matches = new ArrayList<>();
+		for (Entry entry: candidates(current, queryWords)) {
+			Match match = match(entry, queryWords);
+			if (match != null) matches.add(match);
+		}
+		matches.sort(RANK_ORDER);
+		return matches.stream().map(match -> match.entry().media()).toArray(Media[]::new);
+	}
+
+	/**
+	 * {@inheritDoc}<br>
+	 * The cursor consists of {@link #CURSOR_TAG}, the search rank, and the id of the last media of the page. A page
+	 * requested with a cursor that isn't tagged is requested from the source, which issued the cursor. A tagged cursor
+	 * is rejected while the catalog isn't loaded. A page is selected without sorting all the matching media.
+	 */
+	@Nonnull
+	@Override
+	public MediaPage searchMedia(@Nonnull String searchQuery, int limit, @Nullable String cursor)
+		throws CommonDataAccessException {
+		if (limit <= 0) throw new IllegalArgumentException("The limit must be positive");
+		Cursor last = null;
+		boolean catalogCursor = false;
+		if (cursor != null) {
+			catalogCursor = cursor.startsWith(CURSOR_TAG);
+			last = parseCursor(catalogCursor ? cursor.substring(CURSOR_TAG.length()) : cursor);
+			if (!catalogCursor) return source.searchMedia(searchQuery, limit, cursor);
+		}
+		Catalog current = catalog;
+		if (current == null) {
+			if (catalogCursor) throw new IllegalArgumentException("The catalog that issued the cursor isn't loaded");
+			return source.searchMedia(searchQuery, limit, null);
+		}
+
+		// One more media than the limit is selected to find out whether there is a next page
+		int size = (int) Math.min((long) limit + 1, Integer.MAX_VALUE);
+		List<Match> page;
+		Set<String> queryWords = new HashSet<>(words(searchQuery));
+		if (queryWords.isEmpty()) {
+			page = blankQueryPage(current.byId(), last, size);
+		} else {
+			// The worst selected match is at the head, so it's the one replaced by a better match
+			PriorityQueue<Match> selection = new PriorityQueue<>(RANK_ORDER.reversed());
+			for (Entry entry: candidates(current, queryWords)) {
+				Match match = match(entry, queryWords);
+				if (match == null || last != null && !isAfter(match, last)) continue;
+				selection.add(match);
+				if (selection.size() > size) selection.poll();
+			}
+			page = new ArrayList<>(selection);
+			page.sort(RANK_ORDER);
+		}
+
+		String nextCursor = null;
+		if (page.size() > limit) {
+			Match lastMatch = page.get(limit - 1);
+			nextCursor = CURSOR_TAG + lastMatch.rank() + ":" + lastMatch.entry().id();
+		}
+		Media[] media = page.stream().limit(limit).map(match -> match.entry().media()).toArray(Media[]::new);
+		return new MediaPage(media, nextCursor);
+	}
+
+	@Nonnull
+	@Override
+	public Media[] suggestMedia(@Nonnull String prefix, int limit) throws CommonDataAccessException {
+		return source.suggestMedia(prefix, limit);
+	}
+
+	/**
+	 * Reloads the whole catalog from the source and replaces the current one.
+	 * @throws CommonDataAccessException if the source can't be accessed
+	 */
+	public void refresh() throws CommonDataAccessException {
+		synchronized (refreshLock) {
+			Catalog current = catalog;
+			Map<UUID, Entry> entries = new LinkedHashMap<>();
+			int added = 0;
+			int modified = 0;
+			for (Media media: source.getMedia()) {
+				Entry previous = current == null ? null : current.entries().get(media.getID());
+				if (previous != null && isUnchanged(previous.media(), media)) {
+					entries.put(media.getID(), previous);
+					continue;
+				}
+				if (previous == null) added++;
+				else modified++;
+				entries.put(media.getID(), Entry.of(media));
+			}
+			int removed = current == null ? 0 : current.entries().size() - (entries.size() - added);
+			catalog = index(entries);
+
+			logger.debug(
+				"{} refreshed the catalog, size: {}, added: {}, modified: {}, removed: {}",
+				this,
+				entries.size(),
+				added,
+				modified,
+				removed
+			);
+		}
+	}
+
+	/**
+	 * Reloads the media associated with the specified id from the source, adding it to the catalog, replacing it,
+	 * or removing it from the catalog. Nothing is done if the catalog hasn't been loaded yet.
+	 * @param mediaId the media id
+	 * @throws CommonDataAccessException if the source can't be accessed
+	 */
+	public void refresh(@Nonnull UUID mediaId) throws CommonDataAccessException {
+		synchronized (refreshLock) {
+			Catalog current = catalog;
+			if (current == null) return;
+			Media media = source.getMedia(mediaId);
+			Map<UUID, Entry> entries = new LinkedHashMap<>(current.entries());
+			if (media != null) entries.put(mediaId, Entry.of(media));
+			else if (entries.remove(mediaId) == null) return;
+			catalog = index(entries);
+
+			logger.debug("{} refreshed media {} in the catalog", this, mediaId);
+		}
+	}
+
+	/**
+	 * Schedules reloading the changed media in the background. If the media can't be reloaded, the whole catalog is
+	 * reloaded instead.
+	 * @param mediaId the media id
+	 */
+	@Override
+	public void mediaChanged(@Nonnull UUID mediaId) {
+		schedule(() -> {
+			try {
+				refresh(mediaId);
+			} catch (Exception e) {
+				logger.warn("{} couldn't refresh media {}, refreshing the whole catalog", this, mediaId, e);
+				refreshQuietly();
+			}
+		});
+	}
+
+	/**
+	 * Schedules reloading the whole catalog in the background.
+	 */
+	@Override
+	public void allMediaChanged() {
+		schedule(this::refreshQuietly);
+	}
+
+	/**
+	 * Returns the amount of media in the catalog, or 0 if the catalog hasn't been loaded yet.
+	 * @return the amount of media in the catalog
+	 */
+	public int getSize() {
+		Catalog current = catalog;
+		return current == null ? 0 : current.entries().size();
+	}
+
+	/**
+	 * Stops refreshing the catalog.
+	 */
+	@Override
+	public void close() {
+		refresher.shutdownNow();
+	}
+
+	private void schedule(Runnable task) {
+		try {
+			refresher.execute(task);
+		} catch (RejectedExecutionException e) {
+			logger.debug("{} is closed, the refresh is dropped", this);
+		}
+	}
+
+	private void refreshQuietly() {
+		try {
+			refresh();
+		} catch (Exception e) {
+			logger.warn("{} couldn't refresh the catalog", this, e);
+		}
+	}
+
+	private static boolean isUnchanged(Media previous, Media current) {
+		return
+			previous.getTitle().equals(current.getTitle()) &&
+			previous.getDuration() == current.getDuration() &&
+			previous.getContentURI().equals(current.getContentURI());
+	}
+
+	private static Catalog index(Map<UUID, Entry> entries) {
+		Map<String, List<Entry>> index = new HashMap<>();
+		for (Entry entry: entries.values()) {
+			for (String word: entry.distinctWords()) index.computeIfAbsent(word, w -> new ArrayList<>()).add(entry);
+		}
+		List<Entry> byId = new ArrayList<>(entries.values());
+		byId.sort(Comparator.comparing(Entry::id));
+		return new Catalog(Collections.unmodifiableMap(entries), index, Collections.unmodifiableList(byId));
+	}
+
+	// Only the media that contain the rarest word of the search query may match it
+	private static Collection<Entry> candidates(Catalog catalog, Set<String> queryWords) {
+		Collection<Entry> candidates = catalog.entries().values();
+		for (String word: queryWords) {
+			List<Entry> entries = catalog.index().getOrDefault(word, List.of());
+			if (entries.size() < candidates.size()) candidates = entries;
+		}
+		return candidates;
+	}
+
+	// Returns null if the title doesn't contain every word of the non-empty search query
+	private static Match match(Entry entry, Set<String> queryWords) {
+		if (!entry.distinctWords().containsAll(queryWords)) return null;
+		long matchingWords = entry.words().stream().filter(queryWords::contains).count();
+		return new Match(entry, (float) matchingWords / entry.words().size());
+	}
+
+	// A blank search query matches every media with the rank 0, so its order is the order of the ids
+	private static List<Match> blankQueryPage(List<Entry> byId, Cursor last, int size) {
+		int start = 0;
+		if (last != null && last.rank() <= 0) {
+			if (last.rank() < 0) return List.of();
+			int low = 0, high = byId.size();
+			while (low < high) {
+				int middle = (low + high) >>> 1;
+				if (byId.get(middle).id().compareTo(last.id()) <= 0) low = middle + 1;
+				else high = middle;
+			}
+			start = low;
+		}
+		List<Match> page = new ArrayList<>();
+		for (int i = start; i < byId.size() && page.size() < size; i++) page.add(new Match(byId.get(i), 0));
+		return page;
+	}
+
+	private static boolean isAfter(Match match, Cursor last) {
+		return match.rank() < last.rank() || match.rank() == last.rank() && match.entry().id().compareTo(last.id()) > 0;
+	}
+
+	private static Cursor parseCursor(String cursor) {
+		int separator = cursor.indexOf(':');
+		if (separator < 0 || separator == cursor.length() - 1) {
+			throw new IllegalArgumentException("Malformed cursor: " + cursor);
+		}
+		float rank;
+		try {
+			rank = Float.parseFloat(cursor.substring(0, separator));
+		} catch (NumberFormatException e) {
+			throw new IllegalArgumentException("Malformed cursor: " + cursor, e);
+		}
+		if (!Float.isFinite(rank)) throw new IllegalArgumentException("Malformed cursor: " + cursor);
+		return new Cursor(rank, cursor.substring(separator + 1));
+	}
+
+	private static List<String> words(String text) {
+		List<String> words = new ArrayList<>();
+		int wordStart = -1;
+		for (int i = 0; i <= text.length(); i++) {
+			boolean isWordCharacter = i < text.length() && Character.isLetterOrDigit(text.charAt(i));
+			if (isWordCharacter && wordStart < 0) {
+				wordStart = i;
+			} else if (!isWordCharacter && wordStart >= 0) {
+				words.add(text.substring(wordStart, i).toLowerCase(Locale.ROOT));
+				wordStart = -1;
+			}
+		}
+		return words;
+	}
+}
@@ -0,0 +1,129 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import com.zaxxer.hikari.metrics.IMetricsTracker;
+import com.zaxxer.hikari.metrics.MetricsTrackerFactory;
+import com.zaxxer.hikari.metrics.PoolStats;
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.util.concurrent.atomic.LongAccumulator;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * ConnectionPoolMetrics collects the metrics of a HikariCP connection pool: how long the callers wait for
+ * a connection, how many of them time out, and how many of the pool's connections are in use. An instance is
+ * registered with {@link com.zaxxer.hikari.HikariConfig#setMetricsTrackerFactory(MetricsTrackerFactory)} and must be
+ * used with a single pool.
+ */
+public class ConnectionPoolMetrics implements MetricsTrackerFactory {
+
+	private final Logger logger = LoggerFactory.getLogger(ConnectionPoolMetrics.class);
+
+	private final LongAdder acquisitions = new LongAdder();
+
+	private final LongAdder totalWaitNanos = new LongAdder();
+
+	private final LongAccumulator maxWaitNanos = new LongAccumulator(Math::max, 0);
+
+	private final LongAdder timeouts = new LongAdder();
+
+	private volatile PoolStats poolStats;
+
+	/**
+	 * Constructs an instance of this class.
+	 */
+	public ConnectionPoolMetrics() {
+		logger.debug("{} instantiated", this);
+	}
+
+	@Nonnull
+	@Override
+	public IMetricsTracker create(String poolName, PoolStats poolStats) {
+		this.poolStats = poolStats;
+		return new IMetricsTracker() {
+			@Override
+			public void recordConnectionAcquiredNanos(long elapsedAcquiredNanos) {
+				acquisitions.increment();
+				totalWaitNanos.add(elapsedAcquiredNanos);
+				maxWaitNanos.accumulate(elapsedAcquiredNanos);
+			}
+
+			@Override
+			public void recordConnectionTimeout() {
+				timeouts.increment();
+			}
+		};
+	}
+
+	/**
+	 * Returns the amount of connections acquired from the pool.
+	 * @return the amount of acquisitions
+	 */
+	public long getAcquisitions() {
+		return acquisitions.sum();
+	}
+
+	/**
+	 * Returns the average time the callers waited for a connection in nanoseconds.
+	 * @return the average wait time, or 0 if no connections were acquired
+	 */
+	public long getAverageWaitNanos() {
+		long amount = acquisitions.sum();
+		return amount == 0 ? 0 : totalWaitNanos.sum() / amount;
+	}
+
+	/**
+	 * Returns the longest time a caller waited for a connection in nanoseconds.
+	 * @return the longest wait time
+	 */
+	public long getMaxWaitNanos() {
+		return maxWaitNanos.get();
+	}
+
+	/**
+	 * Returns the amount of callers that didn't get a connection within the connection timeout.
+	 * @return the amount of timeouts
+	 */
+	public long getTimeouts() {
+		return timeouts.sum();
+	}
+
+	/**
+	 * Returns the amount of callers currently waiting for a connection.
+	 * @return the amount of waiting callers
+	 */
+	public int getPendingThreads() {
+		PoolStats stats = poolStats;
+		return stats == null ? 0 : stats.getPendingThreads();
+	}
+
+	/**
+	 * Returns the share of the maximum pool size that is currently in use, a value between 0 and 1.
+	 * @return the pool utilization
+	 */
+	public double getUtilization() {
+		PoolStats stats = poolStats;
+		if (stats == null || stats.getMaxConnections() == 0) return 0;
+		return (double) stats.getActiveConnections() / stats.getMaxConnections();
+	}
+}
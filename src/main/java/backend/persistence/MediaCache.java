@@ -0,0 +1,194 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import backend.models.Media;
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.UUID;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.function.LongSupplier;
+
+/**
+ * MediaCache is a thread-safe cache of {@link Media} instances keyed by the media id. The cache holds at most
+ * a fixed amount of media, evicting the least recently used one when it's full, and every cached media expires after
+ * a fixed time-to-live, so changes that weren't explicitly invalidated become visible eventually. The cache counts
+ * hits, the lookups served from the cache, and misses, the lookups that found nothing or an expired media.
+ */
+public class MediaCache implements MediaChangeObserver {
+
+	/**
+	 * The maximum amount of cached media if it's not configured.
+	 */
+	public static final int DEFAULT_CAPACITY = 10000;
+
+	/**
+	 * The time-to-live of a cached media in seconds if it's not configured.
+	 */
+	public static final int DEFAULT_TTL = 60;
+
+	private final Logger logger = LoggerFactory.getLogger(MediaCache.class);
+
+	private final LinkedHashMap<UUID, Entry> entries;
+
+	private final long ttlNanos;
+
+	private final LongSupplier nanoClock;
+
+	private final LongAdder hits = new LongAdder();
+
+	private final LongAdder misses = new LongAdder();
+
+	private long generation = 0;
+
+	private record Entry(Media media, long expiresAt) { }
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param capacity the maximum amount of cached media; must be positive
+	 * @param ttlSeconds the time-to-live of a cached media in seconds; must be positive
+	 */
+	public MediaCache(int capacity, int ttlSeconds) {
+		this(capacity, ttlSeconds, System::nanoTime);
+	}
+
+	/**
+	 * Constructs an instance of this class that measures time with the specified clock.
+	 * @param capacity the maximum amount of cached media; must be positive
+	 * @param ttlSeconds the time-to-live of a cached media in seconds; must be positive
+	 * @param nanoClock the source of the current time in nanoseconds, e.g. {@link System#nanoTime()}
+	 */
+	public MediaCache(int capacity, int ttlSeconds, @Nonnull LongSupplier nanoClock) {
+		if (capacity <= 0) throw new IllegalArgumentException("The capacity must be positive");
+		if (ttlSeconds <= 0) throw new IllegalArgumentException("The time-to-live must be positive");
+		this.ttlNanos = ttlSeconds * 1_000_000_000L;
+		this.nanoClock = nanoClock;
+		entries = new LinkedHashMap<>(16, 0.75f, true) {
+			@Override
+			protected boolean removeEldestEntry(Map.Entry<UUID, Entry> eldest) {
+				return size() > capacity;
+			}
+		};
+
+		logger.debug("{} instantiated, capacity: {}, ttlSeconds: {}", this, capacity, ttlSeconds);
+	}
+
+	/**
+	 * Returns the cached media associated with the specified id, or null if the media isn't cached or has expired.
+	 * @param mediaId the media id
+	 * @return the cached {@link Media} instance or null
+	 */
+	@Nullable
+	public Media get(@Nonnull UUID mediaId) {
+		synchronized (entries) {
+			Entry entry = entries.get(mediaId);
+			if (entry != null && entry.expiresAt() - nanoClock.getAsLong() > 0) {
+				hits.increment();
+				return entry.media();
+			}
+			if (entry != null) entries.remove(mediaId);
+		}
+		misses.increment();
+		return null;
+	}
+
+	/**
+	 * Returns the current generation of the cache. The generation changes every time the cache is invalidated; it must
+	 * be obtained before the media is loaded from the storage and then passed to {@link #put(Media, long)}.
+	 * @return the current generation
+	 */
+	public long getGeneration() {
+		synchronized (entries) {
+			return generation;
+		}
+	}
+
+	/**
+	 * Caches the media, replacing the media previously cached under the same id. If the cache has been invalidated
+	 * since the generation was obtained, the media may be outdated and isn't cached.
+	 * @param media the media
+	 * @param generation the generation obtained with {@link #getGeneration()} before the media was loaded
+	 */
+	public void put(@Nonnull Media media, long generation) {
+		Entry entry = new Entry(media, nanoClock.getAsLong() + ttlNanos);
+		synchronized (entries) {
+			if (this.generation == generation) entries.put(media.getID(), entry);
+		}
+	}
+
+	/**
+	 * Removes the media associated with the specified id from the cache.
+	 * @param mediaId the media id
+	 */
+	public void invalidate(@Nonnull UUID mediaId) {
+		synchronized (entries) {
+			generation++;
+			entries.remove(mediaId);
+		}
+	}
+
+	/**
+	 * Removes every media from the cache.
+	 */
+	public void invalidateAll() {
+		synchronized (entries) {
+			generation++;
+			entries.clear();
+		}
+	}
+
+	/**
+	 * Invalidates the changed media.
+	 * @param mediaId the media id
+	 */
+	@Override
+	public void mediaChanged(@Nonnull UUID mediaId) {
+		invalidate(mediaId);
+	}
+
+	/**
+	 * Invalidates every media.
+	 */
+	@Override
+	public void allMediaChanged() {
+		invalidateAll();
+	}
+
+	/**
+	 * Returns the amount of lookups that were served from the cache.
+	 * @return the amount of hits
+	 */
+	public long getHits() {
+		return hits.sum();
+	}
+
+	/**
+	 * Returns the amount of lookups that weren't served from the cache.
+	 * @return the amount of misses
+	 */
+	public long getMisses() {
+		return misses.sum();
+	}
+}
@@ -0,0 +1,42 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import jakarta.annotation.Nonnull;
+
+import java.util.UUID;
+
+/**
+ * MediaChangeObserver is notified when the media in the storage facilities change, so it can drop or reload its
+ * in-memory copies of them.
+ */
+public interface MediaChangeObserver {
+
+	/**
+	 * Notifies the observer that the media associated with the specified id has been added, modified, or removed.
+	 * @param mediaId the media id
+	 */
+	void mediaChanged(@Nonnull UUID mediaId);
+
+	/**
+	 * Notifies the observer that any media may have changed, e.g. because the changes couldn't be tracked for a while.
+	 */
+	void allMediaChanged();
+}
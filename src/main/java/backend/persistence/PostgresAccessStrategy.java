@@ -19,33 +19,63 @@
 
 package backend.persistence;
 
-import backend.models.DefaultSqlRow;
+import backend.models.IndexedSqlRow;
 import backend.models.SqlRow;
 import jakarta.annotation.Nonnull;
 import jakarta.annotation.Nullable;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 import org.springframework.jdbc.core.JdbcTemplate;
+import org.springframework.jdbc.core.RowMapper;
 import org.springframework.transaction.annotation.Isolation;
+import org.springframework.transaction.annotation.Propagation;
 import org.springframework.transaction.annotation.Transactional;
 
 import java.sql.SQLException;
-import java.util.ArrayList;
-import java.util.Objects;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
 import java.util.stream.Stream;
 
 /**
  * PostgresAccessStrategy implements its functionality by relying on PostgreSQL; no other services are required.
  * The full text search is provided by Postgres with the syntax of the search query described
- * <a href="https://www.postgresql.org/docs/current/textsearch-controls.html#TEXTSEARCH-PARSING-QUERIES">here</a>.
+ * <a href="https://www.postgresql.org/docs/current/textsearch-controls.html#TEXTSEARCH-PARSING-QUERIES">here</a>.<br>
+ * Every method executes a single statement, which sees a consistent snapshot of the database on any isolation level,
+ * so the reads don't pay for the predicate locks and the serialization failures of the serializable isolation level.
+ * The point reads run in the auto-commit mode without a transaction, and the other reads run in a read-only
+ * transaction on the read committed isolation level. The serializable isolation level of the class is the default
+ * for the methods that don't declare their own isolation, e.g. the methods that modify the database.<br>
+ * The SQL text of every statement is composed once per set of columns and reused, so the text stays identical
+ * between the calls and the JDBC driver can reuse the server-side prepared statement instead of parsing and planning
+ * the statement again. The search query is parsed with websearch_to_tsquery once per statement in the FROM clause.<br>
+ * The methods that return a {@link Stream} read the result lazily, {@link #FETCH_SIZE} rows at a time, through
+ * a database cursor. Such a stream holds the connection until it's closed, so the caller must consume and close it
+ * within a transaction that encloses the call; the cursor doesn't outlive the transaction.
  */
 @Transactional(readOnly = true, isolation = Isolation.SERIALIZABLE)
 public class PostgresAccessStrategy implements SqlAccessStrategy {
 
 	private final Logger logger = LoggerFactory.getLogger(PostgresAccessStrategy.class);
 
+	/**
+	 * The amount of rows fetched from the database at once when the result is streamed.
+	 */
+	public static final int FETCH_SIZE = 256;
+
+	private final Map<StatementKey, String> statements = new ConcurrentHashMap<>();
+
 	private JdbcTemplate jdbcTemplate;
 
+	private volatile Boolean trigramsAvailable = null;
+
+	private enum Statement {
+		ALL, BY_ID, SEARCH, BLANK_PAGE, BLANK_PAGE_AFTER, SEARCH_PAGE, SEARCH_PAGE_AFTER, PREFIX, PREFIX_POSITION
+	}
+
+	private record StatementKey(Statement statement, List<String> columnsNames) { }
+
 	/**
 	 * Creates an instance of this class.
 	 * @param jdbcTemplate the {@link JdbcTemplate} instance connected to a database containing the 'media' table
@@ -58,100 +88,126 @@ public class PostgresAccessStrategy implements SqlAccessStrategy {
 
 	@Nonnull
 	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
 	public Stream<SqlRow> query(@Nonnull String[] columnsNames) {
 		assert columnsNames.length > 0;
 
-		StringBuilder sqlQuery = new StringBuilder("SELECT ");
-		for (int i = 0; i < columnsNames.length; i++) {
-			sqlQuery.append(columnsNames[i]);
-			if (i != columnsNames.length - 1)  sqlQuery.append(", ");
-		}
-		sqlQuery.append(" FROM media;");
-
+		String sqlQuery = sqlText(Statement.ALL, columnsNames);
 		logger.info("{} executing {}", this, sqlQuery);
 
-		return Objects.requireNonNullElse(
-			jdbcTemplate.query(sqlQuery.toString(), rs-> {
-				ArrayList<SqlRow> result = new ArrayList<>();
-				while (rs.next()) {
-					DefaultSqlRow sqlRow = new DefaultSqlRow();
-					for (String column: columnsNames) {
-						sqlRow.putObject(column, rs.getObject(column));
-					}
-					result.add(sqlRow);
-				}
-				return result.stream();
-			}),
-			Stream.empty()
+		return jdbcTemplate.queryForStream(
+			sqlQuery,
+			preparedStatement -> preparedStatement.setFetchSize(FETCH_SIZE),
+			rowMapper(IndexedSqlRow.indexColumns(columnsNames))
 		);
 	}
 
 	@Nullable
 	@Override
+	@Transactional(propagation = Propagation.SUPPORTS)
 	public SqlRow query(@Nonnull String primaryKey, @Nonnull String[] columnsNames) throws SQLException {
 		assert columnsNames.length > 0;
 
-		StringBuilder sqlQuery = new StringBuilder("SELECT ");
-		for (int i = 0; i < columnsNames.length; i++) {
-			sqlQuery.append(columnsNames[i]);
-			if (i != columnsNames.length - 1) sqlQuery.append(", ");
-		}
-		sqlQuery.append(" FROM media WHERE id=?;");
-
+		Map<String, Integer> columnsIndexes = IndexedSqlRow.indexColumns(columnsNames);
 		return jdbcTemplate.query(
-			sqlQuery.toString(),
+			sqlText(Statement.BY_ID, columnsNames),
 			preparedStatement-> {
 				preparedStatement.setString(1, primaryKey);
 				logger.info("{} executing {}", this, preparedStatement);
 			},
-			rs -> {
-				if (!rs.next()) return null;
-				DefaultSqlRow sqlRow = new DefaultSqlRow();
-				for (String columnName: columnsNames) {
-					sqlRow.putObject(columnName, rs.getObject(columnName));
-				}
-				return sqlRow;
-			}
+			rs -> rs.next() ? rowMapper(columnsIndexes).mapRow(rs, 0) : null
 		);
 	}
 
 	@Nonnull
 	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
 	public Stream<SqlRow> searchInTitle(@Nonnull String searchQuery, @Nonnull String[] columnsNames) {
 		assert columnsNames.length > 0;
 
-		StringBuilder sqlQuery = new StringBuilder("""
-			WITH w (search_query, search_query_size) AS \
-			(SELECT temp, numnode(temp) FROM (SELECT websearch_to_tsquery('english', ?) AS temp)) \
-			SELECT""").append(" ");
-		for (int i = 0; i < columnsNames.length; i++) {
-			sqlQuery.append(columnsNames[i]);
-			if (i != columnsNames.length - 1) sqlQuery.append(", ");
+		return jdbcTemplate.queryForStream(
+			sqlText(Statement.SEARCH, columnsNames),
+			preparedStatement -> {
+				preparedStatement.setFetchSize(FETCH_SIZE);
+				preparedStatement.setString(1, searchQuery);
+				logger.info("{} executing {}", this, preparedStatement);
+			},
+			rowMapper(IndexedSqlRow.indexColumns(columnsNames))
+		);
+	}
+
+	@Nonnull
+	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
+	public Stream<SqlRow> searchInTitle(
+		@Nonnull String searchQuery,
+		int limit,
+		@Nullable Float lastRank,
+		@Nullable String lastId,
+		@Nonnull String[] columnsNames
+	) {
+		assert columnsNames.length > 0;
+		if (limit <= 0) throw new IllegalArgumentException("The limit must be positive");
+		if ((lastRank == null) != (lastId == null)) {
+			throw new IllegalArgumentException("The last rank and the last id must be specified together");
 		}
-		sqlQuery.append("""
-			 FROM media WHERE \
-			((SELECT search_query FROM w) @@ title_tsvector) OR ((SELECT search_query_size FROM w) = 0);""");
-
-		return Objects.requireNonNullElse(
-			jdbcTemplate.query(
-				sqlQuery.toString(),
-				preparedStatement -> {
-					preparedStatement.setString(1, searchQuery);
-					logger.info("{} executing {}", this, preparedStatement);
-				},
-				rs -> {
-					ArrayList<SqlRow> result = new ArrayList<>();
-					while (rs.next()) {
-						DefaultSqlRow sqlRow = new DefaultSqlRow();
-						for (String column: columnsNames) {
-							sqlRow.putObject(column, rs.getObject(column));
-						}
-						result.add(sqlRow);
+
+		// Every title matches a blank query with the same rank, so the rows are ordered by the primary key only,
+		// and the primary key index serves the page without ranking the whole table. A non-blank query is ranked by
+		// ts_rank, which no index provides, so every match is ranked and sorted before the limit is applied; the keyset
+		// only spares the transfer of the previous pages, and deep pages of a common query still cost a full sort
+		boolean blankQuery = searchQuery.isBlank();
+		Statement statement;
+		if (blankQuery) statement = lastId == null ? Statement.BLANK_PAGE : Statement.BLANK_PAGE_AFTER;
+		else statement = lastId == null ? Statement.SEARCH_PAGE : Statement.SEARCH_PAGE_AFTER;
+
+		String[] resultColumnsNames = Arrays.copyOf(columnsNames, columnsNames.length + 1);
+		resultColumnsNames[columnsNames.length] = SEARCH_RANK_COLUMN;
+		return jdbcTemplate.queryForStream(
+			sqlText(statement, columnsNames),
+			preparedStatement -> {
+				preparedStatement.setFetchSize(Math.min(limit, FETCH_SIZE));
+				int parameterIndex = 1;
+				if (!blankQuery) preparedStatement.setString(parameterIndex++, searchQuery);
+				if (lastId != null) {
+					if (!blankQuery) {
+						preparedStatement.setFloat(parameterIndex++, lastRank);
+						preparedStatement.setFloat(parameterIndex++, lastRank);
 					}
-					return result.stream();
+					preparedStatement.setString(parameterIndex++, lastId);
 				}
-			),
-			Stream.empty()
+				preparedStatement.setInt(parameterIndex, limit);
+				logger.info("{} executing {}", this, preparedStatement);
+			},
+			rowMapper(IndexedSqlRow.indexColumns(resultColumnsNames))
+		);
+	}
+
+	/**
+	 * {@inheritDoc}<br>
+	 * The title matches if it contains the prefix regardless of the case; the titles whose words are the most similar
+	 * to the prefix come first. The similarity is computed by the pg_trgm extension, and a trigram GIN index on
+	 * the title column keeps the query fast. Whether the extension is installed is checked on the first call; if it
+	 * isn't, the titles in which the prefix occurs the earliest come first instead, and every query scans the table.
+	 */
+	@Nonnull
+	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
+	public Stream<SqlRow> searchTitlePrefix(@Nonnull String prefix, int limit, @Nonnull String[] columnsNames) {
+		assert columnsNames.length > 0;
+		if (limit <= 0) throw new IllegalArgumentException("The limit must be positive");
+
+		String pattern = "%" + prefix.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_") + "%";
+		return jdbcTemplate.queryForStream(
+			sqlText(trigramsAvailable() ? Statement.PREFIX : Statement.PREFIX_POSITION, columnsNames),
+			preparedStatement -> {
+				preparedStatement.setFetchSize(Math.min(limit, FETCH_SIZE));
+				preparedStatement.setString(1, pattern);
+				preparedStatement.setString(2, prefix);
+				preparedStatement.setInt(3, limit);
+				logger.info("{} executing {}", this, preparedStatement);
+			},
+			rowMapper(IndexedSqlRow.indexColumns(columnsNames))
 		);
 	}
 
@@ -169,5 +225,74 @@ public class PostgresAccessStrategy implements SqlAccessStrategy {
 	 */
 	public void setJdbcTemplate(@Nonnull JdbcTemplate newJdbcTemplate) {
 		jdbcTemplate = newJdbcTemplate;
+		trigramsAvailable = null;
+	}
+
+	// The extension is checked once, so installing it takes effect after a restart
+	private boolean trigramsAvailable() {
+		Boolean available = trigramsAvailable;
+		if (available == null) {
+			available = Boolean.TRUE.equals(
+				jdbcTemplate.queryForObject(
+					"SELECT EXISTS (SELECT 1 FROM pg_extension WHERE extname = 'pg_trgm');", Boolean.class
+				)
+			);
+			if (!available) {
+				logger.warn(
+					"{}: the pg_trgm extension isn't installed, the suggestions aren't ordered by similarity", this
+				);
+			}
+			trigramsAvailable = available;
+		}
+		return available;
+	}
+
+	private static RowMapper<SqlRow> rowMapper(Map<String, Integer> columnsIndexes) {
+		int columnsAmount = columnsIndexes.size();
+		return (rs, rowNumber) -> {
+			Object[] values = new Object[columnsAmount];
+			for (int i = 0; i < columnsAmount; i++) {
+				values[i] = rs.getObject(i + 1);
+			}
+			return new IndexedSqlRow(columnsIndexes, values);
+		};
+	}
+
+	private String sqlText(Statement statement, String[] columnsNames) {
+		return statements.computeIfAbsent(
+			new StatementKey(statement, List.of(columnsNames)), key -> composeSqlText(statement, columnsNames)
+		);
+	}
+
+	private static String composeSqlText(Statement statement, String[] columnsNames) {
+		String columns = String.join(", ", columnsNames);
+		String rank = "CASE WHEN numnode(q) = 0 THEN 0::real ELSE ts_rank(title_tsvector, q) END";
+		String match = "(title_tsvector @@ q OR numnode(q) = 0)";
+		return switch (statement) {
+			case ALL -> "SELECT " + columns + " FROM media;";
+			case BY_ID -> "SELECT " + columns + " FROM media WHERE id=?;";
+			case SEARCH ->
+				"SELECT " + columns + " FROM media, websearch_to_tsquery('english', ?) AS q WHERE " + match + ";";
+			case BLANK_PAGE, BLANK_PAGE_AFTER ->
+				"SELECT " + columns + ", 0::real AS " + SEARCH_RANK_COLUMN + " FROM media" +
+				(statement == Statement.BLANK_PAGE_AFTER ? " WHERE id > ?" : "") +
+				" ORDER BY id LIMIT ?;";
+			case SEARCH_PAGE, SEARCH_PAGE_AFTER ->
+				"SELECT " + columns + ", " + SEARCH_RANK_COLUMN +
+				" FROM media, websearch_to_tsquery('english', ?) AS q, LATERAL (SELECT " + rank + " AS " +
+				SEARCH_RANK_COLUMN + ") AS r WHERE " + match +
+				(
+					statement == Statement.SEARCH_PAGE_AFTER ?
+						" AND (" + SEARCH_RANK_COLUMN + " < ? OR (" + SEARCH_RANK_COLUMN + " = ? AND id > ?))" :
+						""
+				) +
+				" ORDER BY " + SEARCH_RANK_COLUMN + " DESC, id LIMIT ?;";
+			case PREFIX ->
+				"SELECT " + columns + " FROM media WHERE title ILIKE ? ESCAPE '\\' " +
+				"ORDER BY word_similarity(?, title) DESC, id LIMIT ?;";
+			case PREFIX_POSITION ->
+				"SELECT " + columns + " FROM media WHERE title ILIKE ? ESCAPE '\\' " +
+				"ORDER BY strpos(lower(title), lower(?)), id LIMIT ?;";
+		};
 	}
 }
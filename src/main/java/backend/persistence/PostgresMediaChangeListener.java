@@ -0,0 +1,150 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import jakarta.annotation.Nonnull;
+import org.postgresql.PGConnection;
+import org.postgresql.PGNotification;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import javax.sql.DataSource;
+import java.sql.Connection;
+import java.sql.Statement;
+import java.util.Arrays;
+import java.util.UUID;
+
+/**
+ * PostgresMediaChangeListener keeps in-memory copies of media, e.g. a {@link MediaCache}, consistent with the 'media'
+ * table by listening to the notifications Postgres sends on the {@link #CHANNEL} channel and passing them on to
+ * {@link MediaChangeObserver}s. A notification whose payload is a media id reports a change of that media;
+ * a notification with any other payload, e.g. an empty one sent on TRUNCATE, reports that all media may have changed.
+ * The notifications are sent by a trigger on the 'media' table:
+ * <pre>
+ * CREATE FUNCTION notify_media_changed() RETURNS trigger AS $$
+ * BEGIN
+ *     IF TG_LEVEL = 'ROW' THEN
+ *         PERFORM pg_notify('media_changed', CASE WHEN TG_OP = 'INSERT' THEN NEW.id ELSE OLD.id END);
+ *     ELSE
+ *         PERFORM pg_notify('media_changed', '');
+ *     END IF;
+ *     RETURN NULL;
+ * END;
+ * $$ LANGUAGE plpgsql;
+ * CREATE TRIGGER media_changed AFTER INSERT OR UPDATE OR DELETE ON media
+ *     FOR EACH ROW EXECUTE FUNCTION notify_media_changed();
+ * CREATE TRIGGER media_truncated AFTER TRUNCATE ON media
+ *     FOR EACH STATEMENT EXECUTE FUNCTION notify_media_changed();
+ * </pre>
+ * The listener holds a dedicated connection. If the connection is lost, the notifications sent in the meantime are
+ * lost too, so the observers are told that all media may have changed and the listener reconnects.
+ */
+public class PostgresMediaChangeListener implements AutoCloseable {
+
+	/**
+	 * The name of the notification channel.
+	 */
+	public static final String CHANNEL = "media_changed";
+
+	private static final int POLL_TIMEOUT = 1000;
+
+	private static final int RECONNECTION_DELAY = 5000;
+
+	private final Logger logger = LoggerFactory.getLogger(PostgresMediaChangeListener.class);
+
+	private final DataSource dataSource;
+
+	private final MediaChangeObserver[] observers;
+
+	private final Thread listeningThread;
+
+	private volatile boolean closed = false;
+
+	/**
+	 * Constructs an instance of this class and starts listening.
+	 * @param dataSource the {@link DataSource} instance that provides connections to the database containing
+	 *                   the 'media' table
+	 * @param observers the observers to notify, in the order they are notified
+	 */
+	public PostgresMediaChangeListener(@Nonnull DataSource dataSource, @Nonnull MediaChangeObserver... observers) {
+		this.dataSource = dataSource;
+		this.observers = observers.clone();
+		listeningThread = Thread.ofPlatform().daemon().name("media-change-listener").start(this::listen);
+
+		logger.debug(
+			"{} instantiated, DataSource: {}, MediaChangeObservers: {}", this, dataSource, Arrays.toString(observers)
+		);
+	}
+
+	private void listen() {
+		while (!closed) {
+			try (
+				Connection connection = dataSource.getConnection();
+				Statement statement = connection.createStatement()
+			) {
+				statement.execute("LISTEN " + CHANNEL);
+				// The notifications sent before LISTEN took effect weren't received
+				notifyAllMediaChanged();
+				logger.info("{} listening to {}", this, CHANNEL);
+				PGConnection pgConnection = connection.unwrap(PGConnection.class);
+				while (!closed) {
+					PGNotification[] notifications = pgConnection.getNotifications(POLL_TIMEOUT);
+					if (notifications == null) continue;
+					for (PGNotification notification: notifications) {
+						handle(notification.getParameter());
+					}
+				}
+			} catch (Exception e) {
+				if (closed) break;
+				notifyAllMediaChanged();
+				logger.warn("{} lost the connection, reconnecting in {} ms", this, RECONNECTION_DELAY, e);
+				try {
+					Thread.sleep(RECONNECTION_DELAY);
+				} catch (InterruptedException interruptedException) {
+					break;
+				}
+			}
+		}
+	}
+
+	private void handle(String payload) {
+		UUID mediaId;
+		try {
+			mediaId = UUID.fromString(payload);
+		} catch (IllegalArgumentException e) {
+			notifyAllMediaChanged();
+			return;
+		}
+		for (MediaChangeObserver observer: observers) observer.mediaChanged(mediaId);
+	}
+
+	private void notifyAllMediaChanged() {
+		for (MediaChangeObserver observer: observers) observer.allMediaChanged();
+	}
+
+	/**
+	 * Stops listening and releases the connection.
+	 */
+	@Override
+	public void close() {
+		closed = true;
+		listeningThread.interrupt();
+	}
+}
@@ -31,7 +31,9 @@ import org.springframework.dao.ConcurrencyFailureException;
  * Modern databases use the MVCC mechanism as the opposite to explicit locking to provide data consistency when
  * multiple transactions run simultaneously. As an example, in Postgres it's achieved by simply running all transactions
  * on the Serializable isolation level. But this in turn causes transactions to fail more often.
- * TransactionLockFailureAdvising solves this by retrying failed transactions.<br><br>
+ * TransactionLockFailureAdvising solves this by retrying failed transactions. The operations that run on a weaker
+ * isolation level, such as the read-only lookups of {@link PostgresAccessStrategy}, don't fail this way, and for them
+ * the advice only passes the call through.<br><br>
  *
  * For more information on the data consistency see
  * <a href="https://www.postgresql.org/docs/current/applevel-consistency.html">postgresql.org/docs/current/applevel-consistency.html</a>
@@ -27,10 +27,18 @@ import java.sql.SQLException;
 import java.util.stream.Stream;
 
 /**
- * SqlAccessStrategy provides SQL-database-manufacturer-specific functionality.
+ * SqlAccessStrategy provides SQL-database-manufacturer-specific functionality.<br>
+ * The returned streams may read the rows lazily and hold database resources until they are closed, so the callers
+ * must close them, and consume them within a transaction that encloses the call.
  */
 public interface SqlAccessStrategy {
 
+	/**
+	 * The name of the column that {@link #searchInTitle(String, int, Float, String, String[])} adds to every row.
+	 * The column stores how well the row matches the search query; rows that match better have greater values.
+	 */
+	String SEARCH_RANK_COLUMN = "search_rank";
+
 	/**
 	 * Queries the database for values associated with the specified columns.
 	 * @param columnsNames an array of columns' names
@@ -61,4 +69,43 @@ public interface SqlAccessStrategy {
 	 */
 	@Nonnull
 	Stream<SqlRow> searchInTitle(@Nonnull String searchQuery, @Nonnull String[] columnsNames) throws SQLException;
+
+	/**
+	 * Queries the database for at most limit rows whose title value matches the search query. The rows are ordered
+	 * by the {@link #SEARCH_RANK_COLUMN} value descending and then by the primary key ascending, and every row carries
+	 * the {@link #SEARCH_RANK_COLUMN} value in addition to the requested columns. If lastRank and lastId are
+	 * specified, only the rows that follow the row with these values in that order are returned, so the result can be
+	 * paged through without the database skipping over the previous pages. Only the rows are bounded this way,
+	 * not the work: the rank isn't indexed, so the database may still rank and sort every match of a non-blank query
+	 * for every page, and the cost of a page grows with the amount of matches.
+	 * @param searchQuery the search query
+	 * @param limit the maximum amount of rows to return; must be positive
+	 * @param lastRank the {@link #SEARCH_RANK_COLUMN} value of the last row of the previous page, or null
+	 * @param lastId the primary key value of the last row of the previous page, or null
+	 * @param columnsNames an array of columns' names
+	 * @return a stream of {@link SqlRow} instances
+	 * @throws SQLException if querying fails
+	 */
+	@Nonnull
+	Stream<SqlRow> searchInTitle(
+		@Nonnull String searchQuery,
+		int limit,
+		@Nullable Float lastRank,
+		@Nullable String lastId,
+		@Nonnull String[] columnsNames
+	) throws SQLException;
+
+	/**
+	 * Queries the database for at most limit rows whose title value contains the prefix, e.g. the beginning of a word
+	 * the user is still typing. Unlike {@link #searchInTitle(String, String[])}, this method matches partial words;
+	 * the rows are ordered by how well their title matches the prefix.
+	 * @param prefix the prefix
+	 * @param limit the maximum amount of rows to return; must be positive
+	 * @param columnsNames an array of columns' names
+	 * @return a stream of {@link SqlRow} instances
+	 * @throws SQLException if querying fails
+	 */
+	@Nonnull
+	Stream<SqlRow> searchTitlePrefix(@Nonnull String prefix, int limit, @Nonnull String[] columnsNames)
+		throws SQLException;
 }
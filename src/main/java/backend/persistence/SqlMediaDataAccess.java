@@ -25,17 +25,22 @@ import backend.exceptions.QueryingStrategyFactoryException;
 import backend.interactors.MediaDataAccess;
 import backend.models.Media;
 import backend.models.DefaultMedia;
+import backend.models.MediaPage;
 import backend.models.SqlRow;
 import backend.querying.QueryingStrategyFactory;
 import jakarta.annotation.Nonnull;
 import jakarta.annotation.Nullable;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
+import org.springframework.transaction.annotation.Isolation;
+import org.springframework.transaction.annotation.Transactional;
 
 import java.net.URI;
 import java.util.Arrays;
+import java.util.List;
 import java.util.Objects;
 import java.util.UUID;
+import java.util.stream.Stream;
 
 import static java.util.Objects.requireNonNull;
 
@@ -43,16 +48,24 @@ import static java.util.Objects.requireNonNull;
  * SqlMediaDataAccess uses a SQL database as its storage facility without relying on a specific database manufacturer.
  * The SQL syntax may vary from one database manufacturer to another, because of that SqlMediaDataAccess doesn't access
  * a database directly nor construct SQL queries. It only defines an application-specific SQL schema and delegates
- * the reset of the functionality to a {@link SqlAccessStrategy} instance.
+ * the reset of the functionality to a {@link SqlAccessStrategy} instance.<br>
+ * The media returned by the methods that return several media instantiate their querying strategies on the first
+ * retrieval of the content, so listing media doesn't resolve the location of their content. These methods consume
+ * the rows as they are streamed from the database within a single read-only transaction, so only the resulting media,
+ * not the intermediate rows, are held in memory at once.
  */
 public class SqlMediaDataAccess implements MediaDataAccess {
 
+	private static final String[] SCHEMA = new String[] {"id", "title", "duration", "media_content_uri"};
+
 	private final Logger logger = LoggerFactory.getLogger(SqlMediaDataAccess.class);
 
 	private QueryingStrategyFactory queryingStrategyFactory;
 
 	private SqlAccessStrategy sqlAccessStrategy;
 
+	private volatile MediaCache mediaCache = null;
+
 	/**
 	 * Constructs an instance of this class.
 	 * @param queryingStrategyFactory the {@link QueryingStrategyFactory} instance that instantiates a respective
@@ -75,28 +88,11 @@ public class SqlMediaDataAccess implements MediaDataAccess {
 
 	@Nonnull
 	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
 	public Media[] getMedia() throws CommonDataAccessException {
-		try {
-			String[] schema = new String[] {"id", "title", "duration", "media_content_uri"};
-			return sqlAccessStrategy
-				.query(schema)
-				.map(sqlRow -> {
-					try {
-						URI uri = URI.create(requireNonNull(sqlRow.getString("media_content_uri")));
-						return new DefaultMedia(
-							UUID.fromString(requireNonNull(sqlRow.getString("id"))),
-							requireNonNull(sqlRow.getString("title")),
-							requirePositive(sqlRow.getInt("duration")),
-							uri,
-							getQueryingStrategyFactory().getQueryingStrategy(uri)
-						);
-					} catch (NullPointerException | IllegalArgumentException | QueryingStrategyFactoryException e) {
-						logger.error(
-							"{} encountered unexpected value in {} schema", this, Arrays.toString(schema), e
-						);
-						return null;
-					}
-				})
+		try (Stream<SqlRow> rows = sqlAccessStrategy.query(SCHEMA)) {
+			return rows
+				.map(this::toMedia)
 				.filter(Objects::nonNull)
 				.toArray(Media[]::new);
 		} catch (Exception e) {
@@ -107,20 +103,33 @@ public class SqlMediaDataAccess implements MediaDataAccess {
 	@Nullable
 	@Override
 	public Media getMedia(@Nonnull UUID mediaId) throws CommonDataAccessException {
-		String[] schema = new String[] {"id", "title", "duration", "media_content_uri"};
+		MediaCache cache = mediaCache;
+		long cacheGeneration = 0;
+		if (cache != null) {
+			Media cachedMedia = cache.get(mediaId);
+			if (cachedMedia != null) return cachedMedia;
+			cacheGeneration = cache.getGeneration();
+		}
+
 		try {
-			SqlRow row = sqlAccessStrategy.query(mediaId.toString(), schema);
+			SqlRow row = sqlAccessStrategy.query(mediaId.toString(), SCHEMA);
 			if (row == null) return null;
 			URI uri = URI.create(requireNonNull(row.getString("media_content_uri")));
-			return new DefaultMedia(
+			// The strategy is requested to validate the content location, but the media requests it again on every
+			// retrieval, so a cached media doesn't keep a strategy the factory has replaced
+			QueryingStrategyFactory queryingStrategyFactory = getQueryingStrategyFactory();
+			queryingStrategyFactory.getQueryingStrategy(uri);
+			Media media = new DefaultMedia(
 				UUID.fromString(requireNonNull(row.getString("id"))),
 				requireNonNull(row.getString("title")),
 				requirePositive(row.getInt("duration")),
 				uri,
-				getQueryingStrategyFactory().getQueryingStrategy(uri)
+				queryingStrategyFactory
 			);
+			if (cache != null) cache.put(media, cacheGeneration);
+			return media;
 		} catch (NullPointerException | IllegalArgumentException | QueryingStrategyFactoryException e) {
-			logger.error("{} encountered unexpected value in {} schema", this, Arrays.toString(schema), e);
+			logger.error("{} encountered unexpected value in {} schema", this, Arrays.toString(SCHEMA), e);
 			throw new CorruptedDataException(e);
 		} catch (Exception e) {
 			throw new CommonDataAccessException(e);
@@ -129,28 +138,11 @@ public class SqlMediaDataAccess implements MediaDataAccess {
 
 	@Nonnull
 	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
 	public Media[] searchMedia(@Nonnull String searchQuery) throws CommonDataAccessException {
-		try {
-			String[] schema = new String[] {"id", "title", "duration", "media_content_uri"};
-			return sqlAccessStrategy
-				.searchInTitle(searchQuery, schema)
-				.map(sqlRow -> {
-					try {
-						URI uri = URI.create(requireNonNull(sqlRow.getString("media_content_uri")));
-						return new DefaultMedia(
-							UUID.fromString(requireNonNull(sqlRow.getString("id"))),
-							requireNonNull(sqlRow.getString("title")),
-							requirePositive(sqlRow.getInt("duration")),
-							uri,
-							getQueryingStrategyFactory().getQueryingStrategy(uri)
-						);
-					} catch (NullPointerException | IllegalArgumentException | QueryingStrategyFactoryException e) {
-						logger.error(
-							"{} encountered unexpected value in {} schema", this, Arrays.toString(schema), e
-						);
-						return null;
-					}
-				})
+		try (Stream<SqlRow> rows = sqlAccessStrategy.searchInTitle(searchQuery, SCHEMA)) {
+			return rows
+				.map(this::toMedia)
 				.filter(Objects::nonNull)
 				.toArray(Media[]::new);
 		} catch (Exception e) {
@@ -158,6 +150,56 @@ public class SqlMediaDataAccess implements MediaDataAccess {
 		}
 	}
 
+	/**
+	 * {@inheritDoc}<br>
+	 * The cursor consists of the search rank and the id of the last media of the page, so the next page is found by
+	 * the database's keyset comparison rather than by skipping over the previous pages.
+	 */
+	@Nonnull
+	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
+	public MediaPage searchMedia(@Nonnull String searchQuery, int limit, @Nullable String cursor)
+		throws CommonDataAccessException {
+		if (limit <= 0) throw new IllegalArgumentException("The limit must be positive");
+		Float lastRank = null;
+		String lastId = null;
+		if (cursor != null) {
+			int separator = cursor.indexOf(':');
+			if (separator < 0 || separator == cursor.length() - 1) {
+				throw new IllegalArgumentException("Malformed cursor: " + cursor);
+			}
+			try {
+				lastRank = Float.parseFloat(cursor.substring(0, separator));
+			} catch (NumberFormatException e) {
+				throw new IllegalArgumentException("Malformed cursor: " + cursor, e);
+			}
+			if (!Float.isFinite(lastRank)) throw new IllegalArgumentException("Malformed cursor: " + cursor);
+			lastId = cursor.substring(separator + 1);
+		}
+
+		// One more row than the limit is requested to find out whether there is a next page
+		try (
+			Stream<SqlRow> rowsStream =
+				sqlAccessStrategy.searchInTitle(searchQuery, limit + 1, lastRank, lastId, SCHEMA)
+		) {
+			List<SqlRow> rows = rowsStream.toList();
+			String nextCursor = null;
+			if (rows.size() > limit) {
+				SqlRow lastRow = rows.get(limit - 1);
+				nextCursor = lastRow.getFloat(SqlAccessStrategy.SEARCH_RANK_COLUMN) + ":" + lastRow.getString("id");
+			}
+			Media[] media = rows
+				.stream()
+				.limit(limit)
+				.map(this::toMedia)
+				.filter(Objects::nonNull)
+				.toArray(Media[]::new);
+			return new MediaPage(media, nextCursor);
+		} catch (Exception e) {
+			throw new CommonDataAccessException(e);
+		}
+	}
+
 	/**
 	 * Returns the current {@link QueryingStrategyFactory} instance.
 	 * @return the current {@link QueryingStrategyFactory} instance
@@ -174,6 +216,38 @@ public class SqlMediaDataAccess implements MediaDataAccess {
 		return sqlAccessStrategy;
 	}
 
+	@Nonnull
+	@Override
+	@Transactional(readOnly = true, isolation = Isolation.READ_COMMITTED)
+	public Media[] suggestMedia(@Nonnull String prefix, int limit) throws CommonDataAccessException {
+		if (limit <= 0) throw new IllegalArgumentException("The limit must be positive");
+		try (Stream<SqlRow> rows = sqlAccessStrategy.searchTitlePrefix(prefix, limit, SCHEMA)) {
+			return rows
+				.map(this::toMedia)
+				.filter(Objects::nonNull)
+				.toArray(Media[]::new);
+		} catch (Exception e) {
+			throw new CommonDataAccessException(e);
+		}
+	}
+
+	/**
+	 * Returns the {@link MediaCache} instance that serves {@link #getMedia(UUID)}, or null if the media aren't cached.
+	 * @return the current {@link MediaCache} instance or null
+	 */
+	@Nullable
+	public MediaCache getMediaCache() {
+		return mediaCache;
+	}
+
+	/**
+	 * Sets a new {@link MediaCache} instance that serves {@link #getMedia(UUID)}; null disables caching.
+	 * @param newMediaCache a new {@link MediaCache} instance or null
+	 */
+	public void setMediaCache(@Nullable MediaCache newMediaCache) {
+		mediaCache = newMediaCache;
+	}
+
 	/**
 	 * Sets a new {@link QueryingStrategyFactory} instance.
 	 * @param newQueryingStrategyFactory a new {@link QueryingStrategyFactory} instance
@@ -190,6 +264,24 @@ public class SqlMediaDataAccess implements MediaDataAccess {
 		sqlAccessStrategy = newSqlAccessStrategy;
 	}
 
+	// Maps a row of the listing methods to a media that instantiates its querying strategy lazily, or returns null if
+	// the row holds an unexpected value, so a single corrupted row doesn't fail the whole listing
+	private Media toMedia(SqlRow sqlRow) {
+		try {
+			URI uri = URI.create(requireNonNull(sqlRow.getString("media_content_uri")));
+			return new DefaultMedia(
+				UUID.fromString(requireNonNull(sqlRow.getString("id"))),
+				requireNonNull(sqlRow.getString("title")),
+				requirePositive(sqlRow.getInt("duration")),
+				uri,
+				getQueryingStrategyFactory()
+			);
+		} catch (NullPointerException | IllegalArgumentException e) {
+			logger.error("{} encountered unexpected value in {} schema", this, Arrays.toString(SCHEMA), e);
+			return null;
+		}
+	}
+
 	private int requirePositive(int i) {
 		if (i <= 0) throw new IllegalArgumentException();
 		return i;
@@ -0,0 +1,178 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import backend.adapters.ArraySeekableByteChannel;
+import backend.exceptions.QueryingException;
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.net.URI;
+import java.nio.ByteBuffer;
+import java.nio.channels.SeekableByteChannel;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * CachingQueryingStrategy serves the resources of another {@link QueryingStrategyInterface} from a {@link ClipCache}.
+ * A resource that isn't cached is queried from the underlying strategy and, if the cache's admission policy would let
+ * it in, read into memory and put into the cache; the returned channel then reads the in-memory copy. A resource
+ * the cache rejects, e.g. a cold one or one larger than the cache admits, is returned as the underlying strategy
+ * returns it, without copying it. The resources missing from the cache in a single batch query are queried from
+ * the underlying strategy with a single batch query as well.<br>
+ * Every instance caches its resources under a generation of its own, so the resources cached by a previous strategy
+ * of the same URI aren't served. The environment variables are those of the underlying strategy, and closing this
+ * strategy closes the underlying one and invalidates its resources in the cache.
+ */
+public class CachingQueryingStrategy implements QueryingStrategyInterface {
+
+	private final Logger logger = LoggerFactory.getLogger(CachingQueryingStrategy.class);
+
+	private final QueryingStrategyInterface queryingStrategy;
+
+	private final URI contentUri;
+
+	private final ClipCache clipCache;
+
+	private final long generation = ClipCache.newGeneration();
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param queryingStrategy the underlying strategy
+	 * @param contentUri the URI the underlying strategy was instantiated for, which identifies its resources in
+	 *                   the cache
+	 * @param clipCache the {@link ClipCache} instance
+	 */
+	public CachingQueryingStrategy(
+		@Nonnull QueryingStrategyInterface queryingStrategy, @Nonnull URI contentUri, @Nonnull ClipCache clipCache
+	) {
+		this.queryingStrategy = queryingStrategy;
+		this.contentUri = contentUri;
+		this.clipCache = clipCache;
+
+		logger.debug(
+			"{} instantiated, QueryingStrategyInterface: {}, URI: {}, ClipCache: {}, generation: {}",
+			this,
+			queryingStrategy,
+			contentUri,
+			clipCache,
+			generation
+		);
+	}
+
+	@Nullable
+	@Override
+	public Object addToEnvironment(@Nonnull String name, Object value) {
+		return queryingStrategy.addToEnvironment(name, value);
+	}
+
+	@Nullable
+	@Override
+	public Object removeFromEnvironment(@Nonnull String key) {
+		return queryingStrategy.removeFromEnvironment(key);
+	}
+
+	@Nonnull
+	@Override
+	public Map<String, Object> getEnvironment() {
+		return queryingStrategy.getEnvironment();
+	}
+
+	@Nonnull
+	@Override
+	public SeekableByteChannel query(@Nonnull String name) throws QueryingException {
+		byte[] content = clipCache.get(new ClipCache.Key(contentUri, generation, name));
+		if (content != null) return new ArraySeekableByteChannel(content);
+		return cache(name, queryingStrategy.query(name));
+	}
+
+	@Nonnull
+	@Override
+	public SeekableByteChannel[] query(@Nonnull String[] names) throws QueryingException {
+		SeekableByteChannel[] channels = new SeekableByteChannel[names.length];
+		List<Integer> missingIndexes = new ArrayList<>();
+		for (int i = 0; i < names.length; i++) {
+			byte[] content = clipCache.get(new ClipCache.Key(contentUri, generation, names[i]));
+			if (content != null) channels[i] = new ArraySeekableByteChannel(content);
+			else missingIndexes.add(i);
+		}
+		if (missingIndexes.isEmpty()) return channels;
+
+		SeekableByteChannel[] missingChannels = queryingStrategy.query(
+			missingIndexes.stream().map(i -> names[i]).toArray(String[]::new)
+		);
+		try {
+			for (int i = 0; i < missingChannels.length; i++) {
+				int index = missingIndexes.get(i);
+				SeekableByteChannel channel = missingChannels[i];
+				missingChannels[i] = null;
+				channels[index] = cache(names[index], channel);
+			}
+		} catch (QueryingException e) {
+			for (SeekableByteChannel channel: missingChannels) {
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+			}
+			for (SeekableByteChannel channel: channels) {
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+			}
+			throw e;
+		}
+		return channels;
+	}
+
+	@Override
+	public void close() throws Exception {
+		clipCache.invalidate(generation);
+		queryingStrategy.close();
+	}
+
+	/**
+	 * Returns the underlying strategy.
+	 * @return the underlying {@link QueryingStrategyInterface} instance
+	 */
+	@Nonnull
+	public QueryingStrategyInterface getQueryingStrategy() {
+		return queryingStrategy;
+	}
+
+	// Takes over the channel: the channel is either returned or closed. The admission is checked before reading the
+	// resource, so the rejected resources aren't copied into memory
+	private SeekableByteChannel cache(String name, SeekableByteChannel channel) throws QueryingException {
+		try {
+			ClipCache.Key key = new ClipCache.Key(contentUri, generation, name);
+			long size = channel.size() - channel.position();
+			if (!clipCache.admits(key, size)) return channel;
+			ByteBuffer content = ByteBuffer.allocate((int) size);
+			while (content.hasRemaining()) {
+				if (channel.read(content) == -1) throw new IOException("Unexpected end of " + name);
+			}
+			channel.close();
+			clipCache.put(key, content.array());
+			return new ArraySeekableByteChannel(content.array());
+		} catch (IOException e) {
+			try { channel.close(); } catch (Exception ignored) { }
+			throw new QueryingException(e);
+		}
+	}
+}
@@ -0,0 +1,290 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.net.URI;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * ClipCache is a thread-safe cache of the contents of clips keyed by the content URI of their media, the generation of
+ * the strategy that read them, and their names. Every strategy instantiated for a URI takes a new generation from
+ * {@link #newGeneration()}, so once a content root changed, e.g. it was packed again, the clips cached by its previous
+ * strategy aren't served anymore; the strategy invalidates its generation when it's closed to free them right away.
+ * The total size of the cached contents is limited by the capacity. The cache evicts the least recently used clips,
+ * but only to admit a clip that has been requested more frequently than each of the clips it would evict (TinyLFU
+ * admission), so a burst of clips requested once, e.g. a single viewer watching an unpopular media, doesn't flush
+ * the clips many viewers are watching. The request frequencies are estimated by a count-min sketch, which halves all
+ * its counters periodically, so the clips that used to be popular lose their advantage.<br>
+ * The cached contents are shared by all the readers and must not be modified. The cache counts hits, misses, and
+ * rejections, the clips that weren't admitted.
+ */
+public class ClipCache {
+
+	/**
+	 * The capacity in bytes if it's not configured.
+	 */
+	public static final long DEFAULT_CAPACITY = 256L * 1024 * 1024;
+
+	/**
+	 * The share of the capacity a single clip may take at most.
+	 */
+	public static final int MAX_CLIP_SHARE = 8;
+
+	private static final int SKETCH_DEPTH = 4;
+
+	private static final int MAX_FREQUENCY = 15;
+
+	private static final int[] SKETCH_SEEDS = {0x9E3779B9, 0x85EBCA6B, 0xC2B2AE35, 0x27D4EB2F};
+
+	private static final AtomicLong generations = new AtomicLong();
+
+	private final Logger logger = LoggerFactory.getLogger(ClipCache.class);
+
+	private final long capacity;
+
+	private final LinkedHashMap<Key, byte[]> clips = new LinkedHashMap<>(16, 0.75f, true);
+
+	private final int[][] sketch;
+
+	private final int sampleSize;
+
+	private final LongAdder hits = new LongAdder();
+
+	private final LongAdder misses = new LongAdder();
+
+	private final LongAdder rejections = new LongAdder();
+
+	private long cachedBytes = 0;
+
+	private int samples = 0;
+
+	/**
+	 * Key identifies a clip.
+	 * @param contentUri the content URI of the media the clip belongs to
+	 * @param generation the generation of the strategy the clip is read by
+	 * @param name the name of the clip
+	 */
+	public record Key(URI contentUri, long generation, String name) { }
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param capacity the maximum total size of the cached clips in bytes; must be positive
+	 */
+	public ClipCache(long capacity) {
+		if (capacity <= 0) throw new IllegalArgumentException("The capacity must be positive");
+		this.capacity = capacity;
+		// The sketch is sized for clips of 16 KiB on average, which overestimates the amount of cached clips
+		int width = Integer.highestOneBit((int) Math.clamp(capacity / (16 * 1024), 1024, 1 << 24));
+		sketch = new int[SKETCH_DEPTH][width];
+		sampleSize = 10 * width;
+
+		logger.debug("{} instantiated, capacity: {}", this, capacity);
+	}
+
+	/**
+	 * Returns the content of the clip, or null if the clip isn't cached. Every call counts as a request of the clip.
+	 * @param key the key of the clip
+	 * @return the content of the clip or null
+	 */
+	@Nullable
+	public byte[] get(@Nonnull Key key) {
+		byte[] content;
+		synchronized (this) {
+			recordRequest(key);
+			content = clips.get(key);
+		}
+		if (content != null) hits.increment();
+		else misses.increment();
+		return content;
+	}
+
+	/**
+	 * Returns a generation that no other strategy has taken.
+	 * @return a new generation
+	 */
+	public static long newGeneration() {
+		return generations.incrementAndGet();
+	}
+
+	/**
+	 * Tells whether the admission policy would currently let the clip in, so the caller reads the clip into memory only
+	 * if it's likely to be cached. A clip that wouldn't be admitted counts as a rejection.
+	 * @param key the key of the clip
+	 * @param size the size of the clip in bytes
+	 * @return true if the clip would be cached, false if it's rejected
+	 */
+	public boolean admits(@Nonnull Key key, long size) {
+		boolean admitted = size <= getMaxClipSize();
+		if (admitted) {
+			synchronized (this) {
+				admitted = clips.containsKey(key) || victimsOf(key, size) != null;
+			}
+		}
+		if (!admitted) rejections.increment();
+		return admitted;
+	}
+
+	/**
+	 * Caches the content of the clip if the admission policy lets it in, evicting the least recently used clips to make
+	 * room for it.
+	 * @param key the key of the clip
+	 * @param content the content of the clip, which must not be modified afterward
+	 * @return true if the clip is cached, false if it's rejected
+	 */
+	public boolean put(@Nonnull Key key, @Nonnull byte[] content) {
+		if (content.length > getMaxClipSize()) {
+			rejections.increment();
+			return false;
+		}
+		synchronized (this) {
+			if (clips.containsKey(key)) return true;
+			List<Key> victims = victimsOf(key, content.length);
+			if (victims == null) {
+				rejections.increment();
+				return false;
+			}
+			for (Key victim: victims) cachedBytes -= clips.remove(victim).length;
+			clips.put(key, content);
+			cachedBytes += content.length;
+			return true;
+		}
+	}
+
+	/**
+	 * Removes the clips of the generation from the cache.
+	 * @param generation the generation of a strategy that was closed
+	 */
+	public synchronized void invalidate(long generation) {
+		Iterator<Map.Entry<Key, byte[]>> iterator = clips.entrySet().iterator();
+		while (iterator.hasNext()) {
+			Map.Entry<Key, byte[]> clip = iterator.next();
+			if (clip.getKey().generation() != generation) continue;
+			cachedBytes -= clip.getValue().length;
+			iterator.remove();
+		}
+	}
+
+	/**
+	 * Returns the size of the largest clip the cache admits.
+	 * @return the maximum clip size in bytes
+	 */
+	public long getMaxClipSize() {
+		return capacity / MAX_CLIP_SHARE;
+	}
+
+	/**
+	 * Returns the total size of the cached clips in bytes.
+	 * @return the amount of cached bytes
+	 */
+	public synchronized long getCachedBytes() {
+		return cachedBytes;
+	}
+
+	/**
+	 * Returns the amount of requests that were served from the cache.
+	 * @return the amount of hits
+	 */
+	public long getHits() {
+		return hits.sum();
+	}
+
+	/**
+	 * Returns the amount of requests that weren't served from the cache.
+	 * @return the amount of misses
+	 */
+	public long getMisses() {
+		return misses.sum();
+	}
+
+	/**
+	 * Returns the share of the requests that were served from the cache, or 0 if there were no requests.
+	 * @return the hit ratio
+	 */
+	public double getHitRatio() {
+		long hitCount = getHits();
+		long requests = hitCount + getMisses();
+		return requests == 0 ? 0 : (double) hitCount / requests;
+	}
+
+	/**
+	 * Returns the amount of clips that weren't admitted into the cache.
+	 * @return the amount of rejections
+	 */
+	public long getRejections() {
+		return rejections.sum();
+	}
+
+	// Must be called while holding the lock; returns the least recently used clips to evict to make room for the clip,
+	// or null if one of them has been requested at least as frequently as the clip
+	private List<Key> victimsOf(Key key, long size) {
+		List<Key> victims = new ArrayList<>();
+		long required = cachedBytes + size - capacity;
+		if (required <= 0) return victims;
+		int candidateFrequency = frequencyOf(key);
+		long freed = 0;
+		Iterator<Map.Entry<Key, byte[]>> iterator = clips.entrySet().iterator();
+		while (freed < required) {
+			Map.Entry<Key, byte[]> victim = iterator.next();
+			if (frequencyOf(victim.getKey()) >= candidateFrequency) return null;
+			victims.add(victim.getKey());
+			freed += victim.getValue().length;
+		}
+		return victims;
+	}
+
+	// Must be called while holding the lock
+	private void recordRequest(Key key) {
+		int hash = key.hashCode();
+		for (int i = 0; i < SKETCH_DEPTH; i++) {
+			int index = indexOf(hash, i);
+			if (sketch[i][index] < MAX_FREQUENCY) sketch[i][index]++;
+		}
+		if (++samples >= sampleSize) {
+			for (int[] row: sketch) {
+				for (int i = 0; i < row.length; i++) row[i] >>= 1;
+			}
+			samples /= 2;
+		}
+	}
+
+	// Must be called while holding the lock
+	private int frequencyOf(Key key) {
+		int hash = key.hashCode();
+		int frequency = MAX_FREQUENCY;
+		for (int i = 0; i < SKETCH_DEPTH; i++) frequency = Math.min(frequency, sketch[i][indexOf(hash, i)]);
+		return frequency;
+	}
+
+	private int indexOf(int hash, int row) {
+		int mixed = (hash ^ (hash >>> 16)) * SKETCH_SEEDS[row];
+		return (mixed ^ (mixed >>> 15)) & (sketch[row].length - 1);
+	}
+}
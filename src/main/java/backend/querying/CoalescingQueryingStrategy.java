@@ -0,0 +1,232 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.adapters.ArraySeekableByteChannel;
+import backend.exceptions.QueryingException;
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.net.URI;
+import java.nio.ByteBuffer;
+import java.nio.channels.SeekableByteChannel;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * CoalescingQueryingStrategy makes the concurrent queries of the same resource of another
+ * {@link QueryingStrategyInterface} share a single query of the underlying strategy and a single in-memory copy of
+ * the resource, with the flights of a {@link ReadCoalescer} usually shared by all the strategies. The returned
+ * channels read the shared copy. The copy is only made if another query has joined the flight by the time
+ * the underlying strategy returns the resource; otherwise the flight is abandoned and the resource is returned as
+ * the underlying strategy returns it. A resource larger than the coalescer shares is returned without a copy as well,
+ * and the queries that joined its flight query it on their own.<br>
+ * If a {@link ClipCache} is specified, the resources are served from it as {@link CachingQueryingStrategy} serves
+ * them, and a copy is also made of the resources the cache admits, so the cache and the concurrent queries share it.
+ * The resources that a batch query leads the flights of are queried from the underlying strategy with a single batch
+ * query. The flights and the cached resources are keyed under a generation of this instance, so a previous strategy
+ * of the same URI doesn't share its resources with it. The environment variables are those of the underlying
+ * strategy, and closing this strategy closes the underlying one and invalidates its resources in the cache.
+ */
+public class CoalescingQueryingStrategy implements QueryingStrategyInterface {
+
+	private final Logger logger = LoggerFactory.getLogger(CoalescingQueryingStrategy.class);
+
+	private final QueryingStrategyInterface queryingStrategy;
+
+	private final URI contentUri;
+
+	private final ReadCoalescer readCoalescer;
+
+	private final ClipCache clipCache;
+
+	private final long generation = ClipCache.newGeneration();
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param queryingStrategy the underlying strategy
+	 * @param contentUri the URI the underlying strategy was instantiated for, which identifies its resources
+	 * @param readCoalescer the {@link ReadCoalescer} instance
+	 * @param clipCache the {@link ClipCache} instance, or null if the resources aren't cached
+	 */
+	public CoalescingQueryingStrategy(
+		@Nonnull QueryingStrategyInterface queryingStrategy,
+		@Nonnull URI contentUri,
+		@Nonnull ReadCoalescer readCoalescer,
+		@Nullable ClipCache clipCache
+	) {
+		this.queryingStrategy = queryingStrategy;
+		this.contentUri = contentUri;
+		this.readCoalescer = readCoalescer;
+		this.clipCache = clipCache;
+
+		logger.debug(
+			"{} instantiated, QueryingStrategyInterface: {}, URI: {}, ReadCoalescer: {}, ClipCache: {}, generation: {}",
+			this,
+			queryingStrategy,
+			contentUri,
+			readCoalescer,
+			clipCache,
+			generation
+		);
+	}
+
+	@Nullable
+	@Override
+	public Object addToEnvironment(@Nonnull String name, Object value) {
+		return queryingStrategy.addToEnvironment(name, value);
+	}
+
+	@Nullable
+	@Override
+	public Object removeFromEnvironment(@Nonnull String key) {
+		return queryingStrategy.removeFromEnvironment(key);
+	}
+
+	@Nonnull
+	@Override
+	public Map<String, Object> getEnvironment() {
+		return queryingStrategy.getEnvironment();
+	}
+
+	@Nonnull
+	@Override
+	public SeekableByteChannel query(@Nonnull String name) throws QueryingException {
+		return query(new String[] {name})[0];
+	}
+
+	@Nonnull
+	@Override
+	public SeekableByteChannel[] query(@Nonnull String[] names) throws QueryingException {
+		SeekableByteChannel[] channels = new SeekableByteChannel[names.length];
+		ClipCache.Key[] keys = new ClipCache.Key[names.length];
+		ReadCoalescer.Flight[] flights = new ReadCoalescer.Flight[names.length];
+		try {
+			List<Integer> leadingIndexes = new ArrayList<>();
+			for (int i = 0; i < names.length; i++) {
+				keys[i] = new ClipCache.Key(contentUri, generation, names[i]);
+				byte[] content = clipCache == null ? null : clipCache.get(keys[i]);
+				if (content != null) {
+					channels[i] = new ArraySeekableByteChannel(content);
+					continue;
+				}
+				flights[i] = readCoalescer.join(keys[i]);
+				if (flights[i].leading()) leadingIndexes.add(i);
+			}
+			lead(names, keys, flights, leadingIndexes, channels);
+
+			List<Integer> missingIndexes = new ArrayList<>();
+			for (int i = 0; i < names.length; i++) {
+				if (flights[i] == null || flights[i].leading()) continue;
+				byte[] payload = readCoalescer.await(flights[i]);
+				if (payload != null) channels[i] = new ArraySeekableByteChannel(payload);
+				else missingIndexes.add(i);
+			}
+			if (!missingIndexes.isEmpty()) {
+				SeekableByteChannel[] missingChannels = queryingStrategy.query(
+					missingIndexes.stream().map(i -> names[i]).toArray(String[]::new)
+				);
+				for (int i = 0; i < missingChannels.length; i++) channels[missingIndexes.get(i)] = missingChannels[i];
+			}
+		} catch (RuntimeException e) {
+			for (SeekableByteChannel channel: channels) {
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+			}
+			throw e;
+		}
+		return channels;
+	}
+
+	@Override
+	public void close() throws Exception {
+		if (clipCache != null) clipCache.invalidate(generation);
+		queryingStrategy.close();
+	}
+
+	/**
+	 * Returns the underlying strategy.
+	 * @return the underlying {@link QueryingStrategyInterface} instance
+	 */
+	@Nonnull
+	public QueryingStrategyInterface getQueryingStrategy() {
+		return queryingStrategy;
+	}
+
+	// Completes every flight led by the batch, even if querying fails, so no other query waits for it forever
+	private void lead(
+		String[] names,
+		ClipCache.Key[] keys,
+		ReadCoalescer.Flight[] flights,
+		List<Integer> leadingIndexes,
+		SeekableByteChannel[] channels
+	) throws QueryingException {
+		if (leadingIndexes.isEmpty()) return;
+		SeekableByteChannel[] leadingChannels = null;
+		try {
+			leadingChannels = queryingStrategy.query(
+				leadingIndexes.stream().map(i -> names[i]).toArray(String[]::new)
+			);
+			for (int i = 0; i < leadingChannels.length; i++) {
+				int index = leadingIndexes.get(i);
+				SeekableByteChannel channel = leadingChannels[i];
+				leadingChannels[i] = null;
+				byte[] payload = read(names[index], keys[index], flights[index], channel);
+				channels[index] = payload == null ? channel : new ArraySeekableByteChannel(payload);
+				readCoalescer.complete(keys[index], flights[index], payload);
+			}
+		} finally {
+			for (int index: leadingIndexes) readCoalescer.complete(keys[index], flights[index], null);
+			if (leadingChannels != null) {
+				for (SeekableByteChannel channel: leadingChannels) {
+					try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+				}
+			}
+		}
+	}
+
+	// Returns the content of the channel and closes it, caching it if the cache admits it, or returns null and leaves
+	// the channel open if it's too large to share or the flight is abandoned because nobody would share it
+	private byte[] read(
+		String name,
+		ClipCache.Key key,
+		ReadCoalescer.Flight flight,
+		SeekableByteChannel channel
+	) throws QueryingException {
+		try {
+			long size = channel.size() - channel.position();
+			if (size > readCoalescer.getMaxPayloadSize()) return null;
+			boolean cached = clipCache != null && clipCache.admits(key, size);
+			if (!cached && readCoalescer.abandon(key, flight)) return null;
+			ByteBuffer content = ByteBuffer.allocate((int) size);
+			while (content.hasRemaining()) {
+				if (channel.read(content) == -1) throw new IOException("Unexpected end of " + name);
+			}
+			channel.close();
+			if (cached) clipCache.put(key, content.array());
+			return content.array();
+		} catch (IOException e) {
+			try { channel.close(); } catch (Exception ignored) { }
+			throw new QueryingException(e);
+		}
+	}
+}
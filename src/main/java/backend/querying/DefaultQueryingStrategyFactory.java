@@ -21,38 +21,311 @@ package backend.querying;
 
 import backend.exceptions.QueryingStrategyFactoryException;
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import java.io.IOException;
 import java.net.URI;
 import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
 import java.nio.file.Path;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.nio.file.attribute.FileTime;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Objects;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.LongAdder;
 
 /**
- * This class supports the following URI naming schemas: file. If none of the supported schemas works for the URI
- * it falls back to instantiating a {@link Path} instance using the URI's string representation, if it fails or the
- * resulted {@link Path} is not an existing directory, {@link QueryingStrategyInterface} is thrown. If the resulted
- * {@link Path} instance is an existing directory, an instance of {@link FSQueryingStrategy} is returned.
+ * This class supports the following URI naming schemas: file, s3, http, https. An http(s) URI is served by
+ * an instance of {@link HttpQueryingStrategy} that fetches the resources under the URI from the origin with the
+ * {@link HttpOriginClient} set for this factory; if it's not set, http(s) URIs aren't supported. An s3 URI,
+ * s3://bucket/prefix, is served by an instance of {@link S3QueryingStrategy} that reads the objects under the prefix
+ * with the {@link S3Client} set for this factory; if it's not set, s3 URIs aren't supported.<br>
+ * If none of the supported schemas works for the URI it falls back to instantiating a {@link Path} instance using
+ * the URI's string representation, if it fails or the resulted {@link Path} is not an existing directory,
+ * {@link QueryingStrategyInterface} is thrown. If the resulted
+ * {@link Path} instance is an existing directory, an instance of {@link FSQueryingStrategy} is returned, unless
+ * the directory contains a {@link PackedQueryingStrategy#PACK_FILE_NAME} file, in which case an instance of
+ * {@link PackedQueryingStrategy} that reads that file is returned. If a {@link MappedRegionCache} is set, an instance
+ * of {@link MmapQueryingStrategy} that maps either the files of the directory or the pack file is returned instead.
+ * If the amount of read ahead clips is positive, the strategies of the directories located under one of the read
+ * ahead roots, or of all the directories if there are no read ahead roots, are wrapped into
+ * {@link ReadAheadQueryingStrategy} instances, unless the resources are mapped: the warming reads would count as
+ * requests towards the map threshold of the {@link MappedRegionCache} and make a clip watched by a single viewer look
+ * hot, and the reads of a mapped clip would only copy the memory. If a {@link ClipCache} is set, the strategies are
+ * wrapped into {@link CachingQueryingStrategy} instances that share the cache. If a {@link ReadCoalescer} is set,
+ * the strategies are wrapped into {@link CoalescingQueryingStrategy} instances that share the coalescer and, if it's
+ * set, the cache instead.<br>
+ * The instantiated strategies are cached per URI, so the content root is checked on the file system only once per
+ * strategy. A cached strategy of a directory is revalidated when it's requested, at most once per
+ * {@link #getRevalidationInterval()} seconds, by reading the attributes of the directory and of its pack file: if
+ * the directory was modified, e.g. its clips were removed after packing, or the pack file was replaced or modified,
+ * the strategy is evicted and instantiated again. At most
+ * {@link #getCapacity()} strategies are cached; when the capacity is exceeded, the least recently requested strategy
+ * is evicted and closed. Since the strategies are shared and may be closed once evicted, the callers must neither
+ * close nor keep them, but request the strategy of a URI whenever they query it.
+ * A strategy is instantiated outside the cache's lock, and the concurrent requests for the same URI wait for a single
+ * instantiation. The failed instantiations aren't cached.
  */
 public class DefaultQueryingStrategyFactory implements QueryingStrategyFactory {
 
+	/**
+	 * The default maximum amount of cached strategies.
+	 */
+	public static final int DEFAULT_CAPACITY = 1024;
+
+	/**
+	 * The default amount of seconds a cached strategy of a directory is served without revalidating it.
+	 */
+	public static final int DEFAULT_REVALIDATION_INTERVAL = 1;
+
 	private final Logger logger = LoggerFactory.getLogger(DefaultQueryingStrategyFactory.class);
 
+	// Access-ordered, so the least recently requested strategy is evicted first; guarded by itself
+	private final LinkedHashMap<URI, CachedStrategy> strategies = new LinkedHashMap<>(16, 0.75f, true);
+
+	private volatile int capacity;
+
+	private volatile int revalidationInterval = DEFAULT_REVALIDATION_INTERVAL;
+
+	private volatile MappedRegionCache mappedRegionCache = null;
+
+	private volatile ClipCache clipCache = null;
+
+	private volatile ReadCoalescer readCoalescer = null;
+
+	private volatile S3Client s3Client = null;
+
+	private volatile HttpOriginClient httpOriginClient = null;
+
+	private volatile int openParallelism = FSQueryingStrategy.DEFAULT_OPEN_PARALLELISM;
+
+	private volatile int readAheadClips = 0;
+
+	private volatile List<Path> readAheadRoots = List.of();
+
+	private final LongAdder warmedBytes = new LongAdder();
+
+	/**
+	 * Layout holds the attributes of a directory and of its pack file that a strategy of the directory was
+	 * instantiated with.
+	 * @param directoryModified the last modification time of the directory
+	 * @param packFileKey the key of the pack file, or null if the directory doesn't contain it
+	 * @param packFileModified the last modification time of the pack file, or null if the directory doesn't contain it
+	 */
+	private record Layout(FileTime directoryModified, Object packFileKey, FileTime packFileModified) { }
+
+	/**
+	 * CachedStrategy is a strategy that is either instantiated or being instantiated.
+	 * @param future the future completed with the strategy
+	 * @param layout the layout of the directory the strategy was last validated against, or null if the URI doesn't
+	 *               locate a directory
+	 * @param validated the {@link System#nanoTime()} of the last validation
+	 */
+	private record CachedStrategy(
+		CompletableFuture<QueryingStrategyInterface> future, Layout layout, long validated
+	) { }
+
+	/**
+	 * Constructs an instance of this class that caches at most {@link #DEFAULT_CAPACITY} strategies.
+	 */
 	public DefaultQueryingStrategyFactory() {
-		logger.debug("{} instantiated", this);
+		this(DEFAULT_CAPACITY);
+	}
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param capacity the maximum amount of cached strategies; must be positive
+	 */
+	public DefaultQueryingStrategyFactory(int capacity) {
+		if (capacity < 1) throw new IllegalArgumentException("The capacity must be positive");
+		this.capacity = capacity;
+
+		logger.debug("{} instantiated, capacity: {}", this, capacity);
 	}
 
 	@Nonnull
 	@Override
 	public QueryingStrategyInterface getQueryingStrategy(@Nonnull URI uri) throws QueryingStrategyFactoryException {
+		URI normalizedUri = uri.normalize();
+		CompletableFuture<QueryingStrategyInterface> future = null, newFuture = null;
+		synchronized (strategies) {
+			CachedStrategy cachedStrategy = strategies.get(normalizedUri);
+			if (cachedStrategy != null && !isDue(cachedStrategy)) future = cachedStrategy.future();
+		}
+		if (future == null) {
+			// The attributes are read outside the lock, so a slow file system doesn't block the other URIs
+			Layout layout = layoutOf(normalizedUri);
+			long validated = System.nanoTime();
+			List<CompletableFuture<QueryingStrategyInterface>> evicted = new ArrayList<>();
+			synchronized (strategies) {
+				CachedStrategy cachedStrategy = strategies.get(normalizedUri);
+				if (cachedStrategy != null && !Objects.equals(cachedStrategy.layout(), layout)) {
+					strategies.remove(normalizedUri);
+					evicted.add(cachedStrategy.future());
+					cachedStrategy = null;
+				}
+				if (cachedStrategy == null) {
+					future = newFuture = new CompletableFuture<>();
+					strategies.put(normalizedUri, new CachedStrategy(newFuture, layout, validated));
+					evicted.addAll(evictExcess());
+				} else {
+					future = cachedStrategy.future();
+					strategies.put(normalizedUri, new CachedStrategy(future, layout, validated));
+				}
+			}
+			evicted.forEach(this::closeWhenInstantiated);
+		}
+
+		if (newFuture != null) {
+			try {
+				newFuture.complete(decorate(instantiate(normalizedUri), normalizedUri));
+			} catch (RuntimeException e) {
+				synchronized (strategies) {
+					CachedStrategy cachedStrategy = strategies.get(normalizedUri);
+					if (cachedStrategy != null && cachedStrategy.future() == newFuture) {
+						strategies.remove(normalizedUri);
+					}
+				}
+				newFuture.completeExceptionally(e);
+				throw e;
+			}
+		}
+		try {
+			return future.join();
+		} catch (CompletionException e) {
+			throw new QueryingStrategyFactoryException(
+				"Encountered an exception while instantiating querying strategy for " + normalizedUri, e.getCause()
+			);
+		}
+	}
+
+	private QueryingStrategyInterface decorate(QueryingStrategyInterface queryingStrategy, URI uri) {
+		ClipCache cache = clipCache;
+		ReadCoalescer coalescer = readCoalescer;
+		if (coalescer != null) return new CoalescingQueryingStrategy(queryingStrategy, uri, coalescer, cache);
+		if (cache != null) return new CachingQueryingStrategy(queryingStrategy, uri, cache);
+		return queryingStrategy;
+	}
+
+	private boolean isDue(CachedStrategy cachedStrategy) {
+		return System.nanoTime() - cachedStrategy.validated() >= TimeUnit.SECONDS.toNanos(revalidationInterval);
+	}
+
+	// Must be called while holding the lock of the strategies
+	private List<CompletableFuture<QueryingStrategyInterface>> evictExcess() {
+		List<CompletableFuture<QueryingStrategyInterface>> evicted = new ArrayList<>();
+		Iterator<Map.Entry<URI, CachedStrategy>> iterator = strategies.entrySet().iterator();
+		while (strategies.size() > capacity && iterator.hasNext()) {
+			evicted.add(iterator.next().getValue().future());
+			iterator.remove();
+		}
+		return evicted;
+	}
+
+	// The strategy may still be instantiated by another thread, so it's closed once it's instantiated
+	private void closeWhenInstantiated(CompletableFuture<QueryingStrategyInterface> future) {
+		future.thenAccept(queryingStrategy -> {
+			try {
+				queryingStrategy.close();
+				logger.debug("{} evicted and closed {}", this, queryingStrategy);
+			} catch (Exception e) {
+				logger.warn("{} couldn't close evicted {}", this, queryingStrategy, e);
+			}
+		});
+	}
+
+	/**
+	 * Returns the maximum amount of cached strategies.
+	 * @return the current capacity
+	 */
+	public int getCapacity() {
+		return capacity;
+	}
+
+	/**
+	 * Sets a new maximum amount of cached strategies. If the cache holds more strategies, the least recently requested
+	 * ones are evicted and closed.
+	 * @param newCapacity a new capacity; must be positive
+	 */
+	public void setCapacity(int newCapacity) {
+		if (newCapacity < 1) throw new IllegalArgumentException("The capacity must be positive");
+		List<CompletableFuture<QueryingStrategyInterface>> evicted;
+		synchronized (strategies) {
+			capacity = newCapacity;
+			evicted = evictExcess();
+		}
+		evicted.forEach(this::closeWhenInstantiated);
+	}
+
+	/**
+	 * Returns the amount of seconds a cached strategy of a directory is served without revalidating it.
+	 * @return the current revalidation interval
+	 */
+	public int getRevalidationInterval() {
+		return revalidationInterval;
+	}
+
+	/**
+	 * Sets a new amount of seconds a cached strategy of a directory is served without revalidating it; 0 makes every
+	 * request revalidate it.
+	 * @param newRevalidationInterval a new revalidation interval; must not be negative
+	 */
+	public void setRevalidationInterval(int newRevalidationInterval) {
+		if (newRevalidationInterval < 0) throw new IllegalArgumentException("The revalidation interval is negative");
+		revalidationInterval = newRevalidationInterval;
+	}
+
+	// Returns the layout of the directory the URI locates, or null if the URI doesn't locate an existing directory
+	private static Layout layoutOf(URI uri) {
+		String scheme = uri.getScheme();
+		if ("s3".equals(scheme) || "http".equals(scheme) || "https".equals(scheme)) return null;
+		try {
+			Path directory = "file".equals(scheme) ? Path.of(uri.getPath()) : Path.of(uri.toString());
+			BasicFileAttributes directoryAttributes = Files.readAttributes(directory, BasicFileAttributes.class);
+			if (!directoryAttributes.isDirectory()) return null;
+			try {
+				BasicFileAttributes packFileAttributes = Files.readAttributes(
+					directory.resolve(PackedQueryingStrategy.PACK_FILE_NAME), BasicFileAttributes.class
+				);
+				return new Layout(
+					directoryAttributes.lastModifiedTime(),
+					packFileAttributes.fileKey(),
+					packFileAttributes.lastModifiedTime()
+				);
+			} catch (NoSuchFileException e) {
+				return new Layout(directoryAttributes.lastModifiedTime(), null, null);
+			}
+		} catch (IOException | RuntimeException e) {
+			return null;
+		}
+	}
+
+	private QueryingStrategyInterface instantiate(URI uri) throws QueryingStrategyFactoryException {
 		try {
 			switch (uri.getScheme()) {
 				case "file" -> {
-					return new FSQueryingStrategy(Path.of(uri.getPath()));
+					return directoryStrategy(Path.of(uri.getPath()));
+				}
+				case "s3" -> {
+					return s3Strategy(uri);
+				}
+				case "http", "https" -> {
+					HttpOriginClient client = httpOriginClient;
+					if (client == null) throw new IllegalStateException("The origin cache isn't configured");
+					return new HttpQueryingStrategy(client, uri);
 				}
 				case null, default -> {
 					Path path = Path.of(uri.toString());
-					if (Files.exists(path) && Files.isDirectory(path)) return new FSQueryingStrategy(path);
+					if (Files.exists(path) && Files.isDirectory(path)) return directoryStrategy(path);
 				}
 			}
 		} catch (Exception e) {
@@ -64,4 +337,188 @@ public class DefaultQueryingStrategyFactory implements QueryingStrategyFactory {
 		logger.error("No QueryingStrategyInterface implementation exist for {}", uri);
 		throw new QueryingStrategyFactoryException("No QueryingStrategyInterface implementation exist for " + uri);
 	}
+
+	/**
+	 * Returns the {@link MappedRegionCache} instance the instantiated strategies map the resources with, or null if
+	 * the resources aren't mapped.
+	 * @return the current {@link MappedRegionCache} instance or null
+	 */
+	@Nullable
+	public MappedRegionCache getMappedRegionCache() {
+		return mappedRegionCache;
+	}
+
+	/**
+	 * Sets a new {@link MappedRegionCache} instance the strategies instantiated from now on map the resources with;
+	 * null disables mapping.
+	 * @param newMappedRegionCache a new {@link MappedRegionCache} instance or null
+	 */
+	public void setMappedRegionCache(@Nullable MappedRegionCache newMappedRegionCache) {
+		mappedRegionCache = newMappedRegionCache;
+	}
+
+	/**
+	 * Returns the {@link ClipCache} instance the instantiated strategies are served from, or null if the resources
+	 * aren't cached.
+	 * @return the current {@link ClipCache} instance or null
+	 */
+	@Nullable
+	public ClipCache getClipCache() {
+		return clipCache;
+	}
+
+	/**
+	 * Sets a new {@link ClipCache} instance the strategies instantiated from now on are served from; null disables
+	 * caching.
+	 * @param newClipCache a new {@link ClipCache} instance or null
+	 */
+	public void setClipCache(@Nullable ClipCache newClipCache) {
+		clipCache = newClipCache;
+	}
+
+	/**
+	 * Returns the maximum amount of files of a batch the instantiated {@link FSQueryingStrategy} instances open at
+	 * once.
+	 * @return the current open parallelism
+	 */
+	public int getOpenParallelism() {
+		return openParallelism;
+	}
+
+	/**
+	 * Sets a new maximum amount of files of a batch the {@link FSQueryingStrategy} instances instantiated from now on
+	 * open at once.
+	 * @param newOpenParallelism a new open parallelism; must be positive
+	 */
+	public void setOpenParallelism(int newOpenParallelism) {
+		if (newOpenParallelism < 1) throw new IllegalArgumentException("The open parallelism must be positive");
+		openParallelism = newOpenParallelism;
+	}
+
+	/**
+	 * Returns the amount of upcoming clips of each kind the instantiated strategies read ahead, or 0 if they don't.
+	 * @return the current amount of read ahead clips
+	 */
+	public int getReadAheadClips() {
+		return readAheadClips;
+	}
+
+	/**
+	 * Sets a new amount of upcoming clips of each kind the strategies instantiated from now on read ahead; 0 disables
+	 * reading ahead.
+	 * @param newReadAheadClips a new amount of read ahead clips; must not be negative
+	 */
+	public void setReadAheadClips(int newReadAheadClips) {
+		if (newReadAheadClips < 0) throw new IllegalArgumentException("The amount of read ahead clips is negative");
+		readAheadClips = newReadAheadClips;
+	}
+
+	/**
+	 * Returns the directories whose content roots are read ahead; if the list is empty, all of them are.
+	 * @return the current read ahead roots
+	 */
+	@Nonnull
+	public List<Path> getReadAheadRoots() {
+		return readAheadRoots;
+	}
+
+	/**
+	 * Sets new directories the content roots located under which are read ahead by the strategies instantiated from now
+	 * on; an empty list makes all of them read ahead.
+	 * @param newReadAheadRoots new read ahead roots
+	 */
+	public void setReadAheadRoots(@Nonnull List<Path> newReadAheadRoots) {
+		readAheadRoots = newReadAheadRoots.stream().map(root -> root.toAbsolutePath().normalize()).toList();
+	}
+
+	/**
+	 * Returns the total size of the clips the instantiated strategies have read ahead, including the evicted ones.
+	 * @return the amount of warmed bytes
+	 */
+	public long getWarmedBytes() {
+		return warmedBytes.sum();
+	}
+
+	/**
+	 * Returns the {@link ReadCoalescer} instance the concurrent queries of the instantiated strategies are coalesced
+	 * with, or null if they aren't coalesced.
+	 * @return the current {@link ReadCoalescer} instance or null
+	 */
+	@Nullable
+	public ReadCoalescer getReadCoalescer() {
+		return readCoalescer;
+	}
+
+	/**
+	 * Sets a new {@link ReadCoalescer} instance the concurrent queries of the strategies instantiated from now on are
+	 * coalesced with; null disables coalescing.
+	 * @param newReadCoalescer a new {@link ReadCoalescer} instance or null
+	 */
+	public void setReadCoalescer(@Nullable ReadCoalescer newReadCoalescer) {
+		readCoalescer = newReadCoalescer;
+	}
+
+	/**
+	 * Returns the {@link S3Client} instance the instantiated strategies of s3 URIs send the requests with, or null if
+	 * s3 URIs aren't supported.
+	 * @return the current {@link S3Client} instance or null
+	 */
+	@Nullable
+	public S3Client getS3Client() {
+		return s3Client;
+	}
+
+	/**
+	 * Sets a new {@link S3Client} instance the strategies of s3 URIs instantiated from now on send the requests with;
+	 * null makes s3 URIs unsupported.
+	 * @param newS3Client a new {@link S3Client} instance or null
+	 */
+	public void setS3Client(@Nullable S3Client newS3Client) {
+		s3Client = newS3Client;
+	}
+
+	/**
+	 * Returns the {@link HttpOriginClient} instance the instantiated strategies of http(s) URIs fetch the resources
+	 * with, or null if http(s) URIs aren't supported.
+	 * @return the current {@link HttpOriginClient} instance or null
+	 */
+	@Nullable
+	public HttpOriginClient getHttpOriginClient() {
+		return httpOriginClient;
+	}
+
+	/**
+	 * Sets a new {@link HttpOriginClient} instance the strategies of http(s) URIs instantiated from now on fetch
+	 * the resources with; null makes http(s) URIs unsupported.
+	 * @param newHttpOriginClient a new {@link HttpOriginClient} instance or null
+	 */
+	public void setHttpOriginClient(@Nullable HttpOriginClient newHttpOriginClient) {
+		httpOriginClient = newHttpOriginClient;
+	}
+
+	private QueryingStrategyInterface s3Strategy(URI uri) {
+		S3Client client = s3Client;
+		if (client == null) throw new IllegalStateException("The object storage isn't configured");
+		String path = uri.getPath() == null ? "" : uri.getPath();
+		int start = 0, end = path.length();
+		while (start < end && path.charAt(start) == '/') start++;
+		while (end > start && path.charAt(end - 1) == '/') end--;
+		return new S3QueryingStrategy(client, uri.getAuthority(), path.substring(start, end));
+	}
+
+	private QueryingStrategyInterface directoryStrategy(Path directory) throws IOException {
+		MappedRegionCache cache = mappedRegionCache;
+		if (cache != null) return new MmapQueryingStrategy(directory, cache);
+		QueryingStrategyInterface queryingStrategy;
+		Path packFile = directory.resolve(PackedQueryingStrategy.PACK_FILE_NAME);
+		if (Files.isRegularFile(packFile)) queryingStrategy = new PackedQueryingStrategy(packFile);
+		else queryingStrategy = new FSQueryingStrategy(directory, openParallelism);
+
+		int clips = readAheadClips;
+		if (clips == 0) return queryingStrategy;
+		List<Path> roots = readAheadRoots;
+		Path absoluteDirectory = directory.toAbsolutePath().normalize();
+		if (!roots.isEmpty() && roots.stream().noneMatch(absoluteDirectory::startsWith)) return queryingStrategy;
+		return new ReadAheadQueryingStrategy(queryingStrategy, clips, warmedBytes);
+	}
 }
@@ -29,28 +29,60 @@ import java.nio.channels.SeekableByteChannel;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
 
 /**
  * An implementation of {@link QueryingStrategyInterface} to query files that are located under a single directory.
+ * The files of a batch query are opened concurrently on virtual threads, at most by the configured amount at once,
+ * so the opens on network file systems and cold disks don't wait for each other. If any file fails to open, all
+ * the files of the batch that were opened are closed.<br>
+ * {@link java.nio.channels.AsynchronousFileChannel} wouldn't help here: only its reads and writes are asynchronous,
+ * while opening it blocks the calling thread like opening a {@link java.nio.channels.FileChannel} does, and it isn't
+ * a {@link java.nio.channels.SeekableByteChannel}, which the queries return.
  */
 public class FSQueryingStrategy extends AbstractQueryingStrategy {
 
 	private final Logger logger = LoggerFactory.getLogger(FSQueryingStrategy.class);
 
+	/**
+	 * The maximum amount of files of a batch opened at once if it's not configured.
+	 */
+	public static final int DEFAULT_OPEN_PARALLELISM = 8;
+
 	private final Path directory;
 
+	private final int openParallelism;
+
 	/**
-	 * Constructs an instance of this class.
+	 * Constructs an instance of this class that opens at most {@link #DEFAULT_OPEN_PARALLELISM} files at once.
 	 * @param path the location of the directory under which the queried files are located.
 	 */
 	public FSQueryingStrategy(@Nonnull Path path) {
+		this(path, DEFAULT_OPEN_PARALLELISM);
+	}
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param path the location of the directory under which the queried files are located.
+	 * @param openParallelism the maximum amount of files of a batch opened at once; 1 opens them one by one
+	 */
+	public FSQueryingStrategy(@Nonnull Path path, int openParallelism) {
+		if (openParallelism < 1) throw new IllegalArgumentException("The open parallelism must be positive");
 		if (Files.notExists(path) || !Files.isDirectory(path)) {
 			logger.error("{}: {} doesn't exist or not a directory", this, path);
 			throw new IllegalArgumentException(path + " doesn't exist or it's not a directory");
 		}
 		directory = path;
+		this.openParallelism = openParallelism;
 
-		logger.debug("{} instantiated, Path: {}", this, path);
+		logger.debug("{} instantiated, Path: {}, openParallelism: {}", this, path, openParallelism);
 	}
 
 	@Nonnull
@@ -68,7 +100,7 @@ public class FSQueryingStrategy extends AbstractQueryingStrategy {
 	@Override
 	protected SeekableByteChannel fullyQualifiedQuery(@Nonnull String fullyQualifiedName) throws QueryingException {
 		try {
-			return Files.newByteChannel(Path.of(fullyQualifiedName), StandardOpenOption.READ);
+			return open(fullyQualifiedName);
 		} catch (Exception e) {
 			throw new QueryingException(e);
 		}
@@ -80,22 +112,80 @@ public class FSQueryingStrategy extends AbstractQueryingStrategy {
 		@Nonnull String[] fullyQualifiedNames
 	) throws QueryingException {
 		SeekableByteChannel[] channels = new SeekableByteChannel[fullyQualifiedNames.length];
+		int workers = Math.min(openParallelism, fullyQualifiedNames.length);
 		try {
-			for (int i = 0; i < fullyQualifiedNames.length; i++) {
-				channels[i] = Files.newByteChannel(Path.of(fullyQualifiedNames[i]), StandardOpenOption.READ);
+			if (workers <= 1) {
+				for (int i = 0; i < fullyQualifiedNames.length; i++) {
+					channels[i] = open(fullyQualifiedNames[i]);
+				}
+			} else {
+				openConcurrently(fullyQualifiedNames, channels, workers);
 			}
 		} catch (Exception e) {
 			for (SeekableByteChannel channel: channels) {
-				try { channel.close(); } catch (Exception ignored) { }
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
 			}
 			throw new QueryingException(e);
 		}
 		return channels;
 	}
 
+	/**
+	 * Returns the maximum amount of files of a batch opened at once.
+	 * @return the open parallelism
+	 */
+	public int getOpenParallelism() {
+		return openParallelism;
+	}
+
+	// Every worker takes the next unopened file until all of them are opened or one fails. Once this method returns,
+	// either normally or with an exception, no worker is running, so the channels array holds every opened channel
+	private void openConcurrently(
+		String[] fullyQualifiedNames, SeekableByteChannel[] channels, int workers
+	) throws Exception {
+		AtomicInteger nextIndex = new AtomicInteger();
+		AtomicBoolean failed = new AtomicBoolean();
+		List<Future<?>> futures = new ArrayList<>(workers);
+		Exception exception = null;
+		try (ExecutorService executor = Executors.newVirtualThreadPerTaskExecutor()) {
+			for (int w = 0; w < workers; w++) {
+				futures.add(executor.submit(() -> {
+					int i;
+					while (!failed.get() && (i = nextIndex.getAndIncrement()) < fullyQualifiedNames.length) {
+						try {
+							channels[i] = open(fullyQualifiedNames[i]);
+						} catch (Exception e) {
+							failed.set(true);
+							throw e;
+						}
+					}
+					return null;
+				}));
+			}
+			for (Future<?> future: futures) {
+				try {
+					future.get();
+				} catch (ExecutionException e) {
+					if (exception == null) {
+						exception = e.getCause() instanceof Exception cause ? cause : new IOException(e.getCause());
+					}
+				} catch (InterruptedException e) {
+					failed.set(true);
+					Thread.currentThread().interrupt();
+					if (exception == null) exception = e;
+				}
+			}
+		}
+		if (exception != null) throw exception;
+	}
+
 	@Nonnull
 	@Override
 	public String getRoot() {
 		return directory.toString();
 	}
+
+	private static SeekableByteChannel open(String fullyQualifiedName) throws IOException {
+		return Files.newByteChannel(Path.of(fullyQualifiedName), StandardOpenOption.READ);
+	}
 }
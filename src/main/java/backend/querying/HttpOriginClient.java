@@ -0,0 +1,283 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.FileNotFoundException;
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.net.URI;
+import java.net.http.HttpClient;
+import java.net.http.HttpRequest;
+import java.net.http.HttpResponse;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
+import java.time.Duration;
+import java.util.Comparator;
+import java.util.HexFormat;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.UUID;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.stream.Stream;
+
+/**
+ * HttpOriginClient fetches resources from an HTTP(S) origin, e.g. a static file server in front of the media library,
+ * into a local disk cache. The resources are assumed to never change, so a cached resource is never requested again.
+ * Concurrent fetches of the same resource are coalesced: the first one sends the request and the others wait for its
+ * result, so a resource many viewers start watching at once is requested from the origin once.<br>
+ * The total size of the cached files is limited by the capacity; the least recently fetched files are deleted when
+ * it's exceeded. The files cached by a previous run are reused. The requests are sent by a single {@link HttpClient},
+ * which keeps the connections to the origin alive and reuses them, so an instance of this class is meant to be shared
+ * by all the strategies. The client counts the requests sent to the origin, the coalesced fetches, and the fetches
+ * served from the disk cache.
+ */
+public class HttpOriginClient implements AutoCloseable {
+
+	/**
+	 * The capacity of the disk cache in bytes if it's not configured.
+	 */
+	public static final long DEFAULT_CAPACITY = 10L * 1024 * 1024 * 1024;
+
+	private static final String TEMPORARY_FILE_SUFFIX = ".tmp";
+
+	private final Logger logger = LoggerFactory.getLogger(HttpOriginClient.class);
+
+	private final Path cacheDirectory;
+
+	private final long capacity;
+
+	private final HttpClient httpClient;
+
+	private final Map<URI, CompletableFuture<Path>> inFlightFetches = new ConcurrentHashMap<>();
+
+	private final LinkedHashMap<String, Long> cachedFiles = new LinkedHashMap<>(16, 0.75f, true);
+
+	private final LongAdder upstreamRequests = new LongAdder();
+
+	private final LongAdder coalescedFetches = new LongAdder();
+
+	private final LongAdder cacheHits = new LongAdder();
+
+	private long cachedBytes = 0;
+
+	/**
+	 * Constructs an instance of this class. The directory is created if it doesn't exist, and the files it contains
+	 * are taken into the cache, the most recently modified ones being the most recently used.
+	 * @param cacheDirectory the directory of the disk cache, which must not be used for anything else
+	 * @param capacity the maximum total size of the cached files in bytes; must be positive
+	 * @throws IOException if the directory can't be created or read
+	 */
+	public HttpOriginClient(@Nonnull Path cacheDirectory, long capacity) throws IOException {
+		if (capacity <= 0) throw new IllegalArgumentException("The capacity must be positive");
+		this.cacheDirectory = Files.createDirectories(cacheDirectory);
+		this.capacity = capacity;
+		List<Path> files;
+		try (Stream<Path> stream = Files.list(cacheDirectory)) {
+			files = stream.filter(Files::isRegularFile).toList();
+		}
+		List<Path> cached = files
+			.stream()
+			.filter(file -> !file.getFileName().toString().endsWith(TEMPORARY_FILE_SUFFIX))
+			.sorted(Comparator.comparing(HttpOriginClient::lastModified))
+			.toList();
+		for (Path file: files) {
+			if (file.getFileName().toString().endsWith(TEMPORARY_FILE_SUFFIX)) Files.deleteIfExists(file);
+		}
+		synchronized (cachedFiles) {
+			for (Path file: cached) register(file.getFileName().toString(), Files.size(file));
+		}
+		httpClient = HttpClient.newBuilder()
+			.version(HttpClient.Version.HTTP_1_1)
+			.followRedirects(HttpClient.Redirect.NORMAL)
+			.connectTimeout(Duration.ofSeconds(10))
+			.executor(Executors.newVirtualThreadPerTaskExecutor())
+			.build();
+
+		logger.debug(
+			"{} instantiated, Path: {}, capacity: {}, cached files: {}", this, cacheDirectory, capacity, cached.size()
+		);
+	}
+
+	/**
+	 * Returns the location of the cached copy of the resource, fetching it from the origin first if it's not cached.
+	 * The cached copy may be deleted once the cache exceeds the capacity, so it should be opened right away.
+	 * @param uri the URI of the resource
+	 * @return the future location of the cached copy; it's completed exceptionally with {@link FileNotFoundException}
+	 *         if the origin doesn't have the resource
+	 */
+	@Nonnull
+	public CompletableFuture<Path> fetch(@Nonnull URI uri) {
+		String fileName = fileNameOf(uri);
+		Path file = cacheDirectory.resolve(fileName);
+		if (isCached(fileName)) {
+			cacheHits.increment();
+			return CompletableFuture.completedFuture(file);
+		}
+		CompletableFuture<Path> fetch = new CompletableFuture<>();
+		CompletableFuture<Path> inFlightFetch = inFlightFetches.putIfAbsent(uri, fetch);
+		if (inFlightFetch != null) {
+			coalescedFetches.increment();
+			return inFlightFetch;
+		}
+		// The resource could have been cached by a fetch that completed after the check above
+		if (isCached(fileName)) {
+			inFlightFetches.remove(uri, fetch);
+			cacheHits.increment();
+			fetch.complete(file);
+			return fetch;
+		}
+		download(uri, fileName).whenComplete((downloadedFile, e) -> {
+			inFlightFetches.remove(uri, fetch);
+			if (e == null) {
+				fetch.complete(downloadedFile);
+				return;
+			}
+			Throwable cause = e instanceof CompletionException && e.getCause() != null ? e.getCause() : e;
+			fetch.completeExceptionally(cause instanceof UncheckedIOException u ? u.getCause() : cause);
+		});
+		return fetch;
+	}
+
+	@Override
+	public void close() {
+		httpClient.close();
+	}
+
+	/**
+	 * Returns the total size of the cached files in bytes.
+	 * @return the amount of cached bytes
+	 */
+	public long getCachedBytes() {
+		synchronized (cachedFiles) {
+			return cachedBytes;
+		}
+	}
+
+	/**
+	 * Returns the amount of requests sent to the origin.
+	 * @return the amount of upstream requests
+	 */
+	public long getUpstreamRequests() {
+		return upstreamRequests.sum();
+	}
+
+	/**
+	 * Returns the amount of fetches that waited for the result of a concurrent fetch of the same resource.
+	 * @return the amount of coalesced fetches
+	 */
+	public long getCoalescedFetches() {
+		return coalescedFetches.sum();
+	}
+
+	/**
+	 * Returns the amount of fetches served from the disk cache.
+	 * @return the amount of cache hits
+	 */
+	public long getCacheHits() {
+		return cacheHits.sum();
+	}
+
+	private CompletableFuture<Path> download(URI uri, String fileName) {
+		upstreamRequests.increment();
+		Path temporaryFile = cacheDirectory.resolve(fileName + "." + UUID.randomUUID() + TEMPORARY_FILE_SUFFIX);
+		HttpRequest request = HttpRequest.newBuilder(uri).GET().timeout(Duration.ofSeconds(30)).build();
+		return httpClient
+			.sendAsync(request, HttpResponse.BodyHandlers.ofFile(temporaryFile))
+			.thenApply(response -> {
+				try {
+					if (response.statusCode() == 404) throw new FileNotFoundException(uri + " doesn't exist");
+					if (response.statusCode() != 200) {
+						throw new IOException("The origin responded to the request for " + uri + " with " +
+							response.statusCode());
+					}
+					Path file = cacheDirectory.resolve(fileName);
+					Files.move(
+						temporaryFile, file, StandardCopyOption.ATOMIC_MOVE, StandardCopyOption.REPLACE_EXISTING
+					);
+					long size = Files.size(file);
+					synchronized (cachedFiles) {
+						register(fileName, size);
+					}
+					return file;
+				} catch (IOException e) {
+					throw new UncheckedIOException(e);
+				}
+			})
+			.whenComplete((file, e) -> {
+				if (e != null) {
+					try { Files.deleteIfExists(temporaryFile); } catch (Exception ignored) { }
+					logger.debug("{} failed to fetch {}", this, uri, e);
+				}
+			});
+	}
+
+	private boolean isCached(String fileName) {
+		synchronized (cachedFiles) {
+			return cachedFiles.get(fileName) != null;
+		}
+	}
+
+	// Must be called while holding the lock of cachedFiles
+	private void register(String fileName, long size) {
+		Long previousSize = cachedFiles.put(fileName, size);
+		cachedBytes += size - (previousSize == null ? 0 : previousSize);
+		Iterator<Map.Entry<String, Long>> iterator = cachedFiles.entrySet().iterator();
+		while (cachedBytes > capacity && cachedFiles.size() > 1) {
+			Map.Entry<String, Long> eldest = iterator.next();
+			try {
+				Files.deleteIfExists(cacheDirectory.resolve(eldest.getKey()));
+			} catch (IOException e) {
+				logger.warn("{} failed to delete cached file {}", this, eldest.getKey(), e);
+			}
+			cachedBytes -= eldest.getValue();
+			iterator.remove();
+		}
+	}
+
+	private static String fileNameOf(URI uri) {
+		try {
+			MessageDigest digest = MessageDigest.getInstance("SHA-256");
+			return HexFormat.of().formatHex(digest.digest(uri.toString().getBytes(StandardCharsets.UTF_8)));
+		} catch (GeneralSecurityException e) {
+			throw new IllegalStateException(e);
+		}
+	}
+
+	private static long lastModified(Path file) {
+		try {
+			return Files.getLastModifiedTime(file).toMillis();
+		} catch (IOException e) {
+			return 0;
+		}
+	}
+}
@@ -0,0 +1,147 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.net.URI;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+
+/**
+ * An implementation of {@link QueryingStrategyInterface} to query resources that are served by an HTTP(S) origin
+ * under a common base URI, e.g. the directory of a media on a static file server in front of the media library of
+ * the origin. The fully-qualified name of a resource is its URI, i.e. the base URI and the simple name joined with
+ * a slash.<br>
+ * The resources are fetched into the disk cache of an {@link HttpOriginClient} and read from there, so a resource
+ * crosses the network once and is then served like a local file. The returned channels are file channels, but since
+ * the servlet responses aren't channels, they are copied into the responses through a buffer like any other channel.
+ * The resources of a batch query are fetched concurrently. If any resource of a batch
+ * can't be queried, all the channels of the batch are closed.
+ */
+public class HttpQueryingStrategy extends AbstractQueryingStrategy {
+
+	private final Logger logger = LoggerFactory.getLogger(HttpQueryingStrategy.class);
+
+	private final HttpOriginClient httpOriginClient;
+
+	private final String baseUri;
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param httpOriginClient the {@link HttpOriginClient} instance that fetches the resources
+	 * @param baseUri the common base URI of the resources
+	 */
+	public HttpQueryingStrategy(@Nonnull HttpOriginClient httpOriginClient, @Nonnull URI baseUri) {
+		if (!"http".equals(baseUri.getScheme()) && !"https".equals(baseUri.getScheme())) {
+			throw new IllegalArgumentException(baseUri + " isn't an HTTP(S) URI");
+		}
+		this.httpOriginClient = httpOriginClient;
+		this.baseUri = baseUri.toString();
+
+		logger.debug("{} instantiated, HttpOriginClient: {}, URI: {}", this, httpOriginClient, baseUri);
+	}
+
+	@Nonnull
+	@Override
+	protected String compose(@Nonnull String... octets) {
+		StringBuilder sb = new StringBuilder(octets[0]);
+		for (int i = 1; i < octets.length; i++) {
+			if (sb.charAt(sb.length() - 1) != '/') sb.append('/');
+			sb.append(octets[i]);
+		}
+		return sb.toString();
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel fullyQualifiedQuery(@Nonnull String fullyQualifiedName) throws QueryingException {
+		return fullyQualifiedQuery(new String[] {fullyQualifiedName})[0];
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel[] fullyQualifiedQuery(
+		@Nonnull String[] fullyQualifiedNames
+	) throws QueryingException {
+		URI[] uris = new URI[fullyQualifiedNames.length];
+		try {
+			for (int i = 0; i < fullyQualifiedNames.length; i++) uris[i] = URI.create(fullyQualifiedNames[i]);
+		} catch (IllegalArgumentException e) {
+			throw new QueryingException(e);
+		}
+		List<CompletableFuture<Path>> fetches = new ArrayList<>(uris.length);
+		for (URI uri: uris) fetches.add(httpOriginClient.fetch(uri));
+
+		SeekableByteChannel[] channels = new SeekableByteChannel[fullyQualifiedNames.length];
+		Exception exception = null;
+		for (int i = 0; i < uris.length; i++) {
+			try {
+				channels[i] = open(uris[i], fetches.get(i));
+			} catch (Exception e) {
+				if (exception == null) exception = e;
+			}
+		}
+		if (exception != null) {
+			for (SeekableByteChannel channel: channels) {
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+			}
+			throw new QueryingException(exception);
+		}
+		return channels;
+	}
+
+	@Nonnull
+	@Override
+	public String getRoot() {
+		return baseUri;
+	}
+
+	private SeekableByteChannel open(URI uri, CompletableFuture<Path> fetch) throws IOException {
+		try {
+			return Files.newByteChannel(await(fetch), StandardOpenOption.READ);
+		} catch (NoSuchFileException e) {
+			// The cached copy was evicted before it was opened
+			return Files.newByteChannel(await(httpOriginClient.fetch(uri)), StandardOpenOption.READ);
+		}
+	}
+
+	private static Path await(CompletableFuture<Path> fetch) throws IOException {
+		try {
+			return fetch.get();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			throw new InterruptedIOException();
+		} catch (ExecutionException e) {
+			throw e.getCause() instanceof IOException cause ? cause : new IOException(e.getCause());
+		}
+	}
+}
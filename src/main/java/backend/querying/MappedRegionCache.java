@@ -0,0 +1,297 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import backend.adapters.FileChannelSlice;
+import backend.adapters.MemorySegmentChannel;
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.nio.channels.FileChannel;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * MappedRegionCache keeps regions of files mapped into memory and shares the mappings between the channels that read
+ * them, so a region read by many requests is mapped once and then read straight from the memory. The total size of
+ * the cached mappings is limited by a budget; when it's exceeded, the least recently used mappings are evicted.
+ * An evicted mapping is unmapped as soon as the last channel reading it is closed, so the memory mapped at once may
+ * temporarily exceed the budget by the size of the regions that are still being read. A region larger than the whole
+ * budget is mapped for its channel only.<br>
+ * Mapping a region costs more than reading it once: every mapping has its own {@link Arena}, and unmapping it
+ * performs a handshake with all the threads. So a region is mapped only once it has been requested as many times as
+ * the map threshold; until then, it's read from the file with a {@link FileChannel}, and the cache only counts
+ * the requests of the most recently requested unmapped regions.<br>
+ * The mapped files are assumed to be immutable: a file modified after its region has been mapped is undefined
+ * behavior for the channels reading it. A file replaced with another one, e.g. a re-packed pack file, is told apart by
+ * its key if the caller passes it. The cache counts hits, the regions that were already mapped, misses, the regions
+ * that had to be mapped, and cold reads, the regions that were read without mapping them.
+ */
+public class MappedRegionCache {
+
+	/**
+	 * The budget in bytes if it's not configured.
+	 */
+	public static final long DEFAULT_BUDGET = 1024L * 1024 * 1024;
+
+	/**
+	 * The amount of requests after which a region is mapped if it's not configured.
+	 */
+	public static final int DEFAULT_MAP_THRESHOLD = 3;
+
+	/**
+	 * The maximum amount of unmapped regions whose requests are counted.
+	 */
+	public static final int MAX_COUNTED_REGIONS = 65536;
+
+	private final Logger logger = LoggerFactory.getLogger(MappedRegionCache.class);
+
+	private final long budget;
+
+	private final int mapThreshold;
+
+	private final LinkedHashMap<Region, Mapping> mappings = new LinkedHashMap<>(16, 0.75f, true);
+
+	// The requests of the unmapped regions, the least recently requested region first
+	private final LinkedHashMap<Region, Integer> requests = new LinkedHashMap<>(16, 0.75f, true);
+
+	private final LongAdder hits = new LongAdder();
+
+	private final LongAdder misses = new LongAdder();
+
+	private final LongAdder coldReads = new LongAdder();
+
+	private long mappedBytes = 0;
+
+	private record Region(Path file, Object fileKey, long offset, long length) { }
+
+	private static final class Mapping {
+
+		final Arena arena;
+
+		final MemorySegment segment;
+
+		// The cache holds a reference to the mappings it caches, and every open channel holds one
+		int references = 0;
+
+		Mapping(Arena arena, MemorySegment segment) {
+			this.arena = arena;
+			this.segment = segment;
+		}
+	}
+
+	/**
+	 * Constructs an instance of this class that maps a region once it has been requested
+	 * {@link #DEFAULT_MAP_THRESHOLD} times.
+	 * @param budget the maximum total size of the cached mappings in bytes; must be positive
+	 */
+	public MappedRegionCache(long budget) {
+		this(budget, DEFAULT_MAP_THRESHOLD);
+	}
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param budget the maximum total size of the cached mappings in bytes; must be positive
+	 * @param mapThreshold the amount of requests after which a region is mapped; 1 maps every region on its first
+	 *                     request; must be positive
+	 */
+	public MappedRegionCache(long budget, int mapThreshold) {
+		if (budget <= 0) throw new IllegalArgumentException("The budget must be positive");
+		if (mapThreshold < 1) throw new IllegalArgumentException("The map threshold must be positive");
+		this.budget = budget;
+		this.mapThreshold = mapThreshold;
+
+		logger.debug("{} instantiated, budget: {}, map threshold: {}", this, budget, mapThreshold);
+	}
+
+	/**
+	 * Returns a channel that reads the region of the file, the same as {@link #open(Path, Object, long, long)} with
+	 * no file key.
+	 * @param file the location of the file
+	 * @param offset the position in the file at which the region begins
+	 * @param length the length of the region, or a negative value if the region ends at the end of the file
+	 * @return the {@link SeekableByteChannel} instance
+	 * @throws IOException if the file can't be read
+	 */
+	@Nonnull
+	public SeekableByteChannel open(@Nonnull Path file, long offset, long length) throws IOException {
+		return open(file, null, offset, length);
+	}
+
+	/**
+	 * Returns a channel that reads the region of the file. If the region is mapped or it has been requested as many
+	 * times as the map threshold, it's read from the memory and mapped if it isn't mapped yet; otherwise it's read
+	 * from the file. The channel must be closed once it's no longer used, so the mapping can be unmapped or the file
+	 * closed.
+	 * @param file the location of the file
+	 * @param fileKey the key of the file, see {@link java.nio.file.attribute.BasicFileAttributes#fileKey()}, so
+	 *                the regions of a replaced file aren't read from the mappings of the previous one, or null
+	 * @param offset the position in the file at which the region begins
+	 * @param length the length of the region, or a negative value if the region ends at the end of the file
+	 * @return the {@link SeekableByteChannel} instance
+	 * @throws IOException if the file can't be read or mapped
+	 */
+	@Nonnull
+	public SeekableByteChannel open(
+		@Nonnull Path file, @Nullable Object fileKey, long offset, long length
+	) throws IOException {
+		Region region = new Region(file, fileKey, offset, length);
+		boolean cold = false;
+		synchronized (this) {
+			Mapping mapping = mappings.get(region);
+			if (mapping != null) {
+				hits.increment();
+				return channelOf(mapping);
+			}
+			if (mapThreshold > 1) {
+				if (requests.merge(region, 1, Integer::sum) < mapThreshold) {
+					cold = true;
+					Iterator<Region> iterator = requests.keySet().iterator();
+					while (requests.size() > MAX_COUNTED_REGIONS && iterator.hasNext()) {
+						iterator.next();
+						iterator.remove();
+					}
+				} else {
+					requests.remove(region);
+				}
+			}
+		}
+		if (cold) {
+			coldReads.increment();
+			return read(region);
+		}
+		misses.increment();
+
+		Mapping newMapping = map(region);
+		synchronized (this) {
+			// Another thread may have mapped the same region in the meanwhile
+			Mapping mapping = mappings.get(region);
+			if (mapping != null) {
+				newMapping.arena.close();
+				return channelOf(mapping);
+			}
+			long size = newMapping.segment.byteSize();
+			if (size <= budget) {
+				newMapping.references++;
+				mappings.put(region, newMapping);
+				mappedBytes += size;
+				evictExcess();
+			}
+			return channelOf(newMapping);
+		}
+	}
+
+	/**
+	 * Returns the total size of the cached mappings in bytes.
+	 * @return the amount of mapped bytes
+	 */
+	public synchronized long getMappedBytes() {
+		return mappedBytes;
+	}
+
+	/**
+	 * Returns the amount of requested regions that were already mapped.
+	 * @return the amount of hits
+	 */
+	public long getHits() {
+		return hits.sum();
+	}
+
+	/**
+	 * Returns the amount of requested regions that had to be mapped.
+	 * @return the amount of misses
+	 */
+	public long getMisses() {
+		return misses.sum();
+	}
+
+	/**
+	 * Returns the amount of requested regions that were read from the files without mapping them, since they hadn't
+	 * been requested as many times as the map threshold.
+	 * @return the amount of cold reads
+	 */
+	public long getColdReads() {
+		return coldReads.sum();
+	}
+
+	/**
+	 * Returns the amount of requests after which a region is mapped.
+	 * @return the map threshold
+	 */
+	public int getMapThreshold() {
+		return mapThreshold;
+	}
+
+	private static SeekableByteChannel read(Region region) throws IOException {
+		FileChannel fileChannel = FileChannel.open(region.file(), StandardOpenOption.READ);
+		if (region.offset() == 0 && region.length() < 0) return fileChannel;
+		try {
+			long length = region.length() < 0 ? fileChannel.size() - region.offset() : region.length();
+			return new FileChannelSlice(fileChannel, region.offset(), length, () -> {
+				try { fileChannel.close(); } catch (Exception ignored) { }
+			});
+		} catch (IOException | RuntimeException e) {
+			fileChannel.close();
+			throw e;
+		}
+	}
+
+	private Mapping map(Region region) throws IOException {
+		Arena arena = Arena.ofShared();
+		try (FileChannel fileChannel = FileChannel.open(region.file(), StandardOpenOption.READ)) {
+			long length = region.length() < 0 ? fileChannel.size() - region.offset() : region.length();
+			return new Mapping(arena, fileChannel.map(FileChannel.MapMode.READ_ONLY, region.offset(), length, arena));
+		} catch (IOException | RuntimeException e) {
+			arena.close();
+			throw e;
+		}
+	}
+
+	// Must be called while holding the lock
+	private SeekableByteChannel channelOf(Mapping mapping) {
+		mapping.references++;
+		return new MemorySegmentChannel(mapping.segment, () -> release(mapping));
+	}
+
+	// Must be called while holding the lock
+	private void evictExcess() {
+		Iterator<Map.Entry<Region, Mapping>> iterator = mappings.entrySet().iterator();
+		while (mappedBytes > budget && iterator.hasNext()) {
+			Mapping mapping = iterator.next().getValue();
+			iterator.remove();
+			mappedBytes -= mapping.segment.byteSize();
+			release(mapping);
+		}
+	}
+
+	private synchronized void release(Mapping mapping) {
+		if (--mapping.references == 0) mapping.arena.close();
+	}
+}
@@ -0,0 +1,156 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.util.Map;
+
+/**
+ * An implementation of {@link QueryingStrategyInterface} that reads the resources located under a single directory
+ * from the memory they are mapped into. The resources are either files of the directory, the same way
+ * {@link FSQueryingStrategy} reads them, or regions of the {@link PackedQueryingStrategy#PACK_FILE_NAME} file if
+ * the directory contains it. The mappings are managed by a {@link MappedRegionCache}, which is usually shared by all
+ * the strategies, so a resource read by many requests is mapped once and the total size of the mappings stays within
+ * a single budget. The files are mapped along with their keys and sizes, so a file that was replaced, e.g. a pack
+ * file packed again or a clip written anew, is mapped again instead of being read from the previous mapping.
+ */
+public class MmapQueryingStrategy extends AbstractQueryingStrategy {
+
+	private final Logger logger = LoggerFactory.getLogger(MmapQueryingStrategy.class);
+
+	private final Path directory;
+
+	private final MappedRegionCache mappedRegionCache;
+
+	private final Path packFile;
+
+	private final Map<String, PackedQueryingStrategy.Entry> packIndex;
+
+	private final Object packFileKey;
+
+	/**
+	 * Constructs an instance of this class. If the directory contains a pack file, its index is read.
+	 * @param path the location of the directory under which the queried resources are located
+	 * @param mappedRegionCache the {@link MappedRegionCache} instance that maps the resources
+	 * @throws IOException if the directory contains a pack file that can't be read
+	 */
+	public MmapQueryingStrategy(@Nonnull Path path, @Nonnull MappedRegionCache mappedRegionCache) throws IOException {
+		if (Files.notExists(path) || !Files.isDirectory(path)) {
+			logger.error("{}: {} doesn't exist or not a directory", this, path);
+			throw new IllegalArgumentException(path + " doesn't exist or it's not a directory");
+		}
+		directory = path;
+		this.mappedRegionCache = mappedRegionCache;
+		Path possiblePackFile = path.resolve(PackedQueryingStrategy.PACK_FILE_NAME);
+		if (Files.isRegularFile(possiblePackFile)) {
+			packFile = possiblePackFile;
+			packFileKey = Files.readAttributes(possiblePackFile, BasicFileAttributes.class).fileKey();
+			packIndex = PackedQueryingStrategy.readIndex(possiblePackFile);
+		} else {
+			packFile = null;
+			packFileKey = null;
+			packIndex = null;
+		}
+
+		logger.debug(
+			"{} instantiated, Path: {}, MappedRegionCache: {}, packed: {}",
+			this,
+			path,
+			mappedRegionCache,
+			packFile != null
+		);
+	}
+
+	@Nonnull
+	@Override
+	protected String compose(@Nonnull String... octets) {
+		StringBuilder sb = new StringBuilder(octets[0]);
+		for (int i = 1; i < octets.length; i++) {
+			if (!octets[i - 1].endsWith(File.separator)) sb.append(File.separator);
+			sb.append(octets[i]);
+		}
+		return sb.toString();
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel fullyQualifiedQuery(@Nonnull String fullyQualifiedName) throws QueryingException {
+		try {
+			if (packIndex == null) {
+				// The key and the size tell a replaced or rewritten file apart from the one that may be mapped already
+				Path file = Path.of(fullyQualifiedName);
+				BasicFileAttributes attributes = Files.readAttributes(file, BasicFileAttributes.class);
+				return mappedRegionCache.open(file, attributes.fileKey(), 0, attributes.size());
+			}
+			PackedQueryingStrategy.Entry entry = packIndex.get(Path.of(fullyQualifiedName).getFileName().toString());
+			if (entry == null) throw new QueryingException(fullyQualifiedName + " doesn't exist");
+			return mappedRegionCache.open(packFile, packFileKey, entry.offset(), entry.length());
+		} catch (QueryingException e) {
+			throw e;
+		} catch (Exception e) {
+			throw new QueryingException(e);
+		}
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel[] fullyQualifiedQuery(
+		@Nonnull String[] fullyQualifiedNames
+	) throws QueryingException {
+		SeekableByteChannel[] channels = new SeekableByteChannel[fullyQualifiedNames.length];
+		try {
+			for (int i = 0; i < fullyQualifiedNames.length; i++) {
+				channels[i] = fullyQualifiedQuery(fullyQualifiedNames[i]);
+			}
+		} catch (QueryingException e) {
+			for (SeekableByteChannel channel: channels) {
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+			}
+			throw e;
+		}
+		return channels;
+	}
+
+	@Nonnull
+	@Override
+	public String getRoot() {
+		return directory.toString();
+	}
+
+	/**
+	 * Returns the location of the pack file the resources are read from, or null if they are read from separate files.
+	 * @return the location of the pack file or null
+	 */
+	@Nullable
+	public Path getPackFile() {
+		return packFile;
+	}
+}
@@ -0,0 +1,247 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import backend.adapters.FileChannelSlice;
+import backend.exceptions.QueryingException;
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * An implementation of {@link QueryingStrategyInterface} to query resources packed into a single file rather than
+ * stored as a file per resource. The pack file begins with an index that maps the name of every resource to its offset
+ * and length in the file, and the resources follow the index:
+ * <pre>
+ * magic          8 bytes, {@link #MAGIC} in ASCII
+ * version        int, {@link #VERSION}
+ * entry count    int
+ * index length   int, the length of the entries in bytes
+ * entries        for every resource: the length of its name (unsigned short), the name in UTF-8, the offset (long),
+ *                and the length (long)
+ * resources      the content of the resources at their offsets
+ * </pre>
+ * The numbers are big-endian. The file is opened and its index is read once, when the strategy is instantiated, so
+ * a query neither opens files nor performs I/O; the queried resources are {@link FileChannelSlice} views of the file
+ * that can be read concurrently. Closing the strategy makes it reject the queries, and the file is closed once
+ * the strategy and all the slices it returned are closed, so closing the strategy doesn't break the slices that are
+ * still being read.<br>
+ * The fully-qualified name of a resource is the location of the pack file and the simple name of the resource joined
+ * with {@link #SEPARATOR}.
+ */
+public class PackedQueryingStrategy extends AbstractQueryingStrategy {
+
+	/**
+	 * The name of the pack file in the directory of a media.
+	 */
+	public static final String PACK_FILE_NAME = "media.pack";
+
+	/**
+	 * The bytes the pack file begins with.
+	 */
+	public static final String MAGIC = "RUBUSPAK";
+
+	/**
+	 * The version of the pack file format.
+	 */
+	public static final int VERSION = 1;
+
+	/**
+	 * The length of the fixed-size part of the pack file that precedes the entries of the index.
+	 */
+	public static final int HEADER_LENGTH = 20;
+
+	// The length of an entry of the index whose name is empty
+	private static final int MIN_ENTRY_LENGTH = Short.BYTES + 2 * Long.BYTES;
+
+	/**
+	 * The separator of the location of the pack file and the simple name of a resource in fully-qualified names.
+	 */
+	public static final String SEPARATOR = "!";
+
+	private final Logger logger = LoggerFactory.getLogger(PackedQueryingStrategy.class);
+
+	private final Path packFile;
+
+	private final FileChannel fileChannel;
+
+	private final Map<String, Entry> entries;
+
+	// The strategy holds a reference to the file until it's closed, and every open slice holds one; guarded by this
+	private int references = 1;
+
+	private boolean closed = false;
+
+	/**
+	 * Entry locates a resource in the pack file.
+	 * @param offset the position of the resource in the pack file
+	 * @param length the length of the resource
+	 */
+	record Entry(long offset, long length) { }
+
+	/**
+	 * Constructs an instance of this class, opens the pack file, and reads its index.
+	 * @param packFile the location of the pack file
+	 * @throws IOException if the file can't be read or isn't a valid pack file
+	 */
+	public PackedQueryingStrategy(@Nonnull Path packFile) throws IOException {
+		this.packFile = packFile;
+		fileChannel = FileChannel.open(packFile, StandardOpenOption.READ);
+		try {
+			entries = readIndex(fileChannel);
+		} catch (Exception e) {
+			fileChannel.close();
+			logger.error("{} couldn't read the index of {}", this, packFile, e);
+			throw e;
+		}
+
+		logger.debug("{} instantiated, Path: {}, entries: {}", this, packFile, entries.size());
+	}
+
+	@Override
+	public synchronized void close() {
+		if (closed) return;
+		closed = true;
+		release();
+	}
+
+	@Nonnull
+	@Override
+	protected String compose(@Nonnull String... octets) {
+		return String.join(SEPARATOR, octets);
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel fullyQualifiedQuery(@Nonnull String fullyQualifiedName) throws QueryingException {
+		String prefix = getRoot() + SEPARATOR;
+		Entry entry = fullyQualifiedName.startsWith(prefix) ?
+			entries.get(fullyQualifiedName.substring(prefix.length())) :
+			null;
+		if (entry == null) throw new QueryingException(fullyQualifiedName + " doesn't exist");
+		synchronized (this) {
+			if (closed) throw new QueryingException(packFile + " is closed");
+			references++;
+		}
+		return new FileChannelSlice(fileChannel, entry.offset(), entry.length(), this::release);
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel[] fullyQualifiedQuery(
+		@Nonnull String[] fullyQualifiedNames
+	) throws QueryingException {
+		SeekableByteChannel[] channels = new SeekableByteChannel[fullyQualifiedNames.length];
+		try {
+			for (int i = 0; i < fullyQualifiedNames.length; i++) {
+				channels[i] = fullyQualifiedQuery(fullyQualifiedNames[i]);
+			}
+		} catch (QueryingException e) {
+			for (SeekableByteChannel channel: channels) {
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+			}
+			throw e;
+		}
+		return channels;
+	}
+
+	@Nonnull
+	@Override
+	public String getRoot() {
+		return packFile.toString();
+	}
+
+	private synchronized void release() {
+		if (--references > 0) return;
+		try {
+			fileChannel.close();
+		} catch (IOException e) {
+			logger.warn("{} couldn't close {}", this, packFile, e);
+		}
+	}
+
+	/**
+	 * Reads the index of the pack file.
+	 * @param packFile the location of the pack file
+	 * @return the entries of the index mapped by the names of the resources
+	 * @throws IOException if the file can't be read or isn't a valid pack file
+	 */
+	static Map<String, Entry> readIndex(Path packFile) throws IOException {
+		try (FileChannel fileChannel = FileChannel.open(packFile, StandardOpenOption.READ)) {
+			return readIndex(fileChannel);
+		}
+	}
+
+	private static Map<String, Entry> readIndex(FileChannel fileChannel) throws IOException {
+		ByteBuffer header = ByteBuffer.allocate(HEADER_LENGTH);
+		readFully(fileChannel, header, 0);
+		byte[] magic = new byte[MAGIC.length()];
+		header.get(magic);
+		if (!MAGIC.equals(new String(magic, StandardCharsets.US_ASCII))) throw new IOException("Not a pack file");
+		int version = header.getInt();
+		if (version != VERSION) throw new IOException("Unsupported pack file version " + version);
+		int entryCount = header.getInt();
+		int indexLength = header.getInt();
+		long fileSize = fileChannel.size();
+		if (entryCount < 0 || indexLength < 0 || HEADER_LENGTH + (long) indexLength > fileSize) {
+			throw new IOException("Corrupted pack file header");
+		}
+		// The entry count sizes the table of the entries, so it's checked against the index before allocating it
+		if (entryCount > indexLength / MIN_ENTRY_LENGTH) {
+			throw new IOException("Corrupted pack file header, too many entries: " + entryCount);
+		}
+
+		ByteBuffer index = ByteBuffer.allocate(indexLength);
+		readFully(fileChannel, index, HEADER_LENGTH);
+		Map<String, Entry> entries = HashMap.newHashMap(entryCount);
+		try {
+			for (int i = 0; i < entryCount; i++) {
+				byte[] name = new byte[Short.toUnsignedInt(index.getShort())];
+				index.get(name);
+				Entry entry = new Entry(index.getLong(), index.getLong());
+				if (entry.offset() < 0 || entry.length() < 0 || entry.offset() + entry.length() > fileSize) {
+					throw new IOException("Corrupted pack file entry " + i);
+				}
+				entries.put(new String(name, StandardCharsets.UTF_8), entry);
+			}
+		} catch (RuntimeException e) {
+			throw new IOException("Corrupted pack file index", e);
+		}
+		return entries;
+	}
+
+	private static void readFully(FileChannel fileChannel, ByteBuffer buffer, long position) throws IOException {
+		while (buffer.hasRemaining()) {
+			int bytesRead = fileChannel.read(buffer, position + buffer.position());
+			if (bytesRead == -1) throw new IOException("Unexpected end of the pack file");
+		}
+		buffer.flip();
+	}
+}
@@ -0,0 +1,236 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.nio.ByteBuffer;
+import java.nio.channels.SeekableByteChannel;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
+import java.util.Map;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * ReadAheadQueryingStrategy warms the page cache for the clips a viewer is going to request next. Viewers request
+ * clips strictly in sequence, so when a query asks for the clips up to vN and aN, this strategy reads the next clips of
+ * the same kinds, up to v(N + k) and a(N + k), on a virtual thread in the background and discards their contents;
+ * the query itself is answered by the underlying strategy right away. The clips that don't exist, i.e. the ones past
+ * the end of the media, end the warming.<br>
+ * The upcoming clips are queued and a single background thread per strategy warms them one at a time, so the read
+ * ahead never competes with the queries for more than one file at a time; the clips requested while a warming is in
+ * progress join the queue instead of being dropped. The queued and the recently warmed clips aren't queued again, and
+ * when the queue is full the eldest queued clips, the ones the viewers have most likely gone past, give way to the new
+ * ones. The environment variables are those of the underlying strategy, and closing this strategy closes the
+ * underlying one.
+ */
+public class ReadAheadQueryingStrategy implements QueryingStrategyInterface {
+
+	private static final Pattern CLIP_NAME = Pattern.compile("([av])(\\d+)");
+
+	private static final int WARMED_CLIPS_PER_READ_AHEAD_CLIP = 16;
+
+	private static final int QUEUED_CLIPS_PER_READ_AHEAD_CLIP = 8;
+
+	private static final int BUFFER_SIZE = 64 * 1024;
+
+	private final Logger logger = LoggerFactory.getLogger(ReadAheadQueryingStrategy.class);
+
+	private final QueryingStrategyInterface queryingStrategy;
+
+	private final int readAheadClips;
+
+	private final Map<String, Boolean> warmedClips;
+
+	// Guarded by the lock of warmedClips, as is warming
+	private final LinkedHashSet<String> queuedClips = new LinkedHashSet<>();
+
+	private final int queueCapacity;
+
+	private boolean warming;
+
+	private final LongAdder warmedBytes;
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param queryingStrategy the underlying strategy
+	 * @param readAheadClips the amount of upcoming clips of each kind to warm; must be positive
+	 */
+	public ReadAheadQueryingStrategy(@Nonnull QueryingStrategyInterface queryingStrategy, int readAheadClips) {
+		this(queryingStrategy, readAheadClips, new LongAdder());
+	}
+
+	/**
+	 * Constructs an instance of this class that adds the size of the warmed clips to a counter, which is usually
+	 * shared by all the strategies, so the warmed bytes are still counted once the strategy is closed.
+	 * @param queryingStrategy the underlying strategy
+	 * @param readAheadClips the amount of upcoming clips of each kind to warm; must be positive
+	 * @param warmedBytes the counter of the warmed bytes
+	 */
+	public ReadAheadQueryingStrategy(
+		@Nonnull QueryingStrategyInterface queryingStrategy, int readAheadClips, @Nonnull LongAdder warmedBytes
+	) {
+		if (readAheadClips < 1) throw new IllegalArgumentException("The amount of read ahead clips must be positive");
+		this.queryingStrategy = queryingStrategy;
+		this.readAheadClips = readAheadClips;
+		this.warmedBytes = warmedBytes;
+		int capacity = WARMED_CLIPS_PER_READ_AHEAD_CLIP * readAheadClips;
+		queueCapacity = QUEUED_CLIPS_PER_READ_AHEAD_CLIP * readAheadClips;
+		warmedClips = new LinkedHashMap<>(16, 0.75f, true) {
+			@Override
+			protected boolean removeEldestEntry(Map.Entry<String, Boolean> eldest) {
+				return size() > capacity;
+			}
+		};
+
+		logger.debug(
+			"{} instantiated, QueryingStrategyInterface: {}, readAheadClips: {}", this, queryingStrategy, readAheadClips
+		);
+	}
+
+	@Nullable
+	@Override
+	public Object addToEnvironment(@Nonnull String name, Object value) {
+		return queryingStrategy.addToEnvironment(name, value);
+	}
+
+	@Nullable
+	@Override
+	public Object removeFromEnvironment(@Nonnull String key) {
+		return queryingStrategy.removeFromEnvironment(key);
+	}
+
+	@Nonnull
+	@Override
+	public Map<String, Object> getEnvironment() {
+		return queryingStrategy.getEnvironment();
+	}
+
+	@Nonnull
+	@Override
+	public SeekableByteChannel query(@Nonnull String name) throws QueryingException {
+		SeekableByteChannel channel = queryingStrategy.query(name);
+		readAhead(new String[] {name});
+		return channel;
+	}
+
+	@Nonnull
+	@Override
+	public SeekableByteChannel[] query(@Nonnull String[] names) throws QueryingException {
+		SeekableByteChannel[] channels = queryingStrategy.query(names);
+		readAhead(names);
+		return channels;
+	}
+
+	@Override
+	public void close() throws Exception {
+		queryingStrategy.close();
+	}
+
+	/**
+	 * Returns the underlying strategy.
+	 * @return the underlying {@link QueryingStrategyInterface} instance
+	 */
+	@Nonnull
+	public QueryingStrategyInterface getQueryingStrategy() {
+		return queryingStrategy;
+	}
+
+	/**
+	 * Returns the total size of the clips read in the background, counted by the counter passed on construction.
+	 * @return the amount of warmed bytes
+	 */
+	public long getWarmedBytes() {
+		return warmedBytes.sum();
+	}
+
+	private void readAhead(String[] names) {
+		long lastVideoClip = -1, lastAudioClip = -1;
+		for (String name: names) {
+			Matcher matcher = CLIP_NAME.matcher(name);
+			if (!matcher.matches() || matcher.group(2).length() > 18) continue;
+			long index = Long.parseLong(matcher.group(2));
+			if (matcher.group(1).equals("v")) lastVideoClip = Math.max(lastVideoClip, index);
+			else lastAudioClip = Math.max(lastAudioClip, index);
+		}
+		synchronized (warmedClips) {
+			enqueueUpcomingClips("v", lastVideoClip);
+			enqueueUpcomingClips("a", lastAudioClip);
+			if (warming || queuedClips.isEmpty()) return;
+			warming = true;
+		}
+		Thread.ofVirtual().name("read-ahead").start(this::warm);
+	}
+
+	// Must be called while holding the lock of warmedClips
+	private void enqueueUpcomingClips(String kind, long lastClip) {
+		if (lastClip < 0) return;
+		for (long index = lastClip + 1; index <= lastClip + readAheadClips; index++) {
+			String name = kind + index;
+			if (warmedClips.containsKey(name) || !queuedClips.add(name)) continue;
+			if (queuedClips.size() > queueCapacity) queuedClips.removeFirst();
+		}
+	}
+
+	// Warms the queued clips until the queue is empty
+	private void warm() {
+		ByteBuffer buffer = ByteBuffer.allocate(BUFFER_SIZE);
+		while (true) {
+			String name;
+			synchronized (warmedClips) {
+				if (queuedClips.isEmpty()) {
+					warming = false;
+					return;
+				}
+				name = queuedClips.removeFirst();
+			}
+			try (SeekableByteChannel channel = queryingStrategy.query(name)) {
+				long read;
+				while ((read = channel.read(buffer.clear())) != -1) warmedBytes.add(read);
+				synchronized (warmedClips) {
+					warmedClips.put(name, Boolean.TRUE);
+				}
+			} catch (QueryingException e) {
+				dequeueClipsAfter(name);
+			} catch (Exception e) {
+				logger.debug("{} failed to read {} ahead", this, name, e);
+			}
+		}
+	}
+
+	// Drops the queued clips past a missing one of the same kind, as they're past the end of the media
+	private void dequeueClipsAfter(String missingClip) {
+		String kind = missingClip.substring(0, 1);
+		long missingIndex = Long.parseLong(missingClip.substring(1));
+		synchronized (warmedClips) {
+			Iterator<String> iterator = queuedClips.iterator();
+			while (iterator.hasNext()) {
+				String name = iterator.next();
+				if (name.startsWith(kind) && Long.parseLong(name.substring(1)) > missingIndex) iterator.remove();
+			}
+		}
+	}
+}
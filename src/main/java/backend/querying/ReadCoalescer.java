@@ -0,0 +1,181 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * ReadCoalescer tracks the reads of clips that are in flight, so the concurrent reads of the same clip share a single
+ * read of the underlying storage and a single in-memory payload. The first read of a clip leads the flight: it reads
+ * the clip and completes the flight with the payload. The reads of the clip that join the flight meanwhile wait for
+ * the payload instead of reading the clip themselves. A flight completed without a payload, e.g. because the clip
+ * is larger than {@link #getMaxPayloadSize()} or the leading read failed, tells the joined reads to read the clip
+ * on their own. A leader that no read has joined yet can abandon the flight instead, and read the clip without
+ * making a payload of it.<br>
+ * The coalescer counts the reads and the coalesced reads, the ones served with the payload of a flight they joined.
+ * The payloads are shared by all the readers and must not be modified.
+ */
+public class ReadCoalescer {
+
+	/**
+	 * The size of the largest shared payload in bytes if it's not configured.
+	 */
+	public static final long DEFAULT_MAX_PAYLOAD_SIZE = 16L * 1024 * 1024;
+
+	private final Logger logger = LoggerFactory.getLogger(ReadCoalescer.class);
+
+	private final long maxPayloadSize;
+
+	private final Map<ClipCache.Key, InFlightRead> inFlightReads = new ConcurrentHashMap<>();
+
+	private final LongAdder reads = new LongAdder();
+
+	private final LongAdder coalescedReads = new LongAdder();
+
+	/**
+	 * Flight is a read of a clip in flight as seen by one of its readers.
+	 * @param payload the future payload of the clip, which is null if the reader has to read the clip on its own
+	 * @param leading true if the reader leads the flight and must complete it
+	 */
+	public record Flight(CompletableFuture<byte[]> payload, boolean leading) { }
+
+	// The joined flag is only accessed while the map locks the key, so a read can't join a flight as it's abandoned
+	private static final class InFlightRead {
+
+		private final CompletableFuture<byte[]> payload = new CompletableFuture<>();
+
+		private boolean joined;
+	}
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param maxPayloadSize the size of the largest shared payload in bytes; must be positive
+	 */
+	public ReadCoalescer(long maxPayloadSize) {
+		if (maxPayloadSize <= 0 || maxPayloadSize > Integer.MAX_VALUE - 8) {
+			throw new IllegalArgumentException("The maximum payload size must be positive and fit into an array");
+		}
+		this.maxPayloadSize = maxPayloadSize;
+
+		logger.debug("{} instantiated, maxPayloadSize: {}", this, maxPayloadSize);
+	}
+
+	/**
+	 * Joins the flight of the clip, or starts a new one led by the caller if no read of the clip is in flight.
+	 * The leader must complete the flight with {@link #complete(ClipCache.Key, Flight, byte[])} in any case, before it
+	 * waits for any other flight.
+	 * @param key the key of the clip
+	 * @return the flight
+	 */
+	@Nonnull
+	public Flight join(@Nonnull ClipCache.Key key) {
+		reads.increment();
+		InFlightRead started = new InFlightRead();
+		InFlightRead inFlightRead = inFlightReads.compute(key, (k, read) -> {
+			if (read == null) return started;
+			read.joined = true;
+			return read;
+		});
+		return new Flight(inFlightRead.payload, inFlightRead == started);
+	}
+
+	/**
+	 * Abandons the flight led by the caller if no other read has joined it yet, so the caller can read the clip
+	 * without making a payload of it. The reads of the clip that come afterward start a new flight. If a read has
+	 * joined the flight, the flight isn't abandoned, and the caller must complete it as usual.
+	 * @param key the key of the clip
+	 * @param flight the flight
+	 * @return true if the flight is abandoned, false if another read has joined it
+	 */
+	public boolean abandon(@Nonnull ClipCache.Key key, @Nonnull Flight flight) {
+		boolean[] abandoned = new boolean[1];
+		inFlightReads.computeIfPresent(key, (k, read) -> {
+			if (read.payload != flight.payload() || read.joined) return read;
+			abandoned[0] = true;
+			return null;
+		});
+		if (abandoned[0]) flight.payload().complete(null);
+		return abandoned[0];
+	}
+
+	/**
+	 * Completes the flight led by the caller. Completing a completed flight has no effect.
+	 * @param key the key of the clip
+	 * @param flight the flight
+	 * @param payload the content of the clip, or null to make the joined reads read the clip on their own
+	 */
+	public void complete(@Nonnull ClipCache.Key key, @Nonnull Flight flight, @Nullable byte[] payload) {
+		inFlightReads.computeIfPresent(key, (k, read) -> read.payload == flight.payload() ? null : read);
+		flight.payload().complete(payload);
+	}
+
+	/**
+	 * Waits for the payload of the flight the caller joined.
+	 * @param flight the flight
+	 * @return the content of the clip, or null if the caller has to read the clip on its own
+	 */
+	@Nullable
+	public byte[] await(@Nonnull Flight flight) {
+		byte[] payload = flight.payload().join();
+		if (payload != null) coalescedReads.increment();
+		return payload;
+	}
+
+	/**
+	 * Returns the size of the largest shared payload.
+	 * @return the maximum payload size in bytes
+	 */
+	public long getMaxPayloadSize() {
+		return maxPayloadSize;
+	}
+
+	/**
+	 * Returns the amount of reads of clips, coalesced or not.
+	 * @return the amount of reads
+	 */
+	public long getReads() {
+		return reads.sum();
+	}
+
+	/**
+	 * Returns the amount of reads that were served with the payload of a concurrent read of the same clip.
+	 * @return the amount of coalesced reads
+	 */
+	public long getCoalescedReads() {
+		return coalescedReads.sum();
+	}
+
+	/**
+	 * Returns the share of the reads that were coalesced, or 0 if there were no reads.
+	 * @return the coalesce ratio
+	 */
+	public double getCoalesceRatio() {
+		long coalescedReadCount = getCoalescedReads();
+		long readCount = getReads();
+		return readCount == 0 ? 0 : (double) coalescedReadCount / readCount;
+	}
+}
@@ -0,0 +1,220 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import javax.crypto.Mac;
+import javax.crypto.spec.SecretKeySpec;
+import java.io.InputStream;
+import java.net.URI;
+import java.net.URLEncoder;
+import java.net.http.HttpClient;
+import java.net.http.HttpRequest;
+import java.net.http.HttpResponse;
+import java.nio.charset.StandardCharsets;
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
+import java.time.Duration;
+import java.time.Instant;
+import java.time.ZoneOffset;
+import java.time.format.DateTimeFormatter;
+import java.util.Arrays;
+import java.util.HexFormat;
+import java.util.SortedMap;
+import java.util.TreeMap;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executors;
+import java.util.stream.Collectors;
+
+/**
+ * S3Client sends requests for objects to an S3-compatible object storage, e.g. Amazon S3 or MinIO. The objects are
+ * addressed in the path style, i.e. as {endpoint}/{bucket}/{key}, which every S3-compatible storage supports. If
+ * the credentials are specified, the requests are signed with the AWS Signature Version 4; otherwise they are sent
+ * anonymously, which suits public buckets.<br>
+ * The requests are sent by a single {@link HttpClient}, which keeps the connections to the storage alive and reuses
+ * them, so an instance of this class is meant to be shared by all the strategies that read the same storage.
+ */
+public class S3Client implements AutoCloseable {
+
+	/**
+	 * The region used if it's not configured.
+	 */
+	public static final String DEFAULT_REGION = "us-east-1";
+
+	private static final String EMPTY_PAYLOAD_HASH =
+		"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+
+	private static final DateTimeFormatter AMZ_DATE_FORMATTER =
+		DateTimeFormatter.ofPattern("yyyyMMdd'T'HHmmss'Z'").withZone(ZoneOffset.UTC);
+
+	private final Logger logger = LoggerFactory.getLogger(S3Client.class);
+
+	private final URI endpoint;
+
+	private final String region;
+
+	private final String accessKey;
+
+	private final String secretKey;
+
+	private final HttpClient httpClient;
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param endpoint the URI of the storage, e.g. http://localhost:9000
+	 * @param region the region of the storage
+	 * @param accessKey the access key id, or null to send the requests anonymously
+	 * @param secretKey the secret access key, or null to send the requests anonymously
+	 */
+	public S3Client(
+		@Nonnull URI endpoint, @Nonnull String region, @Nullable String accessKey, @Nullable String secretKey
+	) {
+		if (endpoint.getScheme() == null || endpoint.getHost() == null) {
+			throw new IllegalArgumentException(endpoint + " isn't an absolute HTTP(S) URI");
+		}
+		if ((accessKey == null) != (secretKey == null)) {
+			throw new IllegalArgumentException("Either both or none of the access keys must be specified");
+		}
+		this.endpoint = endpoint;
+		this.region = region;
+		this.accessKey = accessKey;
+		this.secretKey = secretKey;
+		httpClient = HttpClient.newBuilder()
+			.version(HttpClient.Version.HTTP_1_1)
+			.connectTimeout(Duration.ofSeconds(10))
+			.executor(Executors.newVirtualThreadPerTaskExecutor())
+			.build();
+
+		logger.debug("{} instantiated, URI: {}, region: {}, signed: {}", this, endpoint, region, accessKey != null);
+	}
+
+	/**
+	 * Returns the endpoint of Amazon S3 in the region.
+	 * @param region the region
+	 * @return the URI of the endpoint
+	 */
+	@Nonnull
+	public static URI defaultEndpoint(@Nonnull String region) {
+		return URI.create("https://s3." + region + ".amazonaws.com");
+	}
+
+	/**
+	 * Requests the content of the object starting at the position. The response body is streamed, so it must be
+	 * closed once it's no longer read. The storage responds with the status 206 and the Content-Range header if it
+	 * honours the range, with the status 200 if it ignores the range, and with the status 416 if the position isn't
+	 * less than the size of the object.
+	 * @param bucket the bucket
+	 * @param key the key of the object
+	 * @param position the position of the first requested byte
+	 * @return the future response
+	 */
+	@Nonnull
+	public CompletableFuture<HttpResponse<InputStream>> get(
+		@Nonnull String bucket, @Nonnull String key, long position
+	) {
+		URI uri = URI.create(
+			endpoint.getScheme() + "://" + endpoint.getRawAuthority() + "/" + encode(bucket) + "/" + encodePath(key)
+		);
+		SortedMap<String, String> headers = new TreeMap<>();
+		headers.put("host", uri.getPort() == -1 ? uri.getHost() : uri.getHost() + ":" + uri.getPort());
+		headers.put("range", "bytes=" + position + "-");
+		headers.put("x-amz-content-sha256", EMPTY_PAYLOAD_HASH);
+		headers.put("x-amz-date", AMZ_DATE_FORMATTER.format(Instant.now()));
+
+		HttpRequest.Builder builder = HttpRequest.newBuilder(uri).GET().timeout(Duration.ofSeconds(30));
+		headers.forEach((name, value) -> {
+			if (!name.equals("host")) builder.header(name, value);
+		});
+		if (accessKey != null) builder.header("Authorization", authorization("GET", uri, headers));
+		return httpClient.sendAsync(builder.build(), HttpResponse.BodyHandlers.ofInputStream());
+	}
+
+	@Override
+	public void close() {
+		httpClient.close();
+	}
+
+	/**
+	 * Returns the value of the Authorization header that signs the request with the AWS Signature Version 4.
+	 * @param method the method of the request
+	 * @param uri the URI of the request, which has no query
+	 * @param headers the signed headers with lowercase names, which include host and x-amz-date
+	 * @return the value of the Authorization header
+	 */
+	String authorization(String method, URI uri, SortedMap<String, String> headers) {
+		String amzDate = headers.get("x-amz-date");
+		String scope = amzDate.substring(0, 8) + "/" + region + "/s3/aws4_request";
+		String signedHeaders = String.join(";", headers.keySet());
+		String canonicalRequest = String.join(
+			"\n",
+			method,
+			uri.getRawPath().isEmpty() ? "/" : uri.getRawPath(),
+			"",
+			headers
+				.entrySet()
+				.stream()
+				.map(header -> header.getKey() + ":" + header.getValue().strip() + "\n")
+				.collect(Collectors.joining()),
+			signedHeaders,
+			headers.getOrDefault("x-amz-content-sha256", EMPTY_PAYLOAD_HASH)
+		);
+		String stringToSign = String.join(
+			"\n", "AWS4-HMAC-SHA256", amzDate, scope, HexFormat.of().formatHex(sha256(canonicalRequest))
+		);
+		byte[] signingKey = ("AWS4" + secretKey).getBytes(StandardCharsets.UTF_8);
+		for (String part: new String[] {amzDate.substring(0, 8), region, "s3", "aws4_request"}) {
+			signingKey = hmacSha256(signingKey, part);
+		}
+		return "AWS4-HMAC-SHA256 Credential=" + accessKey + "/" + scope + ", SignedHeaders=" + signedHeaders +
+			", Signature=" + HexFormat.of().formatHex(hmacSha256(signingKey, stringToSign));
+	}
+
+	private static String encode(String segment) {
+		return URLEncoder.encode(segment, StandardCharsets.UTF_8)
+			.replace("+", "%20")
+			.replace("*", "%2A")
+			.replace("%7E", "~");
+	}
+
+	private static String encodePath(String path) {
+		return Arrays.stream(path.split("/", -1)).map(S3Client::encode).collect(Collectors.joining("/"));
+	}
+
+	private static byte[] sha256(String data) {
+		try {
+			return MessageDigest.getInstance("SHA-256").digest(data.getBytes(StandardCharsets.UTF_8));
+		} catch (GeneralSecurityException e) {
+			throw new IllegalStateException(e);
+		}
+	}
+
+	private static byte[] hmacSha256(byte[] key, String data) {
+		try {
+			Mac mac = Mac.getInstance("HmacSHA256");
+			mac.init(new SecretKeySpec(key, "HmacSHA256"));
+			return mac.doFinal(data.getBytes(StandardCharsets.UTF_8));
+		} catch (GeneralSecurityException e) {
+			throw new IllegalStateException(e);
+		}
+	}
+}
@@ -0,0 +1,198 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.adapters.RangedStreamChannel;
+import backend.exceptions.QueryingException;
+import jakarta.annotation.Nonnull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.io.FileNotFoundException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InterruptedIOException;
+import java.net.http.HttpResponse;
+import java.nio.channels.SeekableByteChannel;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+
+/**
+ * An implementation of {@link QueryingStrategyInterface} to query objects that are stored in a single bucket of
+ * an S3-compatible object storage under a common key prefix. The fully-qualified name of a resource is its key, i.e.
+ * the prefix and the simple name joined with a slash.<br>
+ * Every query is a ranged GET request sent by an {@link S3Client}; the objects of a batch query are requested
+ * concurrently. The returned channels stream the response bodies rather than buffering the objects, and changing
+ * the position of a channel sends a new ranged request starting at that position. If any object of a batch can't be
+ * queried, all the channels of the batch are closed.
+ */
+public class S3QueryingStrategy extends AbstractQueryingStrategy {
+
+	private final Logger logger = LoggerFactory.getLogger(S3QueryingStrategy.class);
+
+	private final S3Client s3Client;
+
+	private final String bucket;
+
+	private final String prefix;
+
+	/**
+	 * Constructs an instance of this class.
+	 * @param s3Client the {@link S3Client} instance that sends the requests
+	 * @param bucket the bucket the objects are stored in
+	 * @param prefix the common prefix of the keys of the objects, without the leading and trailing slashes; may be
+	 *               empty
+	 */
+	public S3QueryingStrategy(@Nonnull S3Client s3Client, @Nonnull String bucket, @Nonnull String prefix) {
+		if (bucket.isEmpty()) throw new IllegalArgumentException("The bucket name is empty");
+		this.s3Client = s3Client;
+		this.bucket = bucket;
+		this.prefix = prefix;
+
+		logger.debug("{} instantiated, S3Client: {}, bucket: {}, prefix: {}", this, s3Client, bucket, prefix);
+	}
+
+	@Nonnull
+	@Override
+	protected String compose(@Nonnull String... octets) {
+		StringBuilder sb = new StringBuilder(octets[0]);
+		for (int i = 1; i < octets.length; i++) {
+			if (!sb.isEmpty() && sb.charAt(sb.length() - 1) != '/') sb.append('/');
+			sb.append(octets[i]);
+		}
+		return sb.toString();
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel fullyQualifiedQuery(@Nonnull String fullyQualifiedName) throws QueryingException {
+		return fullyQualifiedQuery(new String[] {fullyQualifiedName})[0];
+	}
+
+	@Nonnull
+	@Override
+	protected SeekableByteChannel[] fullyQualifiedQuery(
+		@Nonnull String[] fullyQualifiedNames
+	) throws QueryingException {
+		List<CompletableFuture<HttpResponse<InputStream>>> responses = new ArrayList<>(fullyQualifiedNames.length);
+		for (String key: fullyQualifiedNames) responses.add(s3Client.get(bucket, key, 0));
+
+		SeekableByteChannel[] channels = new SeekableByteChannel[fullyQualifiedNames.length];
+		Exception exception = null;
+		for (int i = 0; i < fullyQualifiedNames.length; i++) {
+			try {
+				channels[i] = channelOf(fullyQualifiedNames[i], await(responses.get(i)));
+			} catch (Exception e) {
+				if (exception == null) exception = e;
+			}
+		}
+		if (exception != null) {
+			for (SeekableByteChannel channel: channels) {
+				try { if (channel != null) channel.close(); } catch (Exception ignored) { }
+			}
+			throw new QueryingException(exception);
+		}
+		return channels;
+	}
+
+	@Nonnull
+	@Override
+	public String getRoot() {
+		return prefix;
+	}
+
+	/**
+	 * Returns the bucket the objects are stored in.
+	 * @return the bucket
+	 */
+	@Nonnull
+	public String getBucket() {
+		return bucket;
+	}
+
+	private SeekableByteChannel channelOf(String key, HttpResponse<InputStream> response) throws IOException {
+		int status = response.statusCode();
+		// The storage responds to a range starting at 0 with 416 only if the object is empty
+		if (status == 416) {
+			response.body().close();
+			return new RangedStreamChannel(null, 0, position -> { throw new IOException("The object is empty"); });
+		}
+		InputStream body = body(key, response, 0);
+		try {
+			return new RangedStreamChannel(
+				body, sizeOf(response), position -> body(key, await(s3Client.get(bucket, key, position)), position)
+			);
+		} catch (IOException e) {
+			body.close();
+			throw e;
+		}
+	}
+
+	private InputStream body(String key, HttpResponse<InputStream> response, long position) throws IOException {
+		int status = response.statusCode();
+		if (status == 206) return response.body();
+		if (status == 200) {
+			// The storage ignored the range
+			InputStream body = response.body();
+			try {
+				body.skipNBytes(position);
+			} catch (IOException e) {
+				body.close();
+				throw e;
+			}
+			return body;
+		}
+		response.body().close();
+		if (status == 404) throw new FileNotFoundException(bucket + "/" + key + " doesn't exist");
+		throw new IOException("The storage responded to the request for " + bucket + "/" + key + " with " + status);
+	}
+
+	private static long sizeOf(HttpResponse<InputStream> response) throws IOException {
+		String contentRange = response.headers().firstValue("Content-Range").orElse(null);
+		try {
+			if (contentRange != null) {
+				String size = contentRange.substring(contentRange.lastIndexOf('/') + 1);
+				if (!size.equals("*")) return Long.parseLong(size);
+			}
+			if (response.statusCode() == 200) {
+				String contentLength = response.headers().firstValue("Content-Length").orElse(null);
+				if (contentLength != null) return Long.parseLong(contentLength);
+			}
+		} catch (NumberFormatException e) {
+			throw new IOException("The storage responded with an invalid size", e);
+		}
+		throw new IOException("The storage didn't respond with the size of the object");
+	}
+
+	private static HttpResponse<InputStream> await(
+		CompletableFuture<HttpResponse<InputStream>> response
+	) throws IOException {
+		try {
+			return response.get();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			response.thenAccept(r -> { try { r.body().close(); } catch (Exception ignored) { } });
+			throw new InterruptedIOException();
+		} catch (ExecutionException e) {
+			throw e.getCause() instanceof IOException cause ? cause : new IOException(e.getCause());
+		}
+	}
+}
@@ -23,6 +23,7 @@ import jakarta.annotation.Nonnull;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import java.io.EOFException;
 import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.nio.channels.ClosedChannelException;
@@ -85,6 +86,25 @@ public class ArraySeekableByteChannel implements SeekableByteChannel {
 		return byteRead;
 	}
 
+	/**
+	 * Returns a view of the next length bytes of this channel and advances the position by length. The data isn't
+	 * copied: the returned {@link ByteBuffer} is backed by the underlying array, so modifications of the array are
+	 * visible through the buffer.
+	 * @param length the amount of bytes the view contains
+	 * @return a {@link ByteBuffer} that is backed by the underlying array and whose position is 0
+	 * @throws IOException if this channel is closed
+	 * @throws EOFException if less than length bytes remain in this channel
+	 */
+	public synchronized ByteBuffer slice(int length) throws IOException {
+		if (!isOpen()) throw new ClosedChannelException();
+		if (length < 0) throw new IllegalArgumentException();
+		if (size() - position() < length) throw new EOFException();
+
+		ByteBuffer view = ByteBuffer.wrap(underlyingArray, underlyingArrayOffset + (int) position(), length).slice();
+		position(position() + length);
+		return view;
+	}
+
 	@Override
 	public int write(ByteBuffer byteBuffer) throws IOException {
 		throw new NonWritableChannelException();
@@ -27,6 +27,7 @@ import org.slf4j.LoggerFactory;
 import javax.sound.sampled.AudioInputStream;
 import javax.sound.sampled.AudioSystem;
 import java.io.ByteArrayInputStream;
+import java.nio.ByteBuffer;
 
 /**
  * AudioPlayerController links a particular instance of {@link AudioPlayerInterface} to an instance of
@@ -83,8 +84,10 @@ public class AudioPlayerController implements Observer {
 
 				boolean secondLapsed = lastTimestamp + 1 == videoPlayer.getProgress();
 				if (!videoPlayer.isBuffering() && (secondLapsed || audioPlayer.getBuffer().isEmpty())) {
-					byte[] audio = videoPlayer.getPlayingClip().audio();
-					AudioInputStream ais = AudioSystem.getAudioInputStream(new ByteArrayInputStream(audio));
+					ByteBuffer audio = videoPlayer.getPlayingClip().audio();
+					AudioInputStream ais = AudioSystem.getAudioInputStream(
+						new ByteArrayInputStream(audio.array(), audio.arrayOffset() + audio.position(), audio.remaining())
+					);
 					audioPlayer.getBuffer().add(ais.readAllBytes());
 				}
 				lastTimestamp = videoPlayer.getProgress();
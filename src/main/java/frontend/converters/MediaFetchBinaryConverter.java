@@ -24,17 +24,18 @@ import frontend.models.MediaFetch;
 import jakarta.annotation.Nonnull;
 import org.bson.*;
 import org.bson.codecs.BsonDocumentCodec;
-import org.bson.codecs.DecoderContext;
 import org.bson.codecs.EncoderContext;
 import org.bson.io.BasicOutputBuffer;
 
+import java.io.EOFException;
 import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.nio.channels.SeekableByteChannel;
 import java.util.ArrayList;
 
 /**
- * Converts {@link MediaFetch} from/into binary format.
+ * Converts {@link MediaFetch} from/into binary format. If the input is an {@link ArraySeekableByteChannel}, the clips
+ * of the decoded {@link MediaFetch} are views of its underlying array, so the clip data isn't copied.
  */
 public class MediaFetchBinaryConverter implements BinaryConverter<MediaFetch> {
 
@@ -46,14 +47,14 @@ public class MediaFetchBinaryConverter implements BinaryConverter<MediaFetch> {
 		bsonDocument.put("offset", new BsonInt32(input.offset()));
 
 		ArrayList<BsonBinary> video = new ArrayList<>();
-		for (byte[] channel: input.video()) {
-			video.add(new BsonBinary(channel));
+		for (ByteBuffer clip: input.video()) {
+			video.add(new BsonBinary(toByteArray(clip)));
 		}
 		bsonDocument.put("video", new BsonArray(video));
 
 		ArrayList<BsonBinary> audio = new ArrayList<>();
-		for (byte[] channel: input.audio()) {
-			audio.add(new BsonBinary(channel));
+		for (ByteBuffer clip: input.audio()) {
+			audio.add(new BsonBinary(toByteArray(clip)));
 		}
 		bsonDocument.put("audio", new BsonArray(audio));
 
@@ -70,29 +71,61 @@ public class MediaFetchBinaryConverter implements BinaryConverter<MediaFetch> {
 	@Nonnull
 	@Override
 	public MediaFetch convert(@Nonnull SeekableByteChannel input) throws IOException {
-		ByteBuffer byteBuffer = ByteBuffer.allocate((int) input.size());
-		input.read(byteBuffer);
-		byteBuffer.flip();
+		ByteBuffer byteBuffer = readSlice(input, (int) (input.size() - input.position()));
 
-		try (BsonBinaryReader bsonBinaryReader = new BsonBinaryReader(byteBuffer)) {
-			BsonDocumentCodec bsonDocumentCodec = new BsonDocumentCodec();
-			BsonDocument bsonDocument = bsonDocumentCodec.decode(bsonBinaryReader, DecoderContext.builder().build());
-			byte[][] video = bsonDocument
-				.getArray("video")
-				.stream()
-				.map(bsonValue -> bsonValue.asBinary().getData())
-				.toArray(byte[][]::new);
-			byte[][] audio = bsonDocument
-				.getArray("audio")
-				.stream()
-				.map(bsonValue -> bsonValue.asBinary().getData())
-				.toArray(byte[][]::new);
-			return new MediaFetch(
-				bsonDocument.getString("id").getValue(),
-				bsonDocument.getInt32("offset").getValue(),
-				video,
-				audio
-			);
+		try (BsonBinaryReader bsonBinaryReader = new BsonBinaryReader(byteBuffer.duplicate())) {
+			String id = null;
+			int offset = 0;
+			ByteBuffer[] video = new ByteBuffer[0];
+			ByteBuffer[] audio = new ByteBuffer[0];
+			bsonBinaryReader.readStartDocument();
+			while (bsonBinaryReader.readBsonType() != BsonType.END_OF_DOCUMENT) {
+				switch (bsonBinaryReader.readName()) {
+					case "id" -> id = bsonBinaryReader.readString();
+					case "offset" -> offset = bsonBinaryReader.readInt32();
+					case "video" -> video = readClips(bsonBinaryReader, byteBuffer);
+					case "audio" -> audio = readClips(bsonBinaryReader, byteBuffer);
+					default -> bsonBinaryReader.skipValue();
+				}
+			}
+			bsonBinaryReader.readEndDocument();
+			if (id == null) throw new BsonSerializationException("The id field is absent");
+			return new MediaFetch(id, offset, video, audio);
+		}
+	}
+
+	/**
+	 * Reads an array of binary values and returns them as views of document. Instead of reading the values, the reader
+	 * only skips them, so the data isn't copied.
+	 */
+	private ByteBuffer[] readClips(BsonBinaryReader bsonBinaryReader, ByteBuffer document) {
+		ArrayList<ByteBuffer> clips = new ArrayList<>();
+		bsonBinaryReader.readStartArray();
+		while (bsonBinaryReader.readBsonType() != BsonType.END_OF_DOCUMENT) {
+			int size = bsonBinaryReader.peekBinarySize();
+			// the value starts with the int32 size followed by the subtype byte
+			int dataPosition = bsonBinaryReader.getBsonInput().getPosition() + 4 + 1;
+			bsonBinaryReader.skipValue();
+			clips.add(document.slice(dataPosition, size));
+		}
+		bsonBinaryReader.readEndArray();
+		return clips.toArray(ByteBuffer[]::new);
+	}
+
+	private ByteBuffer readSlice(SeekableByteChannel input, int length) throws IOException {
+		if (input instanceof ArraySeekableByteChannel arraySeekableByteChannel) {
+			return arraySeekableByteChannel.slice(length);
+		}
+		ByteBuffer byteBuffer = ByteBuffer.allocate(length);
+		while (byteBuffer.hasRemaining()) {
+			if (input.read(byteBuffer) == -1) throw new EOFException();
 		}
+		return byteBuffer.flip();
+	}
+
+	private byte[] toByteArray(ByteBuffer clip) {
+		byte[] array = new byte[clip.remaining()];
+		clip.duplicate().get(array);
+		return array;
 	}
 }
@@ -0,0 +1,140 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package frontend.converters;
+
+import frontend.adapters.ArraySeekableByteChannel;
+import frontend.models.MediaFetch;
+import jakarta.annotation.Nonnull;
+
+import java.io.EOFException;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.SeekableByteChannel;
+import java.util.UUID;
+
+/**
+ * Converts {@link MediaFetch} from/into the framed binary format. All numbers are big-endian. The message consists
+ * of:<br>
+ * 1. The fixed header: the magic number {@link #MAGIC} (4 bytes), the format version (2 bytes), the most and
+ * the least significant bits of the media id (8 + 8 bytes), the offset (4 bytes), and the amount of clips (4 bytes).
+ * <br>
+ * 2. The index table: the video clip size and the audio clip size (4 + 4 bytes) for every clip.<br>
+ * 3. The payloads: the video clip followed by the audio clip for every clip, in the order of the index table.<br>
+ * If the input is an {@link ArraySeekableByteChannel}, the clips of the decoded {@link MediaFetch} are views of its
+ * underlying array, so the clip data isn't copied.
+ */
+public class MediaFetchFramedBinaryConverter implements BinaryConverter<MediaFetch> {
+
+	/**
+	 * The media type of the framed format.
+	 */
+	public static final String MEDIA_TYPE = "application/vnd.rubus.fetch";
+
+	/**
+	 * The magic number every message in the framed format starts with; it's "RUBF" in ASCII.
+	 */
+	public static final int MAGIC = 0x52554246;
+
+	/**
+	 * The version of the framed format this converter produces and accepts.
+	 */
+	public static final short VERSION = 1;
+
+	private static final int HEADER_SIZE = 4 + 2 + 8 + 8 + 4 + 4;
+
+	@Nonnull
+	@Override
+	public SeekableByteChannel convert(@Nonnull MediaFetch input) throws IOException {
+		if (input.video().length != input.audio().length) {
+			throw new IOException("The amounts of video and audio clips differ");
+		}
+
+		int clipAmount = input.video().length;
+		long messageSize = HEADER_SIZE + clipAmount * 8L;
+		for (int i = 0; i < clipAmount; i++) {
+			messageSize += input.video()[i].remaining() + input.audio()[i].remaining();
+		}
+		if (messageSize > Integer.MAX_VALUE) throw new IOException("The message is too large");
+
+		UUID id = UUID.fromString(input.id());
+		ByteBuffer message = ByteBuffer.allocate((int) messageSize);
+		message
+			.putInt(MAGIC)
+			.putShort(VERSION)
+			.putLong(id.getMostSignificantBits())
+			.putLong(id.getLeastSignificantBits())
+			.putInt(input.offset())
+			.putInt(clipAmount);
+		for (int i = 0; i < clipAmount; i++) {
+			message.putInt(input.video()[i].remaining()).putInt(input.audio()[i].remaining());
+		}
+		for (int i = 0; i < clipAmount; i++) {
+			message.put(input.video()[i].duplicate()).put(input.audio()[i].duplicate());
+		}
+		return new ArraySeekableByteChannel(message.array());
+	}
+
+	@Nonnull
+	@Override
+	public MediaFetch convert(@Nonnull SeekableByteChannel input) throws IOException {
+		ByteBuffer header = readSlice(input, HEADER_SIZE);
+		if (header.getInt() != MAGIC) throw new IOException("The message isn't in the framed format");
+		short version = header.getShort();
+		if (version != VERSION) throw new IOException("Unsupported framed format version: " + version);
+		UUID id = new UUID(header.getLong(), header.getLong());
+		int offset = header.getInt();
+		int clipAmount = header.getInt();
+		// The amounts and the sizes come from the input, so they are checked against its size before allocating
+		long remaining = input.size() - input.position();
+		if (clipAmount < 0 || clipAmount * 8L > remaining) {
+			throw new IOException("Invalid amount of clips: " + clipAmount);
+		}
+		remaining -= clipAmount * 8L;
+
+		ByteBuffer index = readSlice(input, clipAmount * 8);
+		int[] videoSizes = new int[clipAmount];
+		int[] audioSizes = new int[clipAmount];
+		for (int i = 0; i < clipAmount; i++) {
+			videoSizes[i] = index.getInt();
+			audioSizes[i] = index.getInt();
+			if (videoSizes[i] < 0 || audioSizes[i] < 0) throw new IOException("Negative clip size");
+			remaining -= (long) videoSizes[i] + audioSizes[i];
+		}
+		if (remaining < 0) throw new IOException("The clip sizes exceed the size of the message");
+		ByteBuffer[] video = new ByteBuffer[clipAmount];
+		ByteBuffer[] audio = new ByteBuffer[clipAmount];
+		for (int i = 0; i < clipAmount; i++) {
+			video[i] = readSlice(input, videoSizes[i]);
+			audio[i] = readSlice(input, audioSizes[i]);
+		}
+		return new MediaFetch(id.toString(), offset, video, audio);
+	}
+
+	private ByteBuffer readSlice(SeekableByteChannel input, int length) throws IOException {
+		if (input instanceof ArraySeekableByteChannel arraySeekableByteChannel) {
+			return arraySeekableByteChannel.slice(length);
+		}
+		ByteBuffer byteBuffer = ByteBuffer.allocate(length);
+		while (byteBuffer.hasRemaining()) {
+			if (input.read(byteBuffer) == -1) throw new EOFException();
+		}
+		return byteBuffer.flip();
+	}
+}
@@ -31,7 +31,7 @@ import org.bson.io.BasicOutputBuffer;
 import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.nio.channels.SeekableByteChannel;
-import java.util.HashMap;
+import java.util.LinkedHashMap;
 
 /**
  * Converts {@link MediaList} to/from binary format.
@@ -51,6 +51,7 @@ public class MediaListBinaryConverter implements BinaryConverter<MediaList> {
 				.toList()
 		);
 		bsonDocument.put("media", media);
+		if (input.cursor() != null) bsonDocument.put("cursor", new BsonString(input.cursor()));
 
 		try (
 			BasicOutputBuffer basicOutputBuffer = new BasicOutputBuffer();
@@ -73,12 +74,13 @@ public class MediaListBinaryConverter implements BinaryConverter<MediaList> {
 			BsonDocumentCodec bsonDocumentCodec = new BsonDocumentCodec();
 			BsonDocument bsonDocument = bsonDocumentCodec.decode(bsonBinaryReader, DecoderContext.builder().build());
 			BsonDocument media = bsonDocument.getDocument("media");
+			BsonString cursor = bsonDocument.getString("cursor", null);
 			return new MediaList(
 				media
 					.entrySet()
 					.stream()
 					.reduce(
-						new HashMap<>(),
+						new LinkedHashMap<>(),
 						(map, entry) -> {
 							map.put(entry.getKey(), entry.getValue().asString().getValue());
 							return map;
@@ -87,7 +89,8 @@ public class MediaListBinaryConverter implements BinaryConverter<MediaList> {
 							map1.putAll(map2);
 							return map1;
 						}
-					)
+					),
+				cursor == null ? null : cursor.getValue()
 			);
 		}
 	}
@@ -19,6 +19,8 @@
 
 package frontend.decoders;
 
+import java.nio.ByteBuffer;
+
 /**
  * Decoder provides an interface the client uses to decode an abstract entity, which, for example, can be a video or
  * audio stream stored in a container. The implementations need to specify a data structure that describes decoded
@@ -30,13 +32,15 @@ package frontend.decoders;
  * is used for successive operations related to the entity. That allows the user to queue decoding of several entities.
  * Think of Decoder as a hash-map, where the integer is a key, which can be used to retrieve the decoded frames or
  * inquire if the decoding of that particular entity is complete.<br>
+ * An encoded entity is passed as the remaining content of a {@link ByteBuffer}, so it can be a view of a larger
+ * message; the implementations must not modify the position or the limit of the buffer.<br>
  * The concrete implementations may also want to implement the {@link StreamContext} and {@link LocalContext}
  * interfaces to accelerate decoding process. {@link StreamContext} may be used to store general information shared
  * across several entities, so they can be viewed as part of a stream. For example if the entity is a small video clip
  * and these video clips constitute a single video that has a certain frame-rate, resolution, container type, codec,
  * etc., these properties can be stored in {@link StreamContext}. {@link LocalContext}, on the other hand, stores
  * information related specifically to that entity. It can be used to perform several operations on that entity like
- * {@link #startDecodingOfNFrames(int, LocalContext, byte[], int, int)}.<br><br>
+ * {@link #startDecodingOfNFrames(int, LocalContext, ByteBuffer, int, int)}.<br><br>
  *
  * Here is a scenario of how Decoder can be used:
  * <pre>
@@ -85,7 +89,7 @@ public interface Decoder <T> extends AutoCloseable {
 	 * @param streamContext the stream context
 	 * @param media the entity
 	 */
-	void startDecodingOfAllFrames(int id, StreamContext streamContext, byte[] media);
+	void startDecodingOfAllFrames(int id, StreamContext streamContext, ByteBuffer media);
 
 	/**
 	 * Begins decoding of frames of the specified range of the entity. The actual number of decoded frames may exceed
@@ -99,12 +103,12 @@ public interface Decoder <T> extends AutoCloseable {
 	 * @param offset the number of frames to skip
 	 * @param total the number of frames to decode
 	 */
-	void startDecodingOfNFrames(int id, LocalContext localContext, byte[] media, int offset, int total);
+	void startDecodingOfNFrames(int id, LocalContext localContext, ByteBuffer media, int offset, int total);
 
 	/**
 	 * Returns the decoded frames if the decoding has been completed. If the decoding has not been completed, or it
-	 * hasn't been started via {@link #startDecodingOfAllFrames(int, StreamContext, byte[])}, or
-	 * {@link #startDecodingOfNFrames(int, LocalContext, byte[], int, int)}, or an exception occurred during the
+	 * hasn't been started via {@link #startDecodingOfAllFrames(int, StreamContext, ByteBuffer)}, or
+	 * {@link #startDecodingOfNFrames(int, LocalContext, ByteBuffer, int, int)}, or an exception occurred during the
 	 * decoding null is returned.
 	 * @param id the entity id
 	 * @return the decoded frames if the decoding has been completed, null otherwise
@@ -113,8 +117,8 @@ public interface Decoder <T> extends AutoCloseable {
 
 	/**
 	 * Returns the decoded frames if the decoding has been completed or blocks until it has. If the decoding hasn't been
-	 * started via {@link #startDecodingOfAllFrames(int, StreamContext, byte[])}, or
-	 * {@link #startDecodingOfNFrames(int, LocalContext, byte[], int, int)}, or an exception occurred during
+	 * started via {@link #startDecodingOfAllFrames(int, StreamContext, ByteBuffer)}, or
+	 * {@link #startDecodingOfNFrames(int, LocalContext, ByteBuffer, int, int)}, or an exception occurred during
 	 * the decoding null is returned.
 	 * @param id the entity id
 	 * @return the decoded frames if the decoding went properly, null otherwise
@@ -172,19 +176,19 @@ public interface Decoder <T> extends AutoCloseable {
 	 * it can be retrieved via {@link #getStreamContextInitializationException()}.
 	 * @param media an encoded entity containing properties shared across all entities of a stream
 	 */
-	void startStreamContextInitialization(byte[] media);
+	void startStreamContextInitialization(ByteBuffer media);
 
 	/**
 	 * Returns the stream context if the initialization has been completed. If the initialization has not been
-	 * completed, or hasn't been started via {@link #startStreamContextInitialization(byte[])}, or an exception occurred
-	 * during the initialization null is returned.
+	 * completed, or hasn't been started via {@link #startStreamContextInitialization(ByteBuffer)}, or an exception
+	 * occurred during the initialization null is returned.
 	 * @return the stream context if the initialization has been completed, null otherwise
 	 */
 	StreamContext getStreamContext();
 
 	/**
 	 * Returns the stream context if the initialization has completed or blocks until it has. If the initialization
-	 * hasn't been started via {@link #startStreamContextInitialization(byte[])}, or an exception occurred during
+	 * hasn't been started via {@link #startStreamContextInitialization(ByteBuffer)}, or an exception occurred during
 	 * the initialization, null is returned.
 	 * @return the stream context if the initialization went properly, null otherwise
 	 * @throws InterruptedException if the current thread has been interrupted while waiting
@@ -204,20 +208,20 @@ public interface Decoder <T> extends AutoCloseable {
 	 * @param media an encoded entity containing properties unique to that entity
 	 * @param streamContext the stream context of the specified entity
 	 */
-	void startLocalContextInitialization(byte[] media, StreamContext streamContext);
+	void startLocalContextInitialization(ByteBuffer media, StreamContext streamContext);
 
 	/**
-	 * Returns the local context if the initialization has been completed. If the initialization has not been completed,
-	 * or it hasn't been started via {@link #startLocalContextInitialization(byte[], StreamContext)}, or an exception
-	 * occurred during the initialization null is returned.
+	 * Returns the local context if the initialization has been completed. If the initialization has not been
+	 * completed, or it hasn't been started via {@link #startLocalContextInitialization(ByteBuffer, StreamContext)}, or
+	 * an exception occurred during the initialization null is returned.
 	 * @return the local context if the initialization has been completed, null otherwise
 	 */
 	LocalContext getLocalContext();
 
 	/**
 	 * Returns the local context if the initialization has been completed or blocks until it has. If the initialization
-	 * hasn't been started via {@link #startLocalContextInitialization(byte[], StreamContext)}, or an exception occurred
-	 * during the initialization, null is returned.
+	 * hasn't been started via {@link #startLocalContextInitialization(ByteBuffer, StreamContext)}, or an exception
+	 * occurred during the initialization, null is returned.
 	 * @return the local context if the initialization went properly, null otherwise.
 	 * @throws InterruptedException if the current thread has been interrupted while waiting
 	 */
@@ -23,6 +23,7 @@ import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
 import java.awt.*;
+import java.nio.ByteBuffer;
 import java.util.HashMap;
 import java.util.Map;
 import java.util.concurrent.*;
@@ -46,12 +47,18 @@ import java.util.concurrent.*;
 public class FfmpegJniVideoDecoder extends VideoDecoder {
 
 	private native Object[] decodeFrames(
-		long contextAddress, int contextType, byte[] encodedVideo, int offset, int total
+		long contextAddress,
+		int contextType,
+		byte[] encodedVideo,
+		int encodedVideoOffset,
+		int encodedVideoLength,
+		int offset,
+		int total
 	);
 
 	private native int frames(long contextAddress, int contextType);
 
-	private native long initContext(byte[] vid, int contextType);
+	private native long initContext(byte[] vid, int vidOffset, int vidLength, int contextType);
 
 	private native void freeContext(long contextAddress, int contextType);
 
@@ -70,15 +77,18 @@ public class FfmpegJniVideoDecoder extends VideoDecoder {
 	}
 
 	@Override
-	public void startDecodingOfAllFrames(int id, StreamContext streamContext, byte[] media) {
+	public void startDecodingOfAllFrames(int id, StreamContext streamContext, ByteBuffer media) {
 		assert streamContext instanceof StreamContextImpl && !streamContext.isClosed() && media != null;
 
 		Future<DecodedFrames> future = executorService.submit(() -> {
 			StreamContextImpl streamContextImpl = (StreamContextImpl) streamContext;
+			ByteBuffer video = heapView(media);
 			Object[] frames = decodeFrames(
 				streamContextImpl.getStreamContextMemoryAddress(),
 				0,
-				media,
+				video.array(),
+				video.arrayOffset() + video.position(),
+				video.remaining(),
 				0,
 				frames(streamContextImpl.getStreamContextMemoryAddress(), 0)
 			);
@@ -88,11 +98,11 @@ public class FfmpegJniVideoDecoder extends VideoDecoder {
 	}
 
 	/**
-	 * Delegates the call to {@link #startDecodingOfAllFrames(int, StreamContext, byte[])}, so it's equivalent to
+	 * Delegates the call to {@link #startDecodingOfAllFrames(int, StreamContext, ByteBuffer)}, so it's equivalent to
 	 * startDecodingOfAllFrames(id, localContext.getStreamContext, media)
 	 */
 	@Override
-	public void startDecodingOfNFrames(int id, LocalContext localContext, byte[] media, int offset, int total) {
+	public void startDecodingOfNFrames(int id, LocalContext localContext, ByteBuffer media, int offset, int total) {
 		assert
 			localContext instanceof LocalContextImpl &&
 			!localContext.getStreamContext().isClosed() &&
@@ -161,10 +171,15 @@ public class FfmpegJniVideoDecoder extends VideoDecoder {
 	}
 
 	@Override
-	public void startStreamContextInitialization(byte[] media) {
+	public void startStreamContextInitialization(ByteBuffer media) {
 		assert media != null;
 
-		streamContextFuture = executorService.submit(() -> new StreamContextImpl(initContext(media, 0)));
+		streamContextFuture = executorService.submit(() -> {
+			ByteBuffer video = heapView(media);
+			return new StreamContextImpl(
+				initContext(video.array(), video.arrayOffset() + video.position(), video.remaining(), 0)
+			);
+		});
 	}
 
 	@Override
@@ -197,7 +212,7 @@ public class FfmpegJniVideoDecoder extends VideoDecoder {
 	}
 
 	@Override
-	public void startLocalContextInitialization(byte[] media, StreamContext streamContext) {
+	public void startLocalContextInitialization(ByteBuffer media, StreamContext streamContext) {
 		assert streamContext instanceof StreamContextImpl && !streamContext.isClosed();
 
 		localContext = new LocalContextImpl((StreamContextImpl) streamContext);
@@ -309,6 +324,16 @@ public class FfmpegJniVideoDecoder extends VideoDecoder {
 		}
 	}
 
+	/**
+	 * The native code reads the encoded video from a Java array at the specified offset, so only the buffers without
+	 * an accessible array are copied.
+	 */
+	private static ByteBuffer heapView(ByteBuffer media) {
+		if (media.hasArray()) return media;
+		ByteBuffer copy = ByteBuffer.allocate(media.remaining());
+		return copy.put(media.duplicate()).flip();
+	}
+
 	private class LocalContextImpl implements LocalContext {
 
 		private final Logger logger = LoggerFactory.getLogger(LocalContextImpl.class);
@@ -42,6 +42,7 @@ import java.awt.*;
 import java.awt.event.WindowAdapter;
 import java.awt.event.WindowEvent;
 import java.io.ByteArrayInputStream;
+import java.nio.ByteBuffer;
 import java.time.Duration;
 import java.time.temporal.ChronoUnit;
 import java.util.function.Supplier;
@@ -167,8 +168,10 @@ public class MainFrame extends JFrame {
 
 			request = rubusClient.getRequestBuilder().FETCH(id, 0, 1).build();
 			response = rubusClient.send(request, 10000);
-			byte[] audio = response.FETCH().audio()[0];
-			AudioFormat audioFormat = AudioSystem.getAudioFileFormat(new ByteArrayInputStream(audio)).getFormat();
+			ByteBuffer audio = response.FETCH().audio()[0];
+			AudioFormat audioFormat = AudioSystem.getAudioFileFormat(
+				new ByteArrayInputStream(audio.array(), audio.arrayOffset() + audio.position(), audio.remaining())
+			).getFormat();
 			audioPlayer = new AudioPlayer(audioFormat);
 
 			if (player != null) {
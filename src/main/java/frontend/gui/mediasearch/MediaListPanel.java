@@ -40,6 +40,12 @@ public class MediaListPanel extends JPanel {
 
 	private final Font finePrint;
 
+	private final MediaSearchDialog mediaSearchDialog;
+
+	private final MainFrame mainFrame;
+
+	private JButton showMoreButton;
+
 	public MediaListPanel(
 		MediaSearchDialog mediaSearchDialog,
 		MainFrame mainFrame,
@@ -49,10 +55,36 @@ public class MediaListPanel extends JPanel {
 		assert mediaSearchDialog != null && mainFrame != null && list != null && watchHistory != null;
 
 		wh = watchHistory;
+		this.mediaSearchDialog = mediaSearchDialog;
+		this.mainFrame = mainFrame;
 		finePrint = new Font(getFont().getName(), Font.ITALIC, (int) (getFont().getSize() / 1.3));
 
 		setLayout(new BoxLayout(this, BoxLayout.Y_AXIS));
 
+		append(list);
+
+		logger.debug(
+			"{} instantiated, MediaSearchDialog: {}, MainFrame: {}, MediaList: {}, WatchHistory: {}",
+			this,
+			mediaSearchDialog,
+			mainFrame,
+			list,
+			watchHistory
+		);
+	}
+
+	/**
+	 * Adds the media of the page after the media already shown. If the page is followed by other pages, a button that
+	 * loads the next page is shown below the media.
+	 * @param list the page of media
+	 */
+	public void append(MediaList list) {
+		assert list != null;
+
+		if (showMoreButton != null) {
+			remove(showMoreButton);
+			showMoreButton = null;
+		}
 		for(Map.Entry<String, String> media: list.media().entrySet()) {
 			JPanel mediaPanel = createMediaPanel(media.getValue(), media.getKey());
 			mediaPanel.addMouseListener(new MouseAdapter() {
@@ -79,15 +111,17 @@ public class MediaListPanel extends JPanel {
 			add(mediaPanel);
 			add(Box.createRigidArea(new Dimension(0, 10)));
 		}
-
-		logger.debug(
-			"{} instantiated, MediaSearchDialog: {}, MainFrame: {}, MediaList: {}, WatchHistory: {}",
-			this,
-			mediaSearchDialog,
-			mainFrame,
-			list,
-			watchHistory
-		);
+		if (list.cursor() != null) {
+			showMoreButton = new JButton("Show more");
+			showMoreButton.setAlignmentX(Component.CENTER_ALIGNMENT);
+			showMoreButton.addActionListener(e -> {
+				showMoreButton.setEnabled(false);
+				mediaSearchDialog.loadNextPage(this, list.cursor());
+			});
+			add(showMoreButton);
+		}
+		revalidate();
+		repaint();
 	}
 
 	private JPanel createMediaPanel(String title, String id) {
@@ -36,10 +36,33 @@ import java.awt.*;
 import java.awt.event.KeyAdapter;
 import java.awt.event.KeyEvent;
 import java.io.IOException;
+import java.util.Map;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.atomic.AtomicLong;
 import java.util.function.Supplier;
 
 public class MediaSearchDialog extends CenteredDialog implements Runnable {
 
+	/**
+	 * The maximum amount of media requested at once. The following pages are requested when the user asks for them.
+	 */
+	public static final int PAGE_SIZE = 50;
+
+	/**
+	 * The maximum amount of media suggested while the user is typing.
+	 */
+	public static final int SUGGESTION_LIMIT = 20;
+
+	/**
+	 * The amount of milliseconds the user has to stop typing for before suggestions are requested.
+	 */
+	public static final int SUGGESTION_DELAY = 150;
+
+	/**
+	 * The minimum length of the typed text suggestions are requested for; the server rejects shorter prefixes.
+	 */
+	public static final int MIN_SUGGESTION_PREFIX_LENGTH = 3;
+
 	private final Logger logger = LoggerFactory.getLogger(MediaSearchDialog.class);
 
 	private final MainFrame mainFrame;
@@ -52,6 +75,12 @@ public class MediaSearchDialog extends CenteredDialog implements Runnable {
 
 	private final JScrollPane scrollPane;
 
+	private final Timer suggestionTimer;
+
+	private final AtomicLong suggestionSequence = new AtomicLong();
+
+	private String searchQuery = "";
+
 	public MediaSearchDialog(MainFrame parent, Supplier<RubusClient> rubusClientSupplier, WatchHistory watchHistory) {
 		super(parent, "New video", true, parent.getWidth() / 2, parent.getHeight());
 		assert rubusClientSupplier != null && watchHistory != null;
@@ -75,10 +104,16 @@ public class MediaSearchDialog extends CenteredDialog implements Runnable {
 			@Override
 			public void keyTyped(KeyEvent e) {
 				if (e.getKeyChar() == '\n') {
+					suggestionTimer.stop();
+					suggestionSequence.incrementAndGet();
 					new Thread(MediaSearchDialog.this).start();
+				} else {
+					suggestionTimer.restart();
 				}
 			}
 		});
+		suggestionTimer = new Timer(SUGGESTION_DELAY, e -> suggest(searchTF.getText()));
+		suggestionTimer.setRepeats(false);
 		constraints.weightx = 4;
 		constraints.fill = GridBagConstraints.HORIZONTAL;
 		constraints.gridwidth = GridBagConstraints.REMAINDER;
@@ -109,16 +144,9 @@ public class MediaSearchDialog extends CenteredDialog implements Runnable {
 
 	@Override
 	public synchronized void run() {
-		try (RubusClient rubusClient = rubusCleintSupplier.get()) {
-			RubusRequest.Builder requestBuilder = rubusClient.getRequestBuilder();
-			requestBuilder.LIST(searchTF.getText());
-			RubusResponse response = rubusClient.send(requestBuilder.build(), 10000);
-			if (response.getResponseType() != RubusResponseType.OK) {
-				throw new IOException(
-					"Couldn't fetch data from server, response code: " + response.getResponseType()
-				);
-			}
-			MediaList mediaList = response.LIST();
+		try {
+			searchQuery = searchTF.getText();
+			MediaList mediaList = requestPage(searchQuery, null);
 
 			SwingUtilities.invokeLater(() -> {
 				scrollPane.setViewportView(new MediaListPanel(this, mainFrame, mediaList, watchHistory));
@@ -137,4 +165,79 @@ public class MediaSearchDialog extends CenteredDialog implements Runnable {
 			logger.info("{} couldn't retrieve result from server", this, e);
 		}
 	}
+
+	/**
+	 * Requests the page that follows the one the cursor belongs to in the background and appends it to the panel.
+	 * @param mediaListPanel the panel that shows the previous pages
+	 * @param cursor the cursor of the previous page
+	 */
+	public void loadNextPage(MediaListPanel mediaListPanel, String cursor) {
+		assert mediaListPanel != null && cursor != null;
+
+		new SwingWorker<MediaList, Void>() {
+			@Override
+			protected MediaList doInBackground() throws Exception {
+				synchronized (MediaSearchDialog.this) {
+					return requestPage(searchQuery, cursor);
+				}
+			}
+
+			@Override
+			protected void done() {
+				try {
+					mediaListPanel.append(get());
+				} catch (InterruptedException | ExecutionException e) {
+					Throwable cause = e instanceof ExecutionException ? e.getCause() : e;
+					JOptionPane.showMessageDialog(
+						MediaSearchDialog.this,
+						cause.getMessage(),
+						"Network Error",
+						JOptionPane.ERROR_MESSAGE
+					);
+					mediaListPanel.append(new MediaList(Map.of(), cursor));
+
+					logger.info("{} couldn't retrieve the next page from server", MediaSearchDialog.this, cause);
+				}
+			}
+		}.execute();
+	}
+
+	private void suggest(String prefix) {
+		if (prefix.strip().length() < MIN_SUGGESTION_PREFIX_LENGTH) return;
+
+		long sequence = suggestionSequence.incrementAndGet();
+		new Thread(() -> {
+			try (RubusClient rubusClient = rubusCleintSupplier.get()) {
+				RubusRequest.Builder requestBuilder = rubusClient.getRequestBuilder();
+				requestBuilder.LIST_PREFIX(prefix, SUGGESTION_LIMIT);
+				RubusResponse response = rubusClient.send(requestBuilder.build(), 10000);
+				if (response.getResponseType() != RubusResponseType.OK) {
+					logger.debug("{} received {} response to suggestion request", this, response.getResponseType());
+					return;
+				}
+				MediaList mediaList = response.LIST();
+				SwingUtilities.invokeLater(() -> {
+					// a response to an outdated prefix must not replace the newer results
+					if (sequence != suggestionSequence.get()) return;
+					scrollPane.setViewportView(new MediaListPanel(this, mainFrame, mediaList, watchHistory));
+				});
+			} catch (Exception e) {
+				logger.debug("{} couldn't retrieve suggestions from server", this, e);
+			}
+		}).start();
+	}
+
+	private MediaList requestPage(String query, String cursor) throws InterruptedException, IOException {
+		try (RubusClient rubusClient = rubusCleintSupplier.get()) {
+			RubusRequest.Builder requestBuilder = rubusClient.getRequestBuilder();
+			requestBuilder.LIST(query, PAGE_SIZE, cursor);
+			RubusResponse response = rubusClient.send(requestBuilder.build(), 10000);
+			if (response.getResponseType() != RubusResponseType.OK) {
+				throw new IOException(
+					"Couldn't fetch data from server, response code: " + response.getResponseType()
+				);
+			}
+			return response.LIST();
+		}
+	}
 }
@@ -19,9 +19,12 @@
 
 package frontend.models;
 
+import java.nio.ByteBuffer;
+
 /**
- * EncodedPlayingClip stores a 1 second long video and audio clips; both are represented as byte arrays.
+ * EncodedPlayingClip stores a 1 second long video and audio clips; both are represented as the remaining content of
+ * {@link ByteBuffer}s, which are usually views of the response message the clips were received in.
  * @param video a video clip
  * @param audio an audio clip
  */
-public record EncodedPlaybackClip(byte[] video, byte[] audio) { }
+public record EncodedPlaybackClip(ByteBuffer video, ByteBuffer audio) { }
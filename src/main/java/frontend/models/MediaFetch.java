@@ -19,8 +19,12 @@
 
 package frontend.models;
 
+import java.nio.ByteBuffer;
+
 /**
  * MediaFetch stores media content of the specified range. The range size is equal to video or audio array size.
+ * A clip is the remaining content of its {@link ByteBuffer}; the buffers are usually views of the response message,
+ * so no clip data is copied while the response is decoded.
  * @param id the media id
  * @param offset the index of the first clip
  * @param video an array of video clips
@@ -29,6 +33,6 @@ package frontend.models;
 public record MediaFetch(
 	String id,
 	int offset,
-	byte[][] video,
-	byte[][] audio
+	ByteBuffer[] video,
+	ByteBuffer[] audio
 ) { }
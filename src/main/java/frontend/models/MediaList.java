@@ -22,8 +22,18 @@ package frontend.models;
 import java.util.Map;
 
 /**
- * MediaLists stores id-title pairs.
- * @param media the map containing id-title pairs
+ * MediaLists stores id-title pairs. A MediaList can be a single page of a larger result; in this case cursor identifies
+ * the position the next page starts at.
+ * @param media the map containing id-title pairs in the order of the result
+ * @param cursor the opaque value to request the next page with, or null if there are no more pages
  */
-public record MediaList(Map<String, String> media) {
+public record MediaList(Map<String, String> media, String cursor) {
+
+	/**
+	 * Constructs a MediaList that isn't followed by other pages.
+	 * @param media the map containing id-title pairs
+	 */
+	public MediaList(Map<String, String> media) {
+		this(media, null);
+	}
 }
@@ -19,20 +19,26 @@
 
 package frontend.network;
 
+import frontend.converters.MediaFetchFramedBinaryConverter;
 import jakarta.annotation.Nonnull;
 
 import javax.net.ssl.SSLException;
 import javax.net.ssl.SSLHandshakeException;
+import java.io.ByteArrayInputStream;
 import java.io.IOException;
 import java.net.http.HttpClient;
 import java.net.http.HttpRequest;
 import java.net.http.HttpResponse;
 import java.time.Duration;
 import java.time.temporal.ChronoUnit;
+import java.util.zip.GZIPInputStream;
 
 /**
  * A concrete implementation of {@link RubusClient} using the HTTP application layer protocol. By default, this class
- * attempts to make a request using the https protocol; if it fails it falls back to the http protocol.
+ * attempts to make a request using the https protocol; if it fails it falls back to the http protocol.<br>
+ * The client prefers the framed FETCH format ( see {@link MediaFetchFramedBinaryConverter} ) and advertises it via
+ * the Accept header of the FETCH requests; servers that don't support it respond with BSON. The client also accepts
+ * gzip-compressed responses and decompresses them.
  */
 public class HttpRubusClient implements RubusClient {
 
@@ -67,12 +73,18 @@ public class HttpRubusClient implements RubusClient {
 			HttpRequest.Builder requestBuilder = HttpRequest
 				.newBuilder()
 				.GET()
+				.header("Accept-Encoding", "gzip")
 				.timeout(Duration.of(timeout, ChronoUnit.MILLIS));
+			if ("FETCH".equals(httpRubusRequest.getRequestType())) {
+				requestBuilder.header(
+					"Accept", MediaFetchFramedBinaryConverter.MEDIA_TYPE + ", application/octet-stream;q=0.5"
+				);
+			}
 			if (secureConnectionEnabled) {
 				try {
 					HttpRequest request = requestBuilder.uri(httpRubusRequest.getHttpsUri()).build();
 					HttpResponse<byte[]> response = client.send(request, HttpResponse.BodyHandlers.ofByteArray());
-					return new HttpRubusResponse(response.body(), response.statusCode());
+					return toRubusResponse(response);
 				} catch (SSLException e) {
 					if (secureConnectionRequired) throw e;
 				}
@@ -80,7 +92,7 @@ public class HttpRubusClient implements RubusClient {
 
 			HttpRequest request = requestBuilder.uri(httpRubusRequest.getHttpUri()).build();
 			HttpResponse<byte[]> response = client.send(request, HttpResponse.BodyHandlers.ofByteArray());
-			return new HttpRubusResponse(response.body(), response.statusCode());
+			return toRubusResponse(response);
 		}
 
 		throw new IllegalArgumentException("Illegal RubusRequest type");
@@ -130,4 +142,16 @@ public class HttpRubusClient implements RubusClient {
 	public void setSecureConnectionRequired(boolean isRequired) {
 		secureConnectionRequired = isRequired;
 	}
+
+	private HttpRubusResponse toRubusResponse(HttpResponse<byte[]> response) throws IOException {
+		byte[] body = response.body();
+		if (response.headers().firstValue("Content-Encoding").map("gzip"::equalsIgnoreCase).orElse(false)) {
+			try (GZIPInputStream gzipInputStream = new GZIPInputStream(new ByteArrayInputStream(body))) {
+				body = gzipInputStream.readAllBytes();
+			}
+		}
+		return new HttpRubusResponse(
+			body, response.statusCode(), response.headers().firstValue("Content-Type").orElse(null)
+		);
+	}
 }
@@ -20,6 +20,7 @@
 package frontend.network;
 
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 import org.springframework.web.util.UriComponentsBuilder;
 
 import java.net.URI;
@@ -67,6 +68,36 @@ public class HttpRubusRequest implements RubusRequest {
 			return this;
 		}
 
+		@Override
+		public HttpRubusRequest.Builder LIST(@Nonnull String searchQuery, int limit, @Nullable String cursor) {
+			if (limit <= 0) throw new IllegalArgumentException("The limit value must be positive");
+
+			if (cursor == null) {
+				uriParameters = Map.of("request_type", "LIST", "search_query", searchQuery, "limit", "" + limit);
+			} else {
+				uriParameters = Map.of(
+					"request_type", "LIST",
+					"search_query", searchQuery,
+					"limit", "" + limit,
+					"cursor", cursor
+				);
+			}
+			return this;
+		}
+
+		@Override
+		public HttpRubusRequest.Builder LIST_PREFIX(@Nonnull String prefix, int limit) {
+			if (limit <= 0) throw new IllegalArgumentException("The limit value must be positive");
+
+			uriParameters = Map.of(
+				"request_type", "LIST",
+				"search_query", prefix,
+				"limit", "" + limit,
+				"search_mode", "prefix"
+			);
+			return this;
+		}
+
 		@Override
 		public HttpRubusRequest.Builder INFO(@Nonnull String mediaId) {
 			uriParameters = Map.of("request_type", "INFO", "media_id", mediaId);
@@ -104,7 +135,9 @@ public class HttpRubusRequest implements RubusRequest {
 			for (Map.Entry<String, String> entry: uriParameters.entrySet()) {
 				httpsLink.queryParam(entry.getKey(), entry.getValue());
 			}
-			return new HttpRubusRequest(httpLink.build().toUri(), httpsLink.build().toUri());
+			return new HttpRubusRequest(
+				httpLink.build().toUri(), httpsLink.build().toUri(), uriParameters.get("request_type")
+			);
 		}
 	}
 
@@ -112,9 +145,12 @@ public class HttpRubusRequest implements RubusRequest {
 
 	private final URI httpsUri;
 
-	private HttpRubusRequest(@Nonnull URI httpLink, @Nonnull URI httpsLink) {
+	private final String requestType;
+
+	private HttpRubusRequest(@Nonnull URI httpLink, @Nonnull URI httpsLink, @Nonnull String requestType) {
 		httpUri = httpLink;
 		httpsUri = httpsLink;
+		this.requestType = requestType;
 	}
 
 	/**
@@ -132,4 +168,12 @@ public class HttpRubusRequest implements RubusRequest {
 	public URI getHttpsUri() {
 		return httpsUri;
 	}
+
+	/**
+	 * Returns the type of the request, e.g. LIST, INFO or FETCH.
+	 * @return the type of the request
+	 */
+	public String getRequestType() {
+		return requestType;
+	}
 }
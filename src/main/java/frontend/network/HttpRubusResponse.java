@@ -22,18 +22,21 @@ package frontend.network;
 import frontend.adapters.ArraySeekableByteChannel;
 import frontend.converters.BinaryConverter;
 import frontend.converters.MediaFetchBinaryConverter;
+import frontend.converters.MediaFetchFramedBinaryConverter;
 import frontend.converters.MediaInfoBinaryConverter;
 import frontend.converters.MediaListBinaryConverter;
 import frontend.models.MediaFetch;
 import frontend.models.MediaInfo;
 import frontend.models.MediaList;
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 
 import java.io.IOException;
 
 /**
  * A concrete implementation of {@link RubusResponse} that converts HTTP status codes into rubus response types and HTTP
- * bodies into requested models.
+ * bodies into requested models. The FETCH body is decoded with the framed format converter if the content type of
+ * the response is {@link MediaFetchFramedBinaryConverter#MEDIA_TYPE}, and with the BSON converter otherwise.
  */
 public class HttpRubusResponse implements RubusResponse {
 
@@ -41,20 +44,35 @@ public class HttpRubusResponse implements RubusResponse {
 
 	private final int httpStatusCode;
 
+	private final String contentType;
+
 	private BinaryConverter<MediaList> mediaListBinaryConverter = new MediaListBinaryConverter();
 
 	private BinaryConverter<MediaInfo> mediaInfoBinaryConverter = new MediaInfoBinaryConverter();
 
 	private BinaryConverter<MediaFetch> mediaFetchBinaryConverter = new MediaFetchBinaryConverter();
 
+	private BinaryConverter<MediaFetch> mediaFetchFramedBinaryConverter = new MediaFetchFramedBinaryConverter();
+
 	/**
 	 * Constructs an instance of this class.
 	 * @param responseBody the content of the response body
 	 * @param httpStatusCode the http response status code
+	 * @param contentType the content type of the response body, or null if it's unknown
 	 */
-	public HttpRubusResponse(@Nonnull byte[] responseBody, int httpStatusCode) {
+	public HttpRubusResponse(@Nonnull byte[] responseBody, int httpStatusCode, @Nullable String contentType) {
 		this.responseBody = responseBody;
 		this.httpStatusCode = httpStatusCode;
+		this.contentType = contentType;
+	}
+
+	/**
+	 * Constructs an instance of this class with an unknown content type.
+	 * @param responseBody the content of the response body
+	 * @param httpStatusCode the http response status code
+	 */
+	public HttpRubusResponse(@Nonnull byte[] responseBody, int httpStatusCode) {
+		this(responseBody, httpStatusCode, null);
 	}
 
 	@Override
@@ -83,7 +101,11 @@ public class HttpRubusResponse implements RubusResponse {
 	@Override
 	public MediaFetch FETCH() {
 		try {
-			return mediaFetchBinaryConverter.convert(new ArraySeekableByteChannel(responseBody));
+			boolean isFramed =
+				contentType != null && contentType.startsWith(MediaFetchFramedBinaryConverter.MEDIA_TYPE);
+			BinaryConverter<MediaFetch> converter =
+				isFramed ? mediaFetchFramedBinaryConverter : mediaFetchBinaryConverter;
+			return converter.convert(new ArraySeekableByteChannel(responseBody));
 		} catch (IOException ignored) { throw new RuntimeException(); }
 	}
 
@@ -137,4 +159,23 @@ public class HttpRubusResponse implements RubusResponse {
 	public void setMediaFetchBinaryConverter(@Nonnull BinaryConverter<MediaFetch> newMediaFetchBinaryConverter) {
 		mediaFetchBinaryConverter = newMediaFetchBinaryConverter;
 	}
+
+	/**
+	 * Returns the current {@link MediaFetch} converter of the framed format.
+	 * @return the current {@link MediaFetch} converter of the framed format
+	 */
+	@Nonnull
+	public BinaryConverter<MediaFetch> getMediaFetchFramedBinaryConverter() {
+		return mediaFetchFramedBinaryConverter;
+	}
+
+	/**
+	 * Sets a new {@link MediaFetch} converter of the framed format.
+	 * @param newMediaFetchFramedBinaryConverter a new {@link MediaFetch} converter of the framed format
+	 */
+	public void setMediaFetchFramedBinaryConverter(
+		@Nonnull BinaryConverter<MediaFetch> newMediaFetchFramedBinaryConverter
+	) {
+		mediaFetchFramedBinaryConverter = newMediaFetchFramedBinaryConverter;
+	}
 }
@@ -20,6 +20,7 @@
 package frontend.network;
 
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 
 /**
  * Concrete implementations of this interface provide necessary information accessible to respective {@link RubusClient}
@@ -59,6 +60,25 @@ public interface RubusRequest {
 		 */
 		Builder LIST(@Nonnull String searchQuery);
 
+		/**
+		 * Assigns this request type to the LIST request type that requests a single page of the media matching
+		 * the specified search query.
+		 * @param searchQuery the search query
+		 * @param limit the maximum amount of media in the page
+		 * @param cursor the cursor of the previous page, or null to request the first page
+		 * @return the current builder
+		 */
+		Builder LIST(@Nonnull String searchQuery, int limit, @Nullable String cursor);
+
+		/**
+		 * Assigns this request type to the LIST request type that requests at most limit media whose title contains
+		 * the prefix, including partial words, for search-as-you-type suggestions. The result isn't paged.
+		 * @param prefix the prefix
+		 * @param limit the maximum amount of media
+		 * @return the current builder
+		 */
+		Builder LIST_PREFIX(@Nonnull String prefix, int limit);
+
 		/**
 		 * Assigns this request type to the INFO request type with the provided media id.
 		 * @param mediaId the media id
@@ -0,0 +1,88 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.controllers;
+
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+import java.nio.ByteBuffer;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class DirectBufferPoolTests {
+
+	DirectBufferPool pool = new DirectBufferPool(DirectBufferPool.MINIMUM_CHUNK_SIZE, 1);
+
+	@ParameterizedTest
+	@ValueSource(ints = {0, 1, 8 * 1024, 8 * 1024 + 1, 64 * 1024, 10 * 1024 * 1024})
+	void acquisitionTest(int size) {
+		ByteBuffer buffer = pool.acquire(size);
+		assertTrue(buffer.isDirect(), "The buffer isn't direct");
+		assertTrue(
+			buffer.capacity() >= Math.min(size, pool.getChunkSize()), "The buffer capacity is smaller than requested"
+		);
+		assertTrue(buffer.capacity() <= pool.getChunkSize(), "The buffer capacity exceeds the chunk size");
+		assertEquals(0, buffer.position(), "The buffer isn't cleared");
+		assertEquals(buffer.capacity(), buffer.limit(), "The buffer isn't cleared");
+	}
+
+	@Test
+	void reuseTest() {
+		ByteBuffer buffer = pool.acquire(100);
+		assertEquals(0, pool.getHits(), "Unexpected amount of hits");
+		assertEquals(1, pool.getMisses(), "Unexpected amount of misses");
+
+		buffer.put((byte) 1);
+		pool.release(buffer);
+		ByteBuffer reusedBuffer = pool.acquire(200);
+		assertSame(buffer, reusedBuffer, "The buffer wasn't reused");
+		assertEquals(0, reusedBuffer.position(), "The buffer isn't cleared");
+		assertEquals(1, pool.getHits(), "Unexpected amount of hits");
+
+		assertNotSame(buffer, pool.acquire(pool.getChunkSize()), "The buffer of a different size class was reused");
+		assertEquals(2, pool.getMisses(), "Unexpected amount of misses");
+	}
+
+	@Test
+	void heapReuseTest() {
+		ByteBuffer buffer = pool.acquireHeap(100);
+		assertFalse(buffer.isDirect(), "The buffer is direct");
+		pool.release(buffer);
+		assertNotSame(buffer, pool.acquire(100), "A heap buffer was acquired as a direct one");
+		assertSame(buffer, pool.acquireHeap(200), "The heap buffer wasn't reused");
+		assertEquals(1, pool.getHits(), "Unexpected amount of hits");
+	}
+
+	@Test
+	void foreignBuffersAreIgnoredTest() {
+		pool.release(ByteBuffer.allocate(16 * 1024).slice(8 * 1024, 8 * 1024));
+		pool.release(ByteBuffer.allocateDirect(10 * 1024));
+		pool.acquire(8 * 1024);
+		pool.acquireHeap(8 * 1024);
+		assertEquals(0, pool.getHits(), "A foreign buffer was reused");
+	}
+
+	@ParameterizedTest
+	@ValueSource(ints = {32 * 1024, 96 * 1024, 2 * 1024 * 1024})
+	void invalidChunkSizeTest(int chunkSize) {
+		assertThrows(IllegalArgumentException.class, () -> new DirectBufferPool(chunkSize, 1));
+	}
+}
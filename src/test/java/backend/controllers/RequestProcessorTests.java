@@ -32,7 +32,9 @@ import org.junit.jupiter.params.ParameterizedTest;
 import org.junit.jupiter.params.provider.*;
 
 import java.nio.channels.SeekableByteChannel;
+import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.Map;
 import java.util.UUID;
 import java.util.stream.Stream;
 
@@ -125,6 +127,116 @@ public class RequestProcessorTests {
 		}
 	}
 
+	@Nested
+	class SearchMediaPage {
+
+		Media[] generatedMedia = new Media[5];
+
+		@BeforeEach
+		void beforeEach() {
+			Arrays.setAll(generatedMedia, i -> new MediaStub());
+			// Pages through generatedMedia in the array order, using the index of the next media as the cursor
+			mediaProviderStub.searchMediaPage = (v, query, limit, cursor) -> {
+				assertSame(viewerStub, v, "The passed viewer object is different");
+				int from = cursor == null ? 0 : Integer.parseInt(cursor);
+				int to = Math.min(from + limit, generatedMedia.length);
+				return new MediaPage(
+					Arrays.copyOfRange(generatedMedia, from, to),
+					to < generatedMedia.length ? Integer.toString(to) : null
+				);
+			};
+		}
+
+		@ParameterizedTest
+		@ValueSource(ints = {0, -1})
+		void passNonPositiveLimit(int limit) {
+			assertThrows(
+				InvalidParameterException.class,
+				() -> requestProcessor.listRequest("", limit, null, requestOriginator),
+				"The querying method didn't throw " + InvalidParameterException.class.getSimpleName()
+			);
+		}
+
+		@Test
+		void passInvalidCursor() {
+			mediaProviderStub.searchMediaPage = (v, query, limit, cursor) -> {
+				assertEquals("abcd", cursor, "The passed cursor doesn't match");
+				throw new IllegalArgumentException();
+			};
+
+			assertThrows(
+				InvalidParameterException.class,
+				() -> requestProcessor.listRequest("", 1, "abcd", requestOriginator),
+				"The querying method didn't throw " + InvalidParameterException.class.getSimpleName()
+			);
+		}
+
+		@ParameterizedTest
+		@ValueSource(ints = {1, 2, 4, 5, 6})
+		void pageThroughTest(int limit) {
+			UUID[] expectedIds = Arrays.stream(generatedMedia).map(Media::getID).toArray(UUID[]::new);
+			ArrayList<UUID> retrievedIds = new ArrayList<>();
+			String cursor = null;
+			do {
+				MediaList page = requestProcessor.listRequest("", limit, cursor, requestOriginator);
+				assertTrue(page.media().size() <= limit, "The page exceeds the limit");
+				for (Map.Entry<UUID, String> entry: page.media().entrySet()) {
+					retrievedIds.add(entry.getKey());
+					assertEquals(entry.getKey().toString(), entry.getValue(), "The title doesn't match");
+				}
+				cursor = page.cursor();
+			} while (cursor != null);
+
+			assertArrayEquals(
+				expectedIds, retrievedIds.toArray(), "The pages don't add up to the whole result in its order"
+			);
+		}
+	}
+
+	@Nested
+	class SuggestMedia {
+
+		@ParameterizedTest
+		@ValueSource(ints = {0, -1})
+		void passNonPositiveLimit(int limit) {
+			assertThrows(
+				InvalidParameterException.class,
+				() -> requestProcessor.suggestRequest("tit", limit, requestOriginator),
+				"The querying method didn't throw " + InvalidParameterException.class.getSimpleName()
+			);
+		}
+
+		@ParameterizedTest
+		@ValueSource(strings = {"", "ti", " ti "})
+		void passShortPrefix(String prefix) {
+			assertThrows(
+				InvalidParameterException.class,
+				() -> requestProcessor.suggestRequest(prefix, 3, requestOriginator),
+				"The querying method didn't throw " + InvalidParameterException.class.getSimpleName()
+			);
+		}
+
+		@Test
+		void orderIsPreservedTest() {
+			Media[] suggestedMedia = new Media[3];
+			Arrays.setAll(suggestedMedia, i -> new MediaStub());
+			mediaProviderStub.suggestMedia = (viewer, prefix, limit) -> {
+				assertSame(viewerStub, viewer, "The passed viewer object is different");
+				assertEquals("tit", prefix, "The passed prefix doesn't match");
+				assertEquals(3, limit, "The passed limit doesn't match");
+				return suggestedMedia;
+			};
+
+			MediaList mediaList = requestProcessor.suggestRequest("tit", 3, requestOriginator);
+			assertArrayEquals(
+				Arrays.stream(suggestedMedia).map(Media::getID).toArray(),
+				mediaList.media().keySet().toArray(),
+				"The suggestions aren't in the order of the provider"
+			);
+			assertNull(mediaList.cursor(), "The suggestions have a cursor");
+		}
+	}
+
 	@Nested
 	class QueryMediaInfo {
 
@@ -340,5 +452,57 @@ public class RequestProcessorTests {
 			assertEquals(amount, mediaFetch.audio().length, "The size of the array of audio clips doesn't match");
 			assertSame(audioClips, mediaFetch.audio(), "The array of audio clips is a different array");
 		}
+	
+
+		@Test
+		void truncateToMaxClips() {
+			mediaStub.duration = 5;
+			requestProcessor.setMaxClipsPerFetch(2);
+			mediaStub.retrieveVideoStrategy = (o, a) -> {
+				assertEquals(2, a, "The passed amount value isn't capped");
+				return new SeekableByteChannel[] {
+					new SeekableByteChannelStub(new byte[0]), new SeekableByteChannelStub(new byte[0])
+				};
+			};
+			mediaStub.retrieveAudioStrategy = mediaStub.retrieveVideoStrategy;
+
+			MediaFetch mediaFetch = requestProcessor.fetchRequest(mediaStub.getID(), 1, 4, requestOriginator);
+
+			assertEquals(1, mediaFetch.offset(), "The offset value doesn't match");
+			assertEquals(2, mediaFetch.video().length, "The size of the array of video clips doesn't match");
+			assertEquals(2, mediaFetch.audio().length, "The size of the array of audio clips doesn't match");
+		}
+
+		public static Stream<Arguments> byteBudgetArgumentProvider() {
+			return Stream.of(
+				Arguments.of(1, 1),
+				Arguments.of(19, 1),
+				Arguments.of(20, 2),
+				Arguments.of(30, 3),
+				Arguments.of(1000, 3)
+			);
+		}
+
+		@ParameterizedTest
+		@MethodSource("byteBudgetArgumentProvider")
+		void truncateToMaxBytes(long maxBytes, int expectedAmount) {
+			mediaStub.duration = 3;
+			requestProcessor.setMaxBytesPerFetch(maxBytes);
+			SeekableByteChannelStub[] videoClips = new SeekableByteChannelStub[3];
+			Arrays.setAll(videoClips, i -> new SeekableByteChannelStub(new byte[6]));
+			mediaStub.retrieveVideoStrategy = (o, a) -> videoClips;
+			SeekableByteChannelStub[] audioClips = new SeekableByteChannelStub[3];
+			Arrays.setAll(audioClips, i -> new SeekableByteChannelStub(new byte[4]));
+			mediaStub.retrieveAudioStrategy = (o, a) -> audioClips;
+
+			MediaFetch mediaFetch = requestProcessor.fetchRequest(mediaStub.getID(), 0, 3, requestOriginator);
+
+			assertEquals(expectedAmount, mediaFetch.video().length, "The amount of video clips doesn't match");
+			assertEquals(expectedAmount, mediaFetch.audio().length, "The amount of audio clips doesn't match");
+			for (int i = 0; i < 3; i++) {
+				assertEquals(i < expectedAmount, videoClips[i].isOpen(), "The video clip " + i + " open state mismatch");
+				assertEquals(i < expectedAmount, audioClips[i].isOpen(), "The audio clip " + i + " open state mismatch");
+			}
+		}
 	}
 }
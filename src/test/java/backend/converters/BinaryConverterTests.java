@@ -21,9 +21,13 @@ package backend.converters;
 
 import org.junit.jupiter.api.Test;
 
+import java.io.ByteArrayOutputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
 import java.nio.channels.SeekableByteChannel;
 
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
 public abstract class BinaryConverterTests<T> {
@@ -42,4 +46,20 @@ public abstract class BinaryConverterTests<T> {
 			assertTrue(testEquality(getModel(), transConvertedModel));
 		}
 	}
+
+	@Test
+	void streamingConversionTest() throws IOException {
+		BinaryConverter<T> converter = getConverter();
+		ByteArrayOutputStream byteArrayOutputStream = new ByteArrayOutputStream();
+		converter.convert(getModel(), Channels.newChannel(byteArrayOutputStream));
+		try (SeekableByteChannel conversionOutput = converter.convert(getModel())) {
+			ByteBuffer expected = ByteBuffer.allocate((int) conversionOutput.size());
+			conversionOutput.read(expected);
+			assertArrayEquals(
+				expected.array(),
+				byteArrayOutputStream.toByteArray(),
+				"The streamed conversion output differs from the regular conversion output"
+			);
+		}
+	}
 }
@@ -22,16 +22,20 @@ package backend.converters;
 import backend.models.MediaList;
 
 import java.util.Map;
+import java.util.Objects;
 import java.util.UUID;
 
 public class MediaListBinaryConverterTests extends BinaryConverterTests<MediaList> {
 
 	@Override
 	public MediaList getModel() {
-		return new MediaList(Map.of(
-			UUID.fromString("3281e88b-15ee-4f5c-91c7-3d77b5ba1d0a"), "title1",
-			UUID.fromString("a6b019d2-b3af-4780-86d8-0ddd7b835cd3"), "title2"
-		));
+		return new MediaList(
+			Map.of(
+				UUID.fromString("3281e88b-15ee-4f5c-91c7-3d77b5ba1d0a"), "title1",
+				UUID.fromString("a6b019d2-b3af-4780-86d8-0ddd7b835cd3"), "title2"
+			),
+			"a6b019d2-b3af-4780-86d8-0ddd7b835cd3"
+		);
 	}
 
 	@Override
@@ -41,6 +45,6 @@ public class MediaListBinaryConverterTests extends BinaryConverterTests<MediaLis
 
 	@Override
 	public boolean testEquality(MediaList m1, MediaList m2) {
-		return m1.media().equals(m2.media());
+		return m1.media().equals(m2.media()) && Objects.equals(m1.cursor(), m2.cursor());
 	}
 }
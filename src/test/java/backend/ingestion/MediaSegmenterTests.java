@@ -0,0 +1,128 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.ingestion;
+
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.CsvSource;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class MediaSegmenterTests {
+
+	@TempDir
+	Path destination;
+
+	Path source = Path.of("source.mkv");
+
+	@Test
+	void segmentationTest() throws IOException, InterruptedException {
+		Set<String> clips = ConcurrentHashMap.newKeySet();
+		MediaSegmenter mediaSegmenter = new MediaSegmenter("ffmpeg", "ffprobe", 3, command -> {
+			if (command.contains("format=duration")) return "2.5\n";
+			if (command.contains("stream=r_frame_rate")) return "25/1\n";
+			if (command.contains("stream=codec_type")) return "audio\n";
+			assertEquals("ffmpeg", command.getFirst(), "Unexpected executable");
+			if (command.getLast().startsWith(destination.resolve("v").toString())) {
+				assertEquals(
+					"25",
+					command.get(command.indexOf("-frames:v") + 1),
+					"The video clip doesn't hold the frame rate amount of frames"
+				);
+			}
+			clips.add(Path.of(command.getLast()).getFileName().toString());
+			return "";
+		});
+
+		MediaSegmenter.Report report = mediaSegmenter.segment(source, destination);
+		assertEquals(3, report.duration(), "The duration wasn't rounded up");
+		assertEquals(25, report.frameRate(), "Unexpected frame rate");
+		assertEquals(6, report.clips(), "Unexpected amount of clips");
+		assertEquals(Set.of("v0", "v1", "v2", "a0", "a1", "a2"), clips, "Unexpected clips");
+		assertTrue(report.speed() > 0, "The speed isn't positive");
+	}
+
+	@Test
+	void silentAudioTest() throws IOException, InterruptedException {
+		Set<String> encodedClips = ConcurrentHashMap.newKeySet();
+		MediaSegmenter mediaSegmenter = new MediaSegmenter("ffmpeg", "ffprobe", 2, command -> {
+			if (command.contains("format=duration")) return "3";
+			if (command.contains("stream=r_frame_rate")) return "24";
+			if (command.contains("stream=codec_type")) return "";
+			assertFalse(command.contains("0:a:0"), "The missing audio stream was mapped");
+			Path clip = Path.of(command.getLast());
+			Files.writeString(clip, clip.getFileName().toString());
+			encodedClips.add(clip.getFileName().toString());
+			return "";
+		});
+
+		MediaSegmenter.Report report = mediaSegmenter.segment(source, destination);
+		assertEquals(6, report.clips(), "Unexpected amount of clips");
+		assertEquals(Set.of("v0", "v1", "v2", "a0"), encodedClips, "The silence wasn't encoded once");
+		for (int second = 0; second < 3; second++) {
+			assertEquals("a0", Files.readString(destination.resolve("a" + second)), "The silent clip wasn't copied");
+		}
+	}
+
+	@Test
+	void failedEncodingTest() {
+		MediaSegmenter mediaSegmenter = new MediaSegmenter("ffmpeg", "ffprobe", 2, command -> {
+			if (command.contains("format=duration")) return "10";
+			if (command.contains("stream=r_frame_rate")) return "24";
+			if (command.getLast().endsWith("v3")) throw new IOException("Encoding failed");
+			return "";
+		});
+
+		assertThrows(
+			IOException.class,
+			() -> mediaSegmenter.segment(source, destination.resolve("media")),
+			"The encoding failure wasn't reported"
+		);
+		assertTrue(Files.isDirectory(destination.resolve("media")), "The destination directory wasn't created");
+	}
+
+	@ParameterizedTest
+	@CsvSource({"30000/1001, 30", "24000/1001, 24", "25/1, 25", "60, 60"})
+	void frameRateProbingTest(String probedFrameRate, int expectedFrameRate)
+		throws IOException, InterruptedException {
+		MediaSegmenter mediaSegmenter = new MediaSegmenter("ffmpeg", "ffprobe", 1, command -> probedFrameRate);
+		assertEquals(expectedFrameRate, mediaSegmenter.probeFrameRate(source), "Unexpected frame rate");
+	}
+
+	@ParameterizedTest
+	@CsvSource({"N/A", "0/0", "''"})
+	void invalidProbingResultTest(String probedValue) {
+		MediaSegmenter mediaSegmenter = new MediaSegmenter("ffmpeg", "ffprobe", 1, command -> probedValue);
+		assertThrows(IOException.class, () -> mediaSegmenter.probeFrameRate(source), "The frame rate was accepted");
+		assertThrows(IOException.class, () -> mediaSegmenter.probeDuration(source), "The duration was accepted");
+	}
+
+	@Test
+	void invalidParallelismTest() {
+		assertThrows(IllegalArgumentException.class, () -> new MediaSegmenter("ffmpeg", "ffprobe", 0));
+	}
+}
@@ -0,0 +1,45 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.main;
+
+import org.junit.jupiter.api.Test;
+
+import java.util.concurrent.atomic.AtomicLong;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class MetricsReporterTests {
+
+	@Test
+	void reportTest() {
+		try (MetricsReporter metricsReporter = new MetricsReporter(MetricsReporter.DEFAULT_INTERVAL)) {
+			assertEquals("", metricsReporter.report(), "A metric was reported before being registered");
+
+			AtomicLong hits = new AtomicLong();
+			metricsReporter.register("hits", hits::get);
+			metricsReporter.register("ratio", () -> 2.0 / 3);
+			hits.set(5);
+			assertEquals("hits=5, ratio=0.667", metricsReporter.report(), "Unexpected report");
+
+			metricsReporter.register("hits", () -> 7);
+			assertEquals("hits=7, ratio=0.667", metricsReporter.report(), "The replaced metric was reported");
+		}
+	}
+}
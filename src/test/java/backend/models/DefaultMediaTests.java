@@ -19,9 +19,13 @@
 
 package backend.models;
 
+import backend.exceptions.QueryingException;
+import backend.exceptions.QueryingStrategyFactoryException;
+import backend.stubs.QueryingStrategyFactoryStub;
 import backend.stubs.QueryingStrategyInterfaceStub;
 import backend.stubs.SeekableByteChannelStub;
 import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
 import org.junit.jupiter.params.ParameterizedTest;
 import org.junit.jupiter.params.provider.Arguments;
 import org.junit.jupiter.params.provider.MethodSource;
@@ -30,10 +34,12 @@ import java.net.URI;
 import java.nio.channels.SeekableByteChannel;
 import java.util.Arrays;
 import java.util.UUID;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.stream.Stream;
 
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertSame;
+import static org.junit.jupiter.api.Assertions.assertThrows;
 
 public class DefaultMediaTests {
 
@@ -88,4 +94,62 @@ public class DefaultMediaTests {
 		SeekableByteChannel[] retrievedClips = defaultMedia.retrieveAudioClips(offset, amount);
 		assertSame(audioClips, retrievedClips, "The array of clips is a different array");
 	}
+
+	@Test
+	void lazyQueryingStrategyInstantiationTest() {
+		QueryingStrategyFactoryStub queryingStrategyFactoryStub = new QueryingStrategyFactoryStub();
+		AtomicInteger instantiations = new AtomicInteger();
+		queryingStrategyFactoryStub.getQueryingStrategyFunction = uri -> {
+			assertEquals(URI.create("testing_uri"), uri, "The passed URI doesn't match");
+			instantiations.incrementAndGet();
+			return queryingStrategyInterfaceStub;
+		};
+		SeekableByteChannel[] clips = new SeekableByteChannel[] {new SeekableByteChannelStub(new byte[0])};
+		queryingStrategyInterfaceStub.queryFunction = names -> clips;
+
+		DefaultMedia lazyMedia = new DefaultMedia(
+			UUID.randomUUID(), "testing media", 2, URI.create("testing_uri"), queryingStrategyFactoryStub
+		);
+		assertEquals(0, instantiations.get(), "The querying strategy was instantiated on construction");
+
+		assertSame(clips, lazyMedia.retrieveVideoClips(0, 1), "The array of clips is a different array");
+		assertSame(clips, lazyMedia.retrieveAudioClips(0, 1), "The array of clips is a different array");
+		assertEquals(2, instantiations.get(), "The querying strategy wasn't requested on every retrieval");
+	}
+
+	@Test
+	void replacedQueryingStrategyTest() {
+		QueryingStrategyInterfaceStub replacedQueryingStrategyStub = new QueryingStrategyInterfaceStub();
+		replacedQueryingStrategyStub.queryFunction = names -> {
+			throw new QueryingException();
+		};
+		QueryingStrategyFactoryStub queryingStrategyFactoryStub = new QueryingStrategyFactoryStub();
+		AtomicInteger requests = new AtomicInteger();
+		queryingStrategyFactoryStub.getQueryingStrategyFunction = uri ->
+			requests.getAndIncrement() == 0 ? replacedQueryingStrategyStub : queryingStrategyInterfaceStub;
+		SeekableByteChannel[] clips = new SeekableByteChannel[] {new SeekableByteChannelStub(new byte[0])};
+		queryingStrategyInterfaceStub.queryFunction = names -> clips;
+
+		DefaultMedia lazyMedia = new DefaultMedia(
+			UUID.randomUUID(), "testing media", 2, URI.create("testing_uri"), queryingStrategyFactoryStub
+		);
+		assertSame(clips, lazyMedia.retrieveVideoClips(0, 1), "The retrieval wasn't retried with the replacement");
+	}
+
+	@Test
+	void failLazyQueryingStrategyInstantiationTest() {
+		QueryingStrategyFactoryStub queryingStrategyFactoryStub = new QueryingStrategyFactoryStub();
+		queryingStrategyFactoryStub.getQueryingStrategyFunction = uri -> {
+			throw new QueryingStrategyFactoryException();
+		};
+
+		DefaultMedia lazyMedia = new DefaultMedia(
+			UUID.randomUUID(), "testing media", 2, URI.create("testing_uri"), queryingStrategyFactoryStub
+		);
+		assertThrows(
+			QueryingException.class,
+			() -> lazyMedia.retrieveVideoClips(0, 1),
+			"The retrieval didn't throw " + QueryingException.class.getSimpleName()
+		);
+	}
 }
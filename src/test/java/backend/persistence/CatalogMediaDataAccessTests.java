@@ -0,0 +1,266 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import backend.exceptions.CommonDataAccessException;
+import backend.models.DefaultMedia;
+import backend.models.Media;
+import backend.models.MediaPage;
+import backend.stubs.MediaDataAccessStub;
+import backend.stubs.MediaStub;
+import backend.stubs.QueryingStrategyFactoryStub;
+import backend.stubs.QueryingStrategyInterfaceStub;
+import backend.stubs.SeekableByteChannelStub;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
+
+import java.net.URI;
+import java.nio.channels.SeekableByteChannel;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.UUID;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class CatalogMediaDataAccessTests {
+
+	MediaDataAccessStub source = new MediaDataAccessStub();
+
+	CatalogMediaDataAccess catalogMediaDataAccess;
+
+	@AfterEach
+	void closeCatalog() {
+		if (catalogMediaDataAccess != null) catalogMediaDataAccess.close();
+	}
+
+	@Test
+	void servedFromMemoryTest() throws CommonDataAccessException {
+		MediaStub[] media = {createMedia("The big movie"), createMedia("Small movie")};
+		AtomicInteger loads = new AtomicInteger();
+		source.getMultipleMediaSupplier = () -> {
+			loads.incrementAndGet();
+			return media.clone();
+		};
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+
+		assertArrayEquals(media, catalogMediaDataAccess.getMedia(), "Unexpected catalog content");
+		assertSame(media[1], catalogMediaDataAccess.getMedia(media[1].getID()), "Unexpected media");
+		assertEquals(1, catalogMediaDataAccess.searchMedia("movie").length, "Unexpected amount of media");
+		assertEquals(1, loads.get(), "The catalog was loaded more than once");
+	}
+
+	@Test
+	void searchTest() throws CommonDataAccessException {
+		MediaStub[] media = {createMedia("The big movie"), createMedia("Big"), createMedia("Small movie")};
+		source.getMultipleMediaSupplier = () -> media;
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+
+		assertArrayEquals(
+			new Media[] {media[1], media[0]},
+			catalogMediaDataAccess.searchMedia("BIG"),
+			"The media aren't ordered by the share of the matching title words"
+		);
+		assertArrayEquals(
+			new Media[] {media[0]},
+			catalogMediaDataAccess.searchMedia("movie, big"),
+			"The media that don't contain every word matched"
+		);
+		assertEquals(0, catalogMediaDataAccess.searchMedia("bi").length, "A part of a word matched");
+		assertEquals(3, catalogMediaDataAccess.searchMedia(" ").length, "A blank search query didn't match everything");
+	}
+
+	@Test
+	void pagingTest() throws CommonDataAccessException {
+		MediaStub[] media = new MediaStub[7];
+		for (int i = 0; i < media.length; i++) media[i] = createMedia(i % 2 == 0 ? "movie" : "movie " + i);
+		source.getMultipleMediaSupplier = () -> media;
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+
+		List<Media> pagedMedia = new ArrayList<>();
+		String cursor = null;
+		do {
+			MediaPage page = catalogMediaDataAccess.searchMedia("movie", 2, cursor);
+			assertTrue(page.media().length <= 2, "The page exceeds the limit");
+			pagedMedia.addAll(List.of(page.media()));
+			cursor = page.cursor();
+		} while (cursor != null);
+		assertEquals(
+			List.of(catalogMediaDataAccess.searchMedia("movie")),
+			pagedMedia,
+			"The pages skip or repeat media"
+		);
+		assertThrows(
+			IllegalArgumentException.class,
+			() -> catalogMediaDataAccess.searchMedia("movie", 2, "malformed"),
+			"A malformed cursor was accepted"
+		);
+	}
+
+	@Test
+	void blankQueryPagingTest() throws CommonDataAccessException {
+		MediaStub[] media = new MediaStub[5];
+		for (int i = 0; i < media.length; i++) media[i] = createMedia("movie " + i);
+		source.getMultipleMediaSupplier = () -> media;
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+
+		List<Media> pagedMedia = new ArrayList<>();
+		String cursor = null;
+		do {
+			MediaPage page = catalogMediaDataAccess.searchMedia("", 2, cursor);
+			pagedMedia.addAll(List.of(page.media()));
+			cursor = page.cursor();
+		} while (cursor != null);
+		assertEquals(
+			List.of(catalogMediaDataAccess.searchMedia("")),
+			pagedMedia,
+			"The pages of the blank search query skip or repeat media"
+		);
+	}
+
+	@Test
+	void cursorOriginTest() throws CommonDataAccessException {
+		source.getMultipleMediaSupplier = () -> { throw new IllegalStateException(); };
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+		String catalogCursor = CatalogMediaDataAccess.CURSOR_TAG + "0.5:" + UUID.randomUUID();
+		assertThrows(
+			IllegalArgumentException.class,
+			() -> catalogMediaDataAccess.searchMedia("movie", 2, catalogCursor),
+			"A cursor of the catalog was passed to the source"
+		);
+
+		source.getMultipleMediaSupplier = () -> new Media[] {createMedia("movie")};
+		catalogMediaDataAccess.refresh();
+		MediaPage sourcePage = new MediaPage(new Media[] {createMedia("Movie")}, null);
+		String sourceCursor = "0.5:" + UUID.randomUUID();
+		source.searchMediaPageFunction = (query, limit, cursor) -> {
+			assertEquals(sourceCursor, cursor, "The cursor of the source wasn't passed to it");
+			return sourcePage;
+		};
+		assertSame(
+			sourcePage,
+			catalogMediaDataAccess.searchMedia("movie", 2, sourceCursor),
+			"The page following a page of the source wasn't served by the source"
+		);
+	}
+
+	@Test
+	void refreshTest() throws CommonDataAccessException {
+		MediaStub[] media = {createMedia("Unchanged"), createMedia("Modified"), createMedia("Removed")};
+		source.getMultipleMediaSupplier = () -> media;
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+
+		MediaStub modifiedMedia = createMedia("Another title");
+		modifiedMedia.id = media[1].getID();
+		MediaStub unchangedMedia = createMedia("Unchanged");
+		unchangedMedia.id = media[0].getID();
+		MediaStub addedMedia = createMedia("Added");
+		source.getMultipleMediaSupplier = () -> new Media[] {unchangedMedia, modifiedMedia, addedMedia};
+		catalogMediaDataAccess.refresh();
+
+		assertArrayEquals(
+			new Media[] {media[0], modifiedMedia, addedMedia},
+			catalogMediaDataAccess.getMedia(),
+			"The catalog wasn't refreshed or the unchanged media was replaced"
+		);
+		assertEquals(0, catalogMediaDataAccess.searchMedia("modified").length, "The modified media wasn't reindexed");
+		assertEquals(1, catalogMediaDataAccess.searchMedia("another").length, "The modified media wasn't reindexed");
+	}
+
+	@Test
+	void replacedQueryingStrategyTest() throws CommonDataAccessException {
+		QueryingStrategyInterfaceStub original = new QueryingStrategyInterfaceStub();
+		original.queryFunction = names -> new SeekableByteChannel[] {new SeekableByteChannelStub(new byte[0])};
+		QueryingStrategyFactoryStub queryingStrategyFactoryStub = new QueryingStrategyFactoryStub();
+		queryingStrategyFactoryStub.getQueryingStrategyFunction = uri -> original;
+		UUID id = UUID.randomUUID();
+		source.getMultipleMediaSupplier = () -> new Media[] {
+			new DefaultMedia(id, "Movie", 1, URI.create("test_uri"), queryingStrategyFactoryStub)
+		};
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+		Media media = catalogMediaDataAccess.getMedia(id);
+		assertNotNull(media, "The media wasn't loaded");
+		media.retrieveVideoClips(0, 1);
+
+		// The content root was re-packed, so the factory replaced the strategy of the URI
+		QueryingStrategyInterfaceStub replacement = new QueryingStrategyInterfaceStub();
+		SeekableByteChannel[] clips = {new SeekableByteChannelStub(new byte[0])};
+		replacement.queryFunction = names -> clips;
+		queryingStrategyFactoryStub.getQueryingStrategyFunction = uri -> replacement;
+		catalogMediaDataAccess.refresh();
+
+		assertSame(media, catalogMediaDataAccess.getMedia(id), "The unchanged media was replaced");
+		assertSame(clips, media.retrieveVideoClips(0, 1), "The media kept querying the replaced strategy");
+	}
+
+	@Test
+	void singleMediaRefreshTest() throws CommonDataAccessException {
+		MediaStub[] media = {createMedia("First"), createMedia("Second")};
+		source.getMultipleMediaSupplier = () -> media;
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+
+		MediaStub addedMedia = createMedia("Added");
+		source.getSingleMediaFunction = id -> id.equals(addedMedia.getID()) ? addedMedia : null;
+		catalogMediaDataAccess.refresh(addedMedia.getID());
+		catalogMediaDataAccess.refresh(media[0].getID());
+
+		assertArrayEquals(
+			new Media[] {media[1], addedMedia},
+			catalogMediaDataAccess.getMedia(),
+			"The media wasn't added or removed"
+		);
+		assertArrayEquals(
+			new Media[] {addedMedia},
+			catalogMediaDataAccess.searchMedia("added"),
+			"The added media wasn't indexed"
+		);
+	}
+
+	@Test
+	void sourceFallbackTest() throws CommonDataAccessException {
+		source.getMultipleMediaSupplier = () -> { throw new IllegalStateException(); };
+		catalogMediaDataAccess = new CatalogMediaDataAccess(source, 3600);
+
+		Media[] searchResult = {createMedia("Movie")};
+		source.searchMediaFunction = query -> searchResult;
+		assertSame(
+			searchResult,
+			catalogMediaDataAccess.searchMedia("movie"),
+			"The request wasn't served by the source while the catalog isn't loaded"
+		);
+
+		source.getMultipleMediaSupplier = () -> new Media[0];
+		catalogMediaDataAccess.refresh();
+		MediaStub absentMedia = createMedia("Absent");
+		source.getSingleMediaFunction = id -> absentMedia;
+		assertSame(
+			absentMedia,
+			catalogMediaDataAccess.getMedia(absentMedia.getID()),
+			"The media absent from the catalog wasn't looked up in the source"
+		);
+	}
+
+	private static MediaStub createMedia(String title) {
+		MediaStub media = new MediaStub();
+		media.id = UUID.randomUUID();
+		media.title = title;
+		return media;
+	}
+}
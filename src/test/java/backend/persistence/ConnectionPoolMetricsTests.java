@@ -0,0 +1,64 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import com.zaxxer.hikari.metrics.IMetricsTracker;
+import com.zaxxer.hikari.metrics.PoolStats;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class ConnectionPoolMetricsTests {
+
+	ConnectionPoolMetrics connectionPoolMetrics = new ConnectionPoolMetrics();
+
+	@Test
+	void waitTimeTest() {
+		IMetricsTracker tracker = connectionPoolMetrics.create("test", new PoolStatsStub(0, 1));
+		assertEquals(0, connectionPoolMetrics.getAverageWaitNanos(), "The wait time without acquisitions isn't 0");
+
+		tracker.recordConnectionAcquiredNanos(100);
+		tracker.recordConnectionAcquiredNanos(300);
+		tracker.recordConnectionTimeout();
+		assertEquals(2, connectionPoolMetrics.getAcquisitions(), "Unexpected amount of acquisitions");
+		assertEquals(200, connectionPoolMetrics.getAverageWaitNanos(), "Unexpected average wait time");
+		assertEquals(300, connectionPoolMetrics.getMaxWaitNanos(), "Unexpected maximum wait time");
+		assertEquals(1, connectionPoolMetrics.getTimeouts(), "Unexpected amount of timeouts");
+	}
+
+	@Test
+	void utilizationTest() {
+		assertEquals(0, connectionPoolMetrics.getUtilization(), "The utilization of a missing pool isn't 0");
+		connectionPoolMetrics.create("test", new PoolStatsStub(3, 4));
+		assertEquals(0.75, connectionPoolMetrics.getUtilization(), "Unexpected utilization");
+	}
+
+	static class PoolStatsStub extends PoolStats {
+
+		PoolStatsStub(int activeConnections, int maxConnections) {
+			super(0);
+			this.activeConnections = activeConnections;
+			this.maxConnections = maxConnections;
+		}
+
+		@Override
+		protected void update() { }
+	}
+}
@@ -0,0 +1,87 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.persistence;
+
+import backend.stubs.MediaStub;
+import org.junit.jupiter.api.Test;
+
+import java.util.UUID;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class MediaCacheTests {
+
+	long now = 0;
+
+	MediaCache mediaCache = new MediaCache(2, 10, () -> now);
+
+	@Test
+	void hitAndMissTest() {
+		MediaStub media = new MediaStub();
+		assertNull(mediaCache.get(media.getID()), "An absent media was returned");
+		mediaCache.put(media, mediaCache.getGeneration());
+		assertSame(media, mediaCache.get(media.getID()), "The cached media wasn't returned");
+		assertEquals(1, mediaCache.getHits(), "Unexpected amount of hits");
+		assertEquals(1, mediaCache.getMisses(), "Unexpected amount of misses");
+	}
+
+	@Test
+	void expirationTest() {
+		MediaStub media = new MediaStub();
+		mediaCache.put(media, mediaCache.getGeneration());
+		now += 9_000_000_000L;
+		assertSame(media, mediaCache.get(media.getID()), "The media expired before its time-to-live");
+		now += 1_000_000_000L;
+		assertNull(mediaCache.get(media.getID()), "The media didn't expire");
+	}
+
+	@Test
+	void evictionTest() {
+		MediaStub[] media = {new MediaStub(), new MediaStub(), new MediaStub()};
+		mediaCache.put(media[0], mediaCache.getGeneration());
+		mediaCache.put(media[1], mediaCache.getGeneration());
+		mediaCache.get(media[0].getID());
+		mediaCache.put(media[2], mediaCache.getGeneration());
+		assertSame(media[0], mediaCache.get(media[0].getID()), "The recently used media was evicted");
+		assertNull(mediaCache.get(media[1].getID()), "The least recently used media wasn't evicted");
+		assertSame(media[2], mediaCache.get(media[2].getID()), "The newest media was evicted");
+	}
+
+	@Test
+	void invalidationTest() {
+		MediaStub[] media = {new MediaStub(), new MediaStub()};
+		mediaCache.put(media[0], mediaCache.getGeneration());
+		mediaCache.put(media[1], mediaCache.getGeneration());
+		mediaCache.invalidate(media[0].getID());
+		assertNull(mediaCache.get(media[0].getID()), "The invalidated media was returned");
+		assertSame(media[1], mediaCache.get(media[1].getID()), "Another media was invalidated");
+		mediaCache.invalidateAll();
+		assertNull(mediaCache.get(media[1].getID()), "The invalidated media was returned");
+	}
+
+	@Test
+	void outdatedPutIsIgnoredTest() {
+		MediaStub media = new MediaStub();
+		long generation = mediaCache.getGeneration();
+		mediaCache.invalidate(UUID.randomUUID());
+		mediaCache.put(media, generation);
+		assertNull(mediaCache.get(media.getID()), "The media loaded before the invalidation was cached");
+	}
+}
@@ -21,11 +21,13 @@ package backend.persistence;
 
 import backend.exceptions.CommonDataAccessException;
 import backend.exceptions.CorruptedDataException;
+import backend.exceptions.QueryingException;
 import backend.exceptions.QueryingStrategyFactoryException;
 import backend.stubs.QueryingStrategyFactoryStub;
 import backend.stubs.SqlAccessStrategyStub;
 import backend.stubs.SqlRowStub;
 import backend.models.Media;
+import backend.models.MediaPage;
 import backend.models.SqlRow;
 import org.junit.jupiter.api.BeforeEach;
 import org.junit.jupiter.api.Nested;
@@ -37,6 +39,7 @@ import java.net.URI;
 import java.sql.SQLException;
 import java.util.Arrays;
 import java.util.UUID;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.stream.Stream;
 
 import static org.junit.jupiter.api.Assertions.*;
@@ -88,13 +91,21 @@ public class SqlMediaDataAccessTests {
 
 				return Stream.of(generateSqlRows(1));
 			};
+			AtomicInteger instantiations = new AtomicInteger();
 			queryingStrategyFactoryStub.getQueryingStrategyFunction = uri -> {
 				assertEquals(URI.create("test_uri"), uri);
-
+				instantiations.incrementAndGet();
 				throw new QueryingStrategyFactoryException();
 			};
 
-			assertEquals(0, sqlMediaDataAccess.getMedia().length, "An empty stream is expected");
+			Media[] retrievedMedia = sqlMediaDataAccess.getMedia();
+			assertEquals(1, retrievedMedia.length, "The media is expected to be listed");
+			assertEquals(0, instantiations.get(), "The querying strategy was instantiated while listing");
+			assertThrows(
+				QueryingException.class,
+				() -> retrievedMedia[0].retrieveVideoClips(0, 1),
+				"The retrieval didn't throw " + QueryingException.class.getSimpleName()
+			);
 		}
 
 		@Test
@@ -283,6 +294,27 @@ public class SqlMediaDataAccessTests {
 				"The content URI doesn't match"
 			);
 		}
+
+		@Test
+		void cachedRetrievalTest() {
+			SqlRow sqlRowStub = generateSqlRows(1)[0];
+			UUID mediaId = UUID.fromString(sqlRowStub.getString("id"));
+			AtomicInteger queries = new AtomicInteger();
+			sqlAccessStrategyStub.querySingleSqlRowFunction = (key, columns) -> {
+				queries.incrementAndGet();
+				return sqlRowStub;
+			};
+			MediaCache mediaCache = new MediaCache(1, 60);
+			sqlMediaDataAccess.setMediaCache(mediaCache);
+
+			Media retrievedMedia = sqlMediaDataAccess.getMedia(mediaId);
+			assertSame(retrievedMedia, sqlMediaDataAccess.getMedia(mediaId), "The cached media wasn't returned");
+			assertEquals(1, queries.get(), "The cached media was queried again");
+
+			mediaCache.invalidate(mediaId);
+			assertNotSame(retrievedMedia, sqlMediaDataAccess.getMedia(mediaId), "The invalidated media was returned");
+			assertEquals(2, queries.get(), "The invalidated media wasn't queried again");
+		}
 	}
 
 	@Nested
@@ -320,15 +352,20 @@ public class SqlMediaDataAccessTests {
 
 				return Stream.of(generateSqlRows(1));
 			};
+			AtomicInteger instantiations = new AtomicInteger();
 			queryingStrategyFactoryStub.getQueryingStrategyFunction = uri -> {
 				assertEquals(URI.create("test_uri"), uri);
+				instantiations.incrementAndGet();
 				throw new QueryingStrategyFactoryException();
 			};
 
-			assertEquals(
-				0,
-				sqlMediaDataAccess.searchMedia(searchQuery).length,
-				"An empty stream is expected"
+			Media[] retrievedMedia = sqlMediaDataAccess.searchMedia(searchQuery);
+			assertEquals(1, retrievedMedia.length, "The media is expected to be listed");
+			assertEquals(0, instantiations.get(), "The querying strategy was instantiated while listing");
+			assertThrows(
+				QueryingException.class,
+				() -> retrievedMedia[0].retrieveAudioClips(0, 1),
+				"The retrieval didn't throw " + QueryingException.class.getSimpleName()
 			);
 		}
 
@@ -404,6 +441,109 @@ public class SqlMediaDataAccessTests {
 		}
 	}
 
+	@Nested
+	class SearchMediaPage {
+
+		@Test
+		void passCursor() {
+			UUID lastId = UUID.randomUUID();
+			sqlAccessStrategyStub.searchInTitlePageFunction = (query, limit, lastRank, id, columns) -> {
+				assertEquals("query", query, "The passed search query doesn't match");
+				assertEquals(3, limit, "One more row than the limit is expected to be requested");
+				assertEquals(0.25f, lastRank, "The passed last rank doesn't match");
+				assertEquals(lastId.toString(), id, "The passed last id doesn't match");
+				return Stream.empty();
+			};
+
+			MediaPage page = sqlMediaDataAccess.searchMedia("query", 2, "0.25:" + lastId);
+			assertEquals(0, page.media().length, "An empty page is expected");
+			assertNull(page.cursor(), "The last page has a cursor");
+		}
+
+		@ParameterizedTest
+		@ValueSource(strings = {"", "abcd", "0.25", "0.25:", "abcd:id", "NaN:id"})
+		void passInvalidCursor(String cursor) {
+			assertThrows(
+				IllegalArgumentException.class,
+				() -> sqlMediaDataAccess.searchMedia("query", 1, cursor),
+				"The querying method didn't throw " + IllegalArgumentException.class.getSimpleName()
+			);
+		}
+
+		@ParameterizedTest
+		@ValueSource(ints = {0, 1, 2, 3})
+		void retrievalTest(int resultSize) {
+			int pageSize = 2;
+			SqlRow[] result = generateSqlRows(resultSize);
+			for (int i = 0; i < resultSize; i++) {
+				((SqlRowStub) result[i]).hashMap.put(SqlAccessStrategy.SEARCH_RANK_COLUMN, 1f / (i + 1));
+			}
+			sqlAccessStrategyStub.searchInTitlePageFunction = (query, limit, lastRank, lastId, columns) -> {
+				assertNull(lastRank, "The first page is requested with the last rank");
+				assertNull(lastId, "The first page is requested with the last id");
+				return Arrays.stream(result).limit(limit);
+			};
+
+			MediaPage page = sqlMediaDataAccess.searchMedia("query", pageSize, null);
+
+			assertEquals(Math.min(resultSize, pageSize), page.media().length, "Unexpected page size");
+			for (int i = 0; i < page.media().length; i++) {
+				assertEquals(
+					result[i].getString("id"),
+					page.media()[i].getID().toString(),
+					"The media id doesn't match in the media no. " + i
+				);
+			}
+			if (resultSize > pageSize) {
+				SqlRow lastRow = result[pageSize - 1];
+				assertEquals(
+					lastRow.getFloat(SqlAccessStrategy.SEARCH_RANK_COLUMN) + ":" + lastRow.getString("id"),
+					page.cursor(),
+					"The cursor doesn't point at the last media of the page"
+				);
+			} else {
+				assertNull(page.cursor(), "The last page has a cursor");
+			}
+		}
+	}
+
+	@Nested
+	class SuggestMedia {
+
+		@Test
+		void failDataAccess() {
+			sqlAccessStrategyStub.searchTitlePrefixFunction = (prefix, limit, columns) -> {
+				throw new SQLException();
+			};
+
+			assertThrows(
+				CommonDataAccessException.class,
+				() -> sqlMediaDataAccess.suggestMedia("ti", 1),
+				"The querying method didn't throw " + CommonDataAccessException.class.getSimpleName()
+			);
+		}
+
+		@Test
+		void retrievalTest() {
+			SqlRow[] result = generateSqlRows(2);
+			sqlAccessStrategyStub.searchTitlePrefixFunction = (prefix, limit, columns) -> {
+				assertEquals("ti", prefix, "The passed prefix doesn't match");
+				assertEquals(5, limit, "The passed limit doesn't match");
+				return Arrays.stream(result);
+			};
+
+			Media[] retrievedMedia = sqlMediaDataAccess.suggestMedia("ti", 5);
+			assertEquals(result.length, retrievedMedia.length, "The number of media doesn't match");
+			for (int i = 0; i < result.length; i++) {
+				assertEquals(
+					result[i].getString("id"),
+					retrievedMedia[i].getID().toString(),
+					"The media id doesn't match in the media no. " + i
+				);
+			}
+		}
+	}
+
 	private SqlRow[] generateSqlRows(int amount) {
 		SqlRow[] result = new SqlRow[amount];
 		for (int i = 0; i < amount; i++) {
@@ -0,0 +1,108 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.adapters.ArraySeekableByteChannel;
+import backend.stubs.QueryingStrategyInterfaceStub;
+import org.junit.jupiter.api.Test;
+
+import java.io.IOException;
+import java.net.URI;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import static backend.querying.MappedRegionCacheTests.readFully;
+import static org.junit.jupiter.api.Assertions.*;
+
+public class CachingQueryingStrategyTests {
+
+	List<String> queriedNames = new ArrayList<>();
+
+	QueryingStrategyInterfaceStub queryingStrategyStub = new QueryingStrategyInterfaceStub();
+
+	ClipCache clipCache = new ClipCache(1024);
+
+	CachingQueryingStrategy cachingQueryingStrategy = new CachingQueryingStrategy(
+		queryingStrategyStub, URI.create("file:///media/1"), clipCache
+	);
+
+	{
+		queryingStrategyStub.queryFunction = names -> {
+			queriedNames.addAll(Arrays.asList(names));
+			return Arrays.stream(names)
+				.map(name -> new ArraySeekableByteChannel(("content of " + name).getBytes(StandardCharsets.UTF_8)))
+				.toArray(SeekableByteChannel[]::new);
+		};
+	}
+
+	@Test
+	void queryTest() throws IOException {
+		assertEquals("content of v0", readFully(cachingQueryingStrategy.query("v0")), "Unexpected content of v0");
+		assertEquals("content of v0", readFully(cachingQueryingStrategy.query("v0")), "Unexpected cached content");
+		assertEquals(List.of("v0"), queriedNames, "The cached resource was queried again");
+
+		SeekableByteChannel[] channels = cachingQueryingStrategy.query(new String[] {"v0", "a0"});
+		assertEquals("content of v0", readFully(channels[0]), "Unexpected content of v0");
+		assertEquals("content of a0", readFully(channels[1]), "Unexpected content of a0");
+		assertEquals(List.of("v0", "a0"), queriedNames, "Only the missing resources had to be queried");
+		assertEquals(2, clipCache.getHits(), "Unexpected amount of hits");
+	}
+
+	@Test
+	void rejectionTest() {
+		List<SeekableByteChannel> queriedChannels = new ArrayList<>();
+		queryingStrategyStub.queryFunction = names -> {
+			SeekableByteChannel[] channels = new SeekableByteChannel[names.length];
+			for (int i = 0; i < names.length; i++) channels[i] = new ArraySeekableByteChannel(new byte[128]);
+			queriedChannels.addAll(Arrays.asList(channels));
+			return channels;
+		};
+		for (int i = 0; i < 8; i++) {
+			for (int j = 0; j < 3; j++) cachingQueryingStrategy.query("v" + i);
+		}
+		assertEquals(1024, clipCache.getCachedBytes(), "The hot resources weren't cached");
+
+		SeekableByteChannel channel = cachingQueryingStrategy.query("a0");
+		assertSame(queriedChannels.getLast(), channel, "The rejected resource was copied");
+		assertEquals(1, clipCache.getRejections(), "The rejection wasn't counted");
+	}
+
+	@Test
+	void replacementTest() throws Exception {
+		assertEquals("content of v0", readFully(cachingQueryingStrategy.query("v0")), "Unexpected content of v0");
+		CachingQueryingStrategy replacement = new CachingQueryingStrategy(
+			queryingStrategyStub, URI.create("file:///media/1"), clipCache
+		);
+		queryingStrategyStub.queryFunction = names -> Arrays.stream(names)
+			.map(name -> new ArraySeekableByteChannel(("new content of " + name).getBytes(StandardCharsets.UTF_8)))
+			.toArray(SeekableByteChannel[]::new);
+		assertEquals(
+			"new content of v0",
+			readFully(replacement.query("v0")),
+			"The resource cached by the replaced strategy was served"
+		);
+
+		queryingStrategyStub.closeRunnable = () -> { };
+		cachingQueryingStrategy.close();
+		assertEquals("new content of v0".length(), clipCache.getCachedBytes(), "The replaced resources weren't freed");
+	}
+}
@@ -0,0 +1,101 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import org.junit.jupiter.api.Test;
+
+import java.net.URI;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class ClipCacheTests {
+
+	URI contentUri = URI.create("file:///media/1");
+
+	long generation = ClipCache.newGeneration();
+
+	ClipCache clipCache = new ClipCache(800);
+
+	@Test
+	void hitRatioTest() {
+		ClipCache.Key key = new ClipCache.Key(contentUri, generation, "v0");
+		assertNull(clipCache.get(key), "An absent clip was returned");
+		byte[] content = new byte[10];
+		assertTrue(clipCache.put(key, content), "The clip wasn't admitted into the empty cache");
+		assertSame(content, clipCache.get(key), "The cached content wasn't returned");
+		assertEquals(1, clipCache.getHits(), "Unexpected amount of hits");
+		assertEquals(1, clipCache.getMisses(), "Unexpected amount of misses");
+		assertEquals(0.5, clipCache.getHitRatio(), "Unexpected hit ratio");
+		assertEquals(10, clipCache.getCachedBytes(), "Unexpected amount of cached bytes");
+	}
+
+	@Test
+	void admissionTest() {
+		for (int i = 0; i < 8; i++) {
+			ClipCache.Key key = new ClipCache.Key(contentUri, generation, "v" + i);
+			for (int j = 0; j < 3; j++) clipCache.get(key);
+			assertTrue(clipCache.put(key, new byte[100]), "The clip wasn't admitted while the cache had room");
+		}
+		clipCache.get(new ClipCache.Key(contentUri, generation, "v0"));
+
+		ClipCache.Key candidate = new ClipCache.Key(URI.create("file:///media/2"), generation, "v0");
+		clipCache.get(candidate);
+		assertFalse(clipCache.admits(candidate, 100), "A cold clip would evict a hot one");
+		assertFalse(clipCache.put(candidate, new byte[100]), "A cold clip evicted a hot one");
+		assertEquals(2, clipCache.getRejections(), "The rejections weren't counted");
+
+		for (int j = 0; j < 4; j++) clipCache.get(candidate);
+		assertTrue(clipCache.admits(candidate, 100), "A clip hotter than the residents wouldn't be admitted");
+		assertTrue(clipCache.put(candidate, new byte[100]), "A clip hotter than the residents wasn't admitted");
+		assertEquals(800, clipCache.getCachedBytes(), "The capacity was exceeded");
+		assertNull(
+			clipCache.get(new ClipCache.Key(contentUri, generation, "v1")),
+			"The least recently used clip wasn't evicted"
+		);
+		assertNotNull(
+			clipCache.get(new ClipCache.Key(contentUri, generation, "v0")), "A recently used clip was evicted"
+		);
+	}
+
+	@Test
+	void oversizedClipTest() {
+		assertFalse(
+			clipCache.put(
+				new ClipCache.Key(contentUri, generation, "v0"), new byte[(int) clipCache.getMaxClipSize() + 1]
+			),
+			"An oversized clip was admitted"
+		);
+		assertEquals(0, clipCache.getCachedBytes(), "An oversized clip was cached");
+	}
+
+	@Test
+	void invalidationTest() {
+		long nextGeneration = ClipCache.newGeneration();
+		ClipCache.Key key = new ClipCache.Key(contentUri, generation, "v0");
+		ClipCache.Key nextKey = new ClipCache.Key(contentUri, nextGeneration, "v0");
+		assertTrue(clipCache.put(key, new byte[10]), "The clip wasn't admitted into the empty cache");
+		assertNull(clipCache.get(nextKey), "A clip of another generation was returned");
+		assertTrue(clipCache.put(nextKey, new byte[20]), "The clip wasn't admitted while the cache had room");
+
+		clipCache.invalidate(generation);
+		assertNull(clipCache.get(key), "An invalidated clip was returned");
+		assertNotNull(clipCache.get(nextKey), "A clip of another generation was invalidated");
+		assertEquals(20, clipCache.getCachedBytes(), "The invalidated clip is still counted");
+	}
+}
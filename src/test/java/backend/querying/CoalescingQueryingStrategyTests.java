@@ -0,0 +1,137 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.adapters.ArraySeekableByteChannel;
+import backend.stubs.QueryingStrategyInterfaceStub;
+import org.junit.jupiter.api.Test;
+
+import java.net.URI;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.BooleanSupplier;
+
+import static backend.querying.MappedRegionCacheTests.readFully;
+import static backend.querying.ReadAheadQueryingStrategyTests.waitUntil;
+import static org.junit.jupiter.api.Assertions.*;
+
+public class CoalescingQueryingStrategyTests {
+
+	Map<String, AtomicInteger> queries = new ConcurrentHashMap<>();
+
+	CountDownLatch queriesAllowed = new CountDownLatch(1);
+
+	QueryingStrategyInterfaceStub queryingStrategyStub = new QueryingStrategyInterfaceStub();
+
+	{
+		queryingStrategyStub.queryFunction = names -> {
+			try {
+				queriesAllowed.await();
+			} catch (InterruptedException e) {
+				throw new RuntimeException(e);
+			}
+			SeekableByteChannel[] channels = new SeekableByteChannel[names.length];
+			for (int i = 0; i < names.length; i++) {
+				queries.computeIfAbsent(names[i], name -> new AtomicInteger()).incrementAndGet();
+				channels[i] = new ArraySeekableByteChannel(("content of " + names[i]).getBytes(StandardCharsets.UTF_8));
+			}
+			return channels;
+		};
+	}
+
+	@Test
+	void coalescingTest() throws Exception {
+		ReadCoalescer readCoalescer = new ReadCoalescer(1024);
+		ClipCache clipCache = new ClipCache(1024);
+		CoalescingQueryingStrategy coalescingQueryingStrategy = new CoalescingQueryingStrategy(
+			queryingStrategyStub, URI.create("file:///media/1"), readCoalescer, clipCache
+		);
+		List<String> contents = queryConcurrently(coalescingQueryingStrategy, () -> readCoalescer.getReads() == 8);
+		for (String content: contents) assertEquals("content of v0", content, "Unexpected content of v0");
+		assertEquals(1, queries.get("v0").get(), "The concurrent queries weren't coalesced");
+		assertEquals(7, readCoalescer.getCoalescedReads(), "Unexpected amount of coalesced reads");
+		assertEquals(7.0 / 8, readCoalescer.getCoalesceRatio(), "Unexpected coalesce ratio");
+
+		assertEquals("content of v0", readFully(coalescingQueryingStrategy.query("v0")), "Unexpected cached content");
+		assertEquals(1, queries.get("v0").get(), "The cached resource was queried again");
+	}
+
+	@Test
+	void oversizedResourceTest() throws Exception {
+		ReadCoalescer readCoalescer = new ReadCoalescer(5);
+		CoalescingQueryingStrategy coalescingQueryingStrategy = new CoalescingQueryingStrategy(
+			queryingStrategyStub, URI.create("file:///media/1"), readCoalescer, null
+		);
+		List<String> contents = queryConcurrently(coalescingQueryingStrategy, () -> readCoalescer.getReads() == 8);
+		for (String content: contents) assertEquals("content of v0", content, "Unexpected content of v0");
+		assertEquals(0, readCoalescer.getCoalescedReads(), "An oversized resource was shared");
+		assertTrue(queries.get("v0").get() > 1, "The queries that joined the flight didn't query on their own");
+	}
+
+	@Test
+	void unsharedResourceTest() throws Exception {
+		List<SeekableByteChannel> underlyingChannels = new ArrayList<>();
+		queryingStrategyStub.queryFunction = names -> {
+			SeekableByteChannel channel = new ArraySeekableByteChannel("content".getBytes(StandardCharsets.UTF_8));
+			underlyingChannels.add(channel);
+			return new SeekableByteChannel[] {channel};
+		};
+		ReadCoalescer readCoalescer = new ReadCoalescer(1024);
+		CoalescingQueryingStrategy coalescingQueryingStrategy = new CoalescingQueryingStrategy(
+			queryingStrategyStub, URI.create("file:///media/1"), readCoalescer, null
+		);
+
+		for (int i = 0; i < 2; i++) {
+			SeekableByteChannel channel = coalescingQueryingStrategy.query("v0");
+			assertSame(underlyingChannels.getLast(), channel, "A resource nobody shared was copied");
+		}
+		assertEquals(2, underlyingChannels.size(), "The abandoned flight wasn't ended");
+		assertEquals(0, readCoalescer.getCoalescedReads(), "Unexpected amount of coalesced reads");
+	}
+
+	List<String> queryConcurrently(
+		CoalescingQueryingStrategy coalescingQueryingStrategy, BooleanSupplier allJoined
+	) throws Exception {
+		List<Future<String>> futures = new ArrayList<>();
+		List<String> contents = new ArrayList<>();
+		try (ExecutorService executor = Executors.newVirtualThreadPerTaskExecutor()) {
+			for (int i = 0; i < 8; i++) {
+				futures.add(executor.submit(() -> {
+					try (SeekableByteChannel channel = coalescingQueryingStrategy.query("v0")) {
+						return readFully(channel);
+					}
+				}));
+			}
+			assertTrue(waitUntil(allJoined), "The queries didn't join");
+			queriesAllowed.countDown();
+			for (Future<String> future: futures) contents.add(future.get(10, TimeUnit.SECONDS));
+		}
+		return contents;
+	}
+}
@@ -0,0 +1,179 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import backend.exceptions.QueryingStrategyFactoryException;
+import backend.ingestion.MediaPacker;
+import backend.models.DefaultMedia;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.io.IOException;
+import java.net.URI;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.UUID;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class DefaultQueryingStrategyFactoryTests {
+
+	@TempDir
+	Path directory;
+
+	@Test
+	void evictionTest() throws IOException {
+		Path first = packedMedia("first"), second = packedMedia("second");
+		DefaultQueryingStrategyFactory factory = new DefaultQueryingStrategyFactory(1);
+		QueryingStrategyInterface firstStrategy = factory.getQueryingStrategy(first.toUri());
+		assertSame(firstStrategy, factory.getQueryingStrategy(first.toUri()), "The strategy wasn't cached");
+		firstStrategy.query("v0").close();
+
+		QueryingStrategyInterface secondStrategy = factory.getQueryingStrategy(second.toUri());
+		assertThrows(QueryingException.class, () -> firstStrategy.query("v0"), "The evicted strategy wasn't closed");
+		assertNotSame(firstStrategy, factory.getQueryingStrategy(first.toUri()), "The evicted strategy was returned");
+		assertThrows(QueryingException.class, () -> secondStrategy.query("v0"), "The evicted strategy wasn't closed");
+	}
+
+	@Test
+	void mediaEvictionTest() throws IOException {
+		Path first = packedMedia("first"), second = packedMedia("second");
+		DefaultQueryingStrategyFactory factory = new DefaultQueryingStrategyFactory();
+		DefaultMedia firstMedia = new DefaultMedia(UUID.randomUUID(), "first", 1, first.toUri(), factory);
+		DefaultMedia secondMedia = new DefaultMedia(UUID.randomUUID(), "second", 1, second.toUri(), factory);
+		assertEquals("content of v0", MappedRegionCacheTests.readFully(firstMedia.retrieveVideoClips(0, 1)[0]));
+
+		factory.setCapacity(1);
+		assertEquals("content of v0", MappedRegionCacheTests.readFully(secondMedia.retrieveVideoClips(0, 1)[0]));
+		assertEquals(
+			"content of v0",
+			MappedRegionCacheTests.readFully(firstMedia.retrieveVideoClips(0, 1)[0]),
+			"The media queried its evicted strategy"
+		);
+	}
+
+	@Test
+	void concurrentInstantiationTest() throws Exception {
+		Path media = packedMedia("media");
+		DefaultQueryingStrategyFactory factory = new DefaultQueryingStrategyFactory();
+		List<Future<QueryingStrategyInterface>> futures = new ArrayList<>();
+		try (ExecutorService executor = Executors.newVirtualThreadPerTaskExecutor()) {
+			for (int i = 0; i < 16; i++) futures.add(executor.submit(() -> factory.getQueryingStrategy(media.toUri())));
+		}
+		for (Future<QueryingStrategyInterface> future: futures) {
+			assertSame(futures.getFirst().get(), future.get(), "The strategy was instantiated more than once");
+		}
+	}
+
+	@Test
+	void failedInstantiationTest() throws IOException {
+		Path media = directory.resolve("media");
+		URI uri = media.toUri();
+		DefaultQueryingStrategyFactory factory = new DefaultQueryingStrategyFactory();
+		assertThrows(
+			QueryingStrategyFactoryException.class,
+			() -> factory.getQueryingStrategy(uri),
+			"A strategy of an absent directory was instantiated"
+		);
+		Files.createDirectory(media);
+		assertInstanceOf(
+			FSQueryingStrategy.class,
+			factory.getQueryingStrategy(uri),
+			"The failed instantiation was cached"
+		);
+	}
+
+	@Test
+	void layoutChangeTest() throws IOException {
+		Path media = Files.createDirectory(directory.resolve("media"));
+		Files.writeString(media.resolve("v0"), "first content");
+		DefaultQueryingStrategyFactory factory = new DefaultQueryingStrategyFactory();
+		factory.setRevalidationInterval(0);
+		assertInstanceOf(FSQueryingStrategy.class, factory.getQueryingStrategy(media.toUri()), "Unexpected strategy");
+
+		MediaPacker.pack(media);
+		MediaPacker.removeClips(media);
+		QueryingStrategyInterface packedStrategy = factory.getQueryingStrategy(media.toUri());
+		assertInstanceOf(PackedQueryingStrategy.class, packedStrategy, "The pack file wasn't picked up");
+		SeekableByteChannel channel = packedStrategy.query("v0");
+
+		Files.writeString(media.resolve("v0"), "second content");
+		MediaPacker.pack(media);
+		assertEquals(
+			"second content",
+			MappedRegionCacheTests.readFully(factory.getQueryingStrategy(media.toUri()).query("v0")),
+			"The replaced pack file was read"
+		);
+		assertThrows(QueryingException.class, () -> packedStrategy.query("v0"), "The outdated strategy wasn't closed");
+		assertEquals("first content", MappedRegionCacheTests.readFully(channel), "The open slice was broken");
+		channel.close();
+	}
+
+	@Test
+	void revalidationIntervalTest() throws IOException {
+		Path media = Files.createDirectory(directory.resolve("media"));
+		Files.writeString(media.resolve("v0"), "content of v0");
+		DefaultQueryingStrategyFactory factory = new DefaultQueryingStrategyFactory();
+		factory.setRevalidationInterval(3600);
+		QueryingStrategyInterface strategy = factory.getQueryingStrategy(media.toUri());
+
+		MediaPacker.pack(media);
+		assertSame(strategy, factory.getQueryingStrategy(media.toUri()), "The strategy was revalidated too early");
+		factory.setRevalidationInterval(0);
+		assertInstanceOf(
+			PackedQueryingStrategy.class,
+			factory.getQueryingStrategy(media.toUri()),
+			"The strategy wasn't revalidated once the interval passed"
+		);
+	}
+
+	@Test
+	void readAheadTest() throws IOException {
+		Path media = packedMedia("media");
+		DefaultQueryingStrategyFactory factory = new DefaultQueryingStrategyFactory();
+		factory.setReadAheadClips(2);
+		assertInstanceOf(
+			ReadAheadQueryingStrategy.class, factory.getQueryingStrategy(media.toUri()), "The media isn't read ahead"
+		);
+
+		DefaultQueryingStrategyFactory mappingFactory = new DefaultQueryingStrategyFactory();
+		mappingFactory.setReadAheadClips(2);
+		mappingFactory.setMappedRegionCache(new MappedRegionCache(1024));
+		assertInstanceOf(
+			MmapQueryingStrategy.class,
+			mappingFactory.getQueryingStrategy(media.toUri()),
+			"The mapped media is read ahead"
+		);
+	}
+
+	private Path packedMedia(String name) throws IOException {
+		Path media = Files.createDirectory(directory.resolve(name));
+		Files.writeString(media.resolve("v0"), "content of v0");
+		MediaPacker.pack(media);
+		return media;
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.io.TempDir;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+import java.io.IOException;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+
+import static backend.querying.MappedRegionCacheTests.readFully;
+import static org.junit.jupiter.api.Assertions.*;
+
+public class FSQueryingStrategyTests {
+
+	@TempDir
+	Path directory;
+
+	String[] clipNames = new String[20];
+
+	@BeforeEach
+	void writeClips() throws IOException {
+		for (int i = 0; i < clipNames.length; i++) {
+			clipNames[i] = (i % 2 == 0 ? "v" : "a") + i / 2;
+			Files.writeString(directory.resolve(clipNames[i]), "content of " + clipNames[i]);
+		}
+	}
+
+	@ParameterizedTest
+	@ValueSource(ints = {1, 4, 32})
+	void queryTest(int openParallelism) throws IOException {
+		FSQueryingStrategy fsQueryingStrategy = new FSQueryingStrategy(directory, openParallelism);
+		SeekableByteChannel[] channels = fsQueryingStrategy.query(clipNames);
+		for (int i = 0; i < clipNames.length; i++) {
+			assertEquals("content of " + clipNames[i], readFully(channels[i]), "Unexpected content of " + clipNames[i]);
+			channels[i].close();
+		}
+
+		String[] namesWithAbsent = clipNames.clone();
+		namesWithAbsent[namesWithAbsent.length / 2] = "v100";
+		assertThrows(
+			QueryingException.class, () -> fsQueryingStrategy.query(namesWithAbsent), "An absent resource was returned"
+		);
+	}
+}
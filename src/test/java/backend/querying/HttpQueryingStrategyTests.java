@@ -0,0 +1,164 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import com.sun.net.httpserver.HttpExchange;
+import com.sun.net.httpserver.HttpServer;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.URI;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static backend.querying.MappedRegionCacheTests.readFully;
+import static backend.querying.ReadAheadQueryingStrategyTests.waitUntil;
+import static org.junit.jupiter.api.Assertions.*;
+
+public class HttpQueryingStrategyTests {
+
+	@TempDir
+	Path cacheDirectory;
+
+	// A stand-in for a static file server in front of the media library of the origin
+	HttpServer server;
+
+	AtomicInteger requests = new AtomicInteger();
+
+	CountDownLatch responsesAllowed = new CountDownLatch(0);
+
+	HttpOriginClient httpOriginClient;
+
+	URI baseUri;
+
+	@BeforeEach
+	void startServer() throws IOException {
+		server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+		server.setExecutor(Executors.newVirtualThreadPerTaskExecutor());
+		server.createContext("/", this::handle);
+		server.start();
+		baseUri = URI.create("http://localhost:" + server.getAddress().getPort() + "/media/movie");
+		httpOriginClient = new HttpOriginClient(cacheDirectory, 1024);
+	}
+
+	@AfterEach
+	void stopServer() {
+		httpOriginClient.close();
+		server.stop(0);
+	}
+
+	@Test
+	void queryTest() throws IOException {
+		HttpQueryingStrategy httpQueryingStrategy = new HttpQueryingStrategy(httpOriginClient, baseUri);
+		SeekableByteChannel[] channels = httpQueryingStrategy.query(new String[] {"v0", "a0"});
+		assertEquals("content of v0", readFully(channels[0]), "Unexpected content of v0");
+		assertEquals("content of a0", readFully(channels[1]), "Unexpected content of a0");
+		for (SeekableByteChannel channel: channels) channel.close();
+		assertEquals(2, requests.get(), "Unexpected amount of requests");
+
+		httpQueryingStrategy.query("v0").close();
+		assertEquals(2, requests.get(), "The cached resource was requested again");
+		assertEquals(1, httpOriginClient.getCacheHits(), "Unexpected amount of cache hits");
+
+		assertThrows(
+			QueryingException.class, () -> httpQueryingStrategy.query("v9"), "An absent resource was returned"
+		);
+
+		// The cached files are reused by a new instance
+		httpOriginClient.close();
+		httpOriginClient = new HttpOriginClient(cacheDirectory, 1024);
+		try (SeekableByteChannel channel = new HttpQueryingStrategy(httpOriginClient, baseUri).query("a0")) {
+			assertEquals("content of a0", readFully(channel), "Unexpected content of a0");
+		}
+		assertEquals(3, requests.get(), "The resource cached by a previous instance was requested again");
+	}
+
+	@Test
+	void coalescingTest() throws Exception {
+		responsesAllowed = new CountDownLatch(1);
+		HttpQueryingStrategy httpQueryingStrategy = new HttpQueryingStrategy(httpOriginClient, baseUri);
+		List<Future<String>> contents = new ArrayList<>();
+		try (ExecutorService executor = Executors.newVirtualThreadPerTaskExecutor()) {
+			for (int i = 0; i < 8; i++) {
+				contents.add(executor.submit(() -> {
+					try (SeekableByteChannel channel = httpQueryingStrategy.query("v1")) {
+						return readFully(channel);
+					}
+				}));
+			}
+			assertTrue(
+				waitUntil(() -> httpOriginClient.getCoalescedFetches() == 7), "The concurrent fetches weren't coalesced"
+			);
+			responsesAllowed.countDown();
+			for (Future<String> content: contents) {
+				assertEquals("content of v1", content.get(10, TimeUnit.SECONDS), "Unexpected content of v1");
+			}
+		}
+		assertEquals(1, requests.get(), "The concurrent fetches sent several requests");
+	}
+
+	@Test
+	void evictionTest() throws IOException {
+		httpOriginClient.close();
+		httpOriginClient = new HttpOriginClient(cacheDirectory, 20);
+		HttpQueryingStrategy httpQueryingStrategy = new HttpQueryingStrategy(httpOriginClient, baseUri);
+		httpQueryingStrategy.query("v0").close();
+		httpQueryingStrategy.query("v1").close();
+		assertEquals(13, httpOriginClient.getCachedBytes(), "The capacity was exceeded");
+		httpQueryingStrategy.query("v1").close();
+		httpQueryingStrategy.query("v0").close();
+		assertEquals(3, requests.get(), "Unexpected amount of requests");
+	}
+
+	void handle(HttpExchange exchange) throws IOException {
+		requests.incrementAndGet();
+		try (exchange) {
+			responsesAllowed.await();
+			String path = exchange.getRequestURI().getPath();
+			String clipName = path.substring(path.lastIndexOf('/') + 1);
+			if (!path.startsWith("/media/movie/") || !clipName.matches("[av][01]")) {
+				exchange.sendResponseHeaders(404, -1);
+				return;
+			}
+			byte[] content = ("content of " + clipName).getBytes(StandardCharsets.UTF_8);
+			exchange.sendResponseHeaders(200, content.length);
+			try (OutputStream body = exchange.getResponseBody()) {
+				body.write(content);
+			}
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+		}
+	}
+}
@@ -0,0 +1,115 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class MappedRegionCacheTests {
+
+	@TempDir
+	Path directory;
+
+	@Test
+	void sharedMappingTest() throws IOException {
+		Path file = Files.writeString(directory.resolve("v0"), "0123456789");
+		MappedRegionCache mappedRegionCache = new MappedRegionCache(100, 1);
+		try (
+			SeekableByteChannel channel1 = mappedRegionCache.open(file, 2, 5);
+			SeekableByteChannel channel2 = mappedRegionCache.open(file, 2, 5)
+		) {
+			assertEquals("23456", readFully(channel1), "Unexpected content of the region");
+			assertEquals("23456", readFully(channel2), "Unexpected content of the region");
+		}
+		assertEquals(1, mappedRegionCache.getMisses(), "The region was mapped more than once");
+		assertEquals(1, mappedRegionCache.getHits(), "Unexpected amount of hits");
+		assertEquals(5, mappedRegionCache.getMappedBytes(), "Unexpected amount of mapped bytes");
+	}
+
+	@Test
+	void evictionTest() throws IOException {
+		Path file1 = Files.writeString(directory.resolve("v0"), "0123456789");
+		Path file2 = Files.writeString(directory.resolve("v1"), "abcdefghij");
+		MappedRegionCache mappedRegionCache = new MappedRegionCache(15, 1);
+		try (SeekableByteChannel channel = mappedRegionCache.open(file1, 0, -1)) {
+			mappedRegionCache.open(file2, 0, -1).close();
+			assertEquals(10, mappedRegionCache.getMappedBytes(), "The budget was exceeded");
+			assertEquals("0123456789", readFully(channel), "The evicted mapping was unmapped while being read");
+		}
+		mappedRegionCache.open(file2, 0, -1).close();
+		assertEquals(1, mappedRegionCache.getHits(), "The most recently used mapping was evicted");
+	}
+
+	@Test
+	void oversizedRegionTest() throws IOException {
+		Path file = Files.writeString(directory.resolve("v0"), "0123456789");
+		MappedRegionCache mappedRegionCache = new MappedRegionCache(4, 1);
+		try (SeekableByteChannel channel = mappedRegionCache.open(file, 0, -1)) {
+			assertEquals("0123456789", readFully(channel), "Unexpected content of the region");
+		}
+		assertEquals(0, mappedRegionCache.getMappedBytes(), "The region larger than the budget was cached");
+	}
+
+	@Test
+	void mapThresholdTest() throws IOException {
+		Path file = Files.writeString(directory.resolve("v0"), "0123456789");
+		MappedRegionCache mappedRegionCache = new MappedRegionCache(100, 3);
+		for (int i = 0; i < 2; i++) {
+			try (SeekableByteChannel channel = mappedRegionCache.open(file, 2, 5)) {
+				assertEquals("23456", readFully(channel), "Unexpected content of the cold region");
+			}
+		}
+		assertEquals(2, mappedRegionCache.getColdReads(), "Unexpected amount of cold reads");
+		assertEquals(0, mappedRegionCache.getMappedBytes(), "The cold region was mapped");
+
+		for (int i = 0; i < 2; i++) {
+			try (SeekableByteChannel channel = mappedRegionCache.open(file, 2, 5)) {
+				assertEquals("23456", readFully(channel), "Unexpected content of the hot region");
+			}
+		}
+		assertEquals(1, mappedRegionCache.getMisses(), "The hot region wasn't mapped once");
+		assertEquals(1, mappedRegionCache.getHits(), "The mapping of the hot region wasn't reused");
+		assertEquals(5, mappedRegionCache.getMappedBytes(), "Unexpected amount of mapped bytes");
+	}
+
+	@Test
+	void fileKeyTest() throws IOException {
+		Path file = Files.writeString(directory.resolve("v0"), "0123456789");
+		MappedRegionCache mappedRegionCache = new MappedRegionCache(100, 1);
+		mappedRegionCache.open(file, "first", 0, 5).close();
+		mappedRegionCache.open(file, "second", 0, 5).close();
+		assertEquals(2, mappedRegionCache.getMisses(), "The mapping of a replaced file was reused");
+	}
+
+	static String readFully(SeekableByteChannel channel) throws IOException {
+		ByteBuffer buffer = ByteBuffer.allocate((int) channel.size());
+		while (buffer.hasRemaining() && channel.read(buffer) != -1);
+		return new String(buffer.array(), 0, buffer.position(), StandardCharsets.UTF_8);
+	}
+}
@@ -0,0 +1,89 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import backend.ingestion.MediaPacker;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+import java.io.IOException;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+
+import static backend.querying.MappedRegionCacheTests.readFully;
+import static org.junit.jupiter.api.Assertions.*;
+
+public class MmapQueryingStrategyTests {
+
+	@TempDir
+	Path directory;
+
+	MappedRegionCache mappedRegionCache = new MappedRegionCache(1024, 1);
+
+	@BeforeEach
+	void writeClips() throws IOException {
+		for (String clipName: new String[] {"v0", "a0", "v1", "a1"}) {
+			Files.writeString(directory.resolve(clipName), "content of " + clipName);
+		}
+	}
+
+	@ParameterizedTest
+	@ValueSource(booleans = {false, true})
+	void queryTest(boolean packed) throws IOException {
+		if (packed) {
+			MediaPacker.pack(directory);
+			MediaPacker.removeClips(directory);
+		}
+		MmapQueryingStrategy mmapQueryingStrategy = new MmapQueryingStrategy(directory, mappedRegionCache);
+		assertEquals(packed, mmapQueryingStrategy.getPackFile() != null, "The pack file wasn't detected");
+
+		SeekableByteChannel[] channels = mmapQueryingStrategy.query(new String[] {"v1", "a1"});
+		assertEquals("content of v1", readFully(channels[0]), "Unexpected content of v1");
+		assertEquals("content of a1", readFully(channels[1]), "Unexpected content of a1");
+		for (SeekableByteChannel channel: channels) channel.close();
+		assertThrows(
+			QueryingException.class,
+			() -> mmapQueryingStrategy.query(new String[] {"v0", "v2"}),
+			"An absent resource was returned"
+		);
+		mmapQueryingStrategy.query("v1").close();
+		assertEquals(1, mappedRegionCache.getHits(), "The mapping wasn't reused");
+	}
+
+	@Test
+	void replacedFileTest() throws IOException {
+		MmapQueryingStrategy mmapQueryingStrategy = new MmapQueryingStrategy(directory, mappedRegionCache);
+		assertEquals("content of v0", readFully(mmapQueryingStrategy.query("v0")), "Unexpected content of v0");
+
+		Path replacement = Files.writeString(directory.resolve("v0.new"), "new content of v0");
+		Files.move(replacement, directory.resolve("v0"), StandardCopyOption.REPLACE_EXISTING);
+		assertEquals(
+			"new content of v0",
+			readFully(mmapQueryingStrategy.query("v0")),
+			"The replaced file was read from the previous mapping"
+		);
+	}
+}
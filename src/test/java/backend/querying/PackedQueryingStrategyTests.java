@@ -0,0 +1,133 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package backend.querying;
+
+import backend.exceptions.QueryingException;
+import backend.ingestion.MediaPacker;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.channels.SeekableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class PackedQueryingStrategyTests {
+
+	@TempDir
+	Path directory;
+
+	PackedQueryingStrategy packedQueryingStrategy;
+
+	String[] clipNames = {"v0", "a0", "v1", "a1", "v10", "a10"};
+
+	@BeforeEach
+	void pack() throws IOException {
+		for (String clipName: clipNames) Files.writeString(directory.resolve(clipName), "content of " + clipName);
+		packedQueryingStrategy = new PackedQueryingStrategy(MediaPacker.pack(directory));
+	}
+
+	@AfterEach
+	void close() {
+		packedQueryingStrategy.close();
+	}
+
+	@Test
+	void queryTest() throws IOException {
+		SeekableByteChannel[] channels = packedQueryingStrategy.query(clipNames);
+		for (int i = 0; i < clipNames.length; i++) {
+			assertEquals("content of " + clipNames[i], readFully(channels[i]), "Unexpected content of " + clipNames[i]);
+		}
+		assertThrows(
+			QueryingException.class,
+			() -> packedQueryingStrategy.query(new String[] {"v0", "v2"}),
+			"An absent resource was returned"
+		);
+	}
+
+	@Test
+	void transferTest() throws IOException {
+		FileChannel channel = (FileChannel) packedQueryingStrategy.query("a1");
+		ByteArrayOutputStream outputStream = new ByteArrayOutputStream();
+		long transferred = channel.transferTo(3, Long.MAX_VALUE, Channels.newChannel(outputStream));
+		assertEquals("content of a1".length() - 3, transferred, "The transfer exceeded the resource");
+		assertEquals("tent of a1", outputStream.toString(StandardCharsets.UTF_8), "Unexpected transferred content");
+	}
+
+	@Test
+	void independentPositionsTest() throws IOException {
+		SeekableByteChannel channel1 = packedQueryingStrategy.query("v1");
+		SeekableByteChannel channel2 = packedQueryingStrategy.query("v1");
+		channel1.read(ByteBuffer.allocate(4));
+		assertEquals(4, channel1.position(), "Unexpected position");
+		assertEquals(0, channel2.position(), "The position is shared between the channels");
+		channel1.close();
+		assertEquals("content of v1", readFully(channel2), "Closing a channel affected another one");
+	}
+
+	@Test
+	void corruptedFileTest() throws IOException {
+		Path packFile = directory.resolve(PackedQueryingStrategy.PACK_FILE_NAME);
+		byte[] content = Files.readAllBytes(packFile);
+		Files.write(packFile, ByteBuffer.wrap(content.clone()).putInt(12, Integer.MAX_VALUE).array());
+		assertThrows(
+			IOException.class, () -> new PackedQueryingStrategy(packFile), "An oversized entry count was accepted"
+		);
+		Files.write(packFile, Arrays.copyOf(content, PackedQueryingStrategy.HEADER_LENGTH + 4));
+		assertThrows(IOException.class, () -> new PackedQueryingStrategy(packFile), "A truncated file was accepted");
+		Files.writeString(packFile, "not a pack file at all");
+		assertThrows(IOException.class, () -> new PackedQueryingStrategy(packFile), "A foreign file was accepted");
+	}
+
+	@Test
+	void closeTest() throws IOException {
+		SeekableByteChannel channel = packedQueryingStrategy.query("v1");
+		packedQueryingStrategy.close();
+		assertThrows(
+			QueryingException.class, () -> packedQueryingStrategy.query("v1"), "The closed strategy was queried"
+		);
+		assertEquals("content of v1", readFully(channel), "Closing the strategy broke the open slice");
+		channel.close();
+	}
+
+	@Test
+	void factoryTest() {
+		QueryingStrategyInterface queryingStrategy =
+			new DefaultQueryingStrategyFactory().getQueryingStrategy(directory.toUri());
+		assertInstanceOf(PackedQueryingStrategy.class, queryingStrategy, "The pack file wasn't picked up");
+		((PackedQueryingStrategy) queryingStrategy).close();
+	}
+
+	private static String readFully(SeekableByteChannel channel) throws IOException {
+		ByteBuffer buffer = ByteBuffer.allocate((int) channel.size());
+		while (buffer.hasRemaining() && channel.read(buffer) != -1);
+		return new String(buffer.array(), 0, buffer.position(), StandardCharsets.UTF_8);
+	}
+}
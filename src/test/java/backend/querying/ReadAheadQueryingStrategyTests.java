@@ -0,0 +1,105 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package backend.querying;
+
+import backend.adapters.ArraySeekableByteChannel;
+import backend.exceptions.QueryingException;
+import backend.stubs.QueryingStrategyInterfaceStub;
+import org.junit.jupiter.api.Test;
+
+import java.nio.channels.SeekableByteChannel;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.function.BooleanSupplier;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class ReadAheadQueryingStrategyTests {
+
+	Set<String> queriedNames = ConcurrentHashMap.newKeySet();
+
+	CountDownLatch warmedClips = new CountDownLatch(3);
+
+	QueryingStrategyInterfaceStub queryingStrategyStub = new QueryingStrategyInterfaceStub();
+
+	ReadAheadQueryingStrategy readAheadQueryingStrategy = new ReadAheadQueryingStrategy(queryingStrategyStub, 2);
+
+	{
+		queryingStrategyStub.queryFunction = names -> {
+			SeekableByteChannel[] channels = new SeekableByteChannel[names.length];
+			for (int i = 0; i < names.length; i++) {
+				if (queriedNames.add(names[i]) && List.of("v6", "v7", "a6").contains(names[i])) {
+					warmedClips.countDown();
+				}
+				// The audio clips end with a5, while the video clips go on
+				if (names[i].equals("a6")) throw new QueryingException();
+				channels[i] = new ArraySeekableByteChannel(new byte[10]);
+			}
+			return channels;
+		};
+	}
+
+	@Test
+	void readAheadTest() throws InterruptedException {
+		readAheadQueryingStrategy.query(new String[] {"v4", "a4", "v5", "a5"});
+		assertTrue(warmedClips.await(10, TimeUnit.SECONDS), "The upcoming clips weren't read ahead");
+		assertFalse(queriedNames.contains("v8"), "More clips than configured were read ahead");
+		assertTrue(
+			waitUntil(() -> readAheadQueryingStrategy.getWarmedBytes() == 20), "Unexpected amount of warmed bytes"
+		);
+		assertFalse(queriedNames.contains("a7"), "The clips past the end of the media were read ahead");
+	}
+
+	@Test
+	void queueDuringWarmingTest() throws InterruptedException {
+		CountDownLatch warmingStarted = new CountDownLatch(1), release = new CountDownLatch(1);
+		queryingStrategyStub.queryFunction = names -> {
+			SeekableByteChannel[] channels = new SeekableByteChannel[names.length];
+			for (int i = 0; i < names.length; i++) {
+				queriedNames.add(names[i]);
+				if (names[i].equals("v2")) {
+					warmingStarted.countDown();
+					try {
+						release.await();
+					} catch (InterruptedException e) {
+						throw new QueryingException(e);
+					}
+				}
+				channels[i] = new ArraySeekableByteChannel(new byte[10]);
+			}
+			return channels;
+		};
+		readAheadQueryingStrategy.query("v1");
+		assertTrue(warmingStarted.await(10, TimeUnit.SECONDS), "The warming didn't start");
+		readAheadQueryingStrategy.query("v10");
+		release.countDown();
+		assertTrue(
+			waitUntil(() -> queriedNames.containsAll(List.of("v2", "v3", "v11", "v12"))),
+			"The clips requested during a warming weren't read ahead"
+		);
+	}
+
+	static boolean waitUntil(BooleanSupplier condition) throws InterruptedException {
+		for (int i = 0; i < 1000 && !condition.getAsBoolean(); i++) Thread.sleep(10);
+		return condition.getAsBoolean();
+	}
+}
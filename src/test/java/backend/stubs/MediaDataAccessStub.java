@@ -23,20 +23,34 @@ import backend.exceptions.NotImplementedExceptions;
 import backend.exceptions.CommonDataAccessException;
 import backend.interactors.MediaDataAccess;
 import backend.models.Media;
+import backend.models.MediaPage;
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 
 import java.util.UUID;
+import java.util.function.BiFunction;
 import java.util.function.Supplier;
 import java.util.function.Function;
 
 public class MediaDataAccessStub implements MediaDataAccess {
 
+	public interface PageFunction {
+
+		MediaPage apply(String searchQuery, int limit, String cursor);
+	}
+
 	public Supplier<Media[]> getMultipleMediaSupplier = () -> { throw new NotImplementedExceptions(); };
 
 	public Function<UUID, Media> getSingleMediaFunction = media -> { throw new NotImplementedExceptions(); };
 
 	public Function<String, Media[]> searchMediaFunction = query -> { throw new NotImplementedExceptions(); };
 
+	public PageFunction searchMediaPageFunction = (query, limit, cursor) -> { throw new NotImplementedExceptions(); };
+
+	public BiFunction<String, Integer, Media[]> suggestMediaFunction = (prefix, limit) -> {
+		throw new NotImplementedExceptions();
+	};
+
 	@Nonnull
 	@Override
 	public Media[] getMedia() throws CommonDataAccessException {
@@ -53,4 +67,17 @@ public class MediaDataAccessStub implements MediaDataAccess {
 	public Media[] searchMedia(@Nonnull String searchQuery) throws CommonDataAccessException {
 		return searchMediaFunction.apply(searchQuery);
 	}
+
+	@Nonnull
+	@Override
+	public MediaPage searchMedia(@Nonnull String searchQuery, int limit, @Nullable String cursor)
+		throws CommonDataAccessException {
+		return searchMediaPageFunction.apply(searchQuery, limit, cursor);
+	}
+
+	@Nonnull
+	@Override
+	public Media[] suggestMedia(@Nonnull String prefix, int limit) throws CommonDataAccessException {
+		return suggestMediaFunction.apply(prefix, limit);
+	}
 }
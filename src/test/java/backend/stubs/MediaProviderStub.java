@@ -23,6 +23,7 @@ import backend.exceptions.CommonSecurityException;
 import backend.exceptions.NotImplementedExceptions;
 import backend.interactors.MediaProvider;
 import backend.models.Media;
+import backend.models.MediaPage;
 import backend.models.Viewer;
 import jakarta.annotation.Nonnull;
 import jakarta.annotation.Nullable;
@@ -33,6 +34,16 @@ import java.util.function.Function;
 
 public class MediaProviderStub implements MediaProvider {
 
+	public interface PageFunction {
+
+		MediaPage apply(Viewer viewer, String searchQuery, int limit, String cursor);
+	}
+
+	public interface SuggestFunction {
+
+		Media[] apply(Viewer viewer, String prefix, int limit);
+	}
+
 	public BiFunction<Viewer, UUID, Media> getSingleMediaStrategy = (viewer, id) -> {
 		throw new NotImplementedExceptions();
 	};
@@ -45,6 +56,14 @@ public class MediaProviderStub implements MediaProvider {
 		throw new NotImplementedExceptions();
 	};
 
+	public PageFunction searchMediaPage = (viewer, query, limit, cursor) -> {
+		throw new NotImplementedExceptions();
+	};
+
+	public SuggestFunction suggestMedia = (viewer, prefix, limit) -> {
+		throw new NotImplementedExceptions();
+	};
+
 	@Nullable
 	@Override
 	public Media getMedia(@Nonnull Viewer viewer, @Nonnull UUID mediaId) throws CommonSecurityException {
@@ -62,4 +81,18 @@ public class MediaProviderStub implements MediaProvider {
 	public Media[] searchMedia(@Nonnull Viewer viewer, @Nonnull String searchQuery) throws CommonSecurityException {
 		return searchMedia.apply(viewer, searchQuery);
 	}
+
+	@Nonnull
+	@Override
+	public MediaPage searchMedia(
+		@Nonnull Viewer viewer, @Nonnull String searchQuery, int limit, @Nullable String cursor
+	) throws CommonSecurityException {
+		return searchMediaPage.apply(viewer, searchQuery, limit, cursor);
+	}
+
+	@Nonnull
+	@Override
+	public Media[] suggestMedia(@Nonnull Viewer viewer, @Nonnull String prefix, int limit) {
+		return suggestMedia.apply(viewer, prefix, limit);
+	}
 }
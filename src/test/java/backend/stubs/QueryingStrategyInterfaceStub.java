@@ -34,6 +34,10 @@ public class QueryingStrategyInterfaceStub implements QueryingStrategyInterface
 		throw new NotImplementedExceptions();
 	};
 
+	public Runnable closeRunnable = () -> {
+		throw new NotImplementedExceptions();
+	};
+
 	@Override
 	public Object addToEnvironment(@Nonnull String name, Object value) {
 		throw new NotImplementedExceptions();
@@ -64,6 +68,6 @@ public class QueryingStrategyInterfaceStub implements QueryingStrategyInterface
 
 	@Override
 	public void close() {
-		throw new NotImplementedExceptions();
+		closeRunnable.run();
 	}
 }
@@ -23,6 +23,7 @@ import backend.exceptions.NotImplementedExceptions;
 import backend.models.SqlRow;
 import backend.persistence.SqlAccessStrategy;
 import jakarta.annotation.Nonnull;
+import jakarta.annotation.Nullable;
 
 import java.sql.SQLException;
 import java.util.stream.Stream;
@@ -39,6 +40,11 @@ public class SqlAccessStrategyStub implements SqlAccessStrategy {
 		R apply(T t, U u) throws SQLException;
 	}
 
+	public interface PageFunction<R> {
+
+		R apply(String searchQuery, int limit, Float lastRank, String lastId, String[] columns) throws SQLException;
+	}
+
 	public Function<String[], Stream<SqlRow>> queryMultipleSqlRowsFunction = columns -> {
 		throw new NotImplementedExceptions();
 	};
@@ -51,6 +57,19 @@ public class SqlAccessStrategyStub implements SqlAccessStrategy {
 		throw new NotImplementedExceptions();
 	};
 
+	public interface PrefixFunction<R> {
+
+		R apply(String prefix, int limit, String[] columns) throws SQLException;
+	}
+
+	public PageFunction<Stream<SqlRow>> searchInTitlePageFunction = (query, limit, lastRank, lastId, columns) -> {
+		throw new NotImplementedExceptions();
+	};
+
+	public PrefixFunction<Stream<SqlRow>> searchTitlePrefixFunction = (prefix, limit, columns) -> {
+		throw new NotImplementedExceptions();
+	};
+
 	@Nonnull
 	@Override
 	public Stream<SqlRow> query(@Nonnull String[] columnsNames) throws SQLException {
@@ -69,4 +88,24 @@ public class SqlAccessStrategyStub implements SqlAccessStrategy {
 	) throws SQLException {
 		return searchItTitleFunction.apply(searchQuery, columnsNames);
 	}
+
+	@Nonnull
+	@Override
+	public Stream<SqlRow> searchInTitle(
+		@Nonnull String searchQuery,
+		int limit,
+		@Nullable Float lastRank,
+		@Nullable String lastId,
+		@Nonnull String[] columnsNames
+	) throws SQLException {
+		return searchInTitlePageFunction.apply(searchQuery, limit, lastRank, lastId, columnsNames);
+	}
+
+	@Nonnull
+	@Override
+	public Stream<SqlRow> searchTitlePrefix(
+		@Nonnull String prefix, int limit, @Nonnull String[] columnsNames
+	) throws SQLException {
+		return searchTitlePrefixFunction.apply(prefix, limit, columnsNames);
+	}
 }
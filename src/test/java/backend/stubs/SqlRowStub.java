@@ -34,6 +34,11 @@ public class SqlRowStub implements SqlRow {
 		return hashMap.get(columnName) == null ? 0 : (int) hashMap.get(columnName);
 	}
 
+	@Override
+	public float getFloat(@Nonnull String columnName) {
+		return hashMap.get(columnName) == null ? 0 : ((Number) hashMap.get(columnName)).floatValue();
+	}
+
 	@Nullable
 	@Override
 	public String getString(@Nonnull String columnName) {
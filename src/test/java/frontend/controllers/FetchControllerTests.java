@@ -35,6 +35,7 @@ import org.junit.jupiter.api.Test;
 
 import java.io.IOException;
 import java.lang.reflect.Field;
+import java.nio.ByteBuffer;
 import java.util.Arrays;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.atomic.AtomicInteger;
@@ -92,7 +93,7 @@ public class FetchControllerTests {
 				assertEquals(expectedAmount, amount, "Unexpected amount value");
 			};
 			MediaFetch mediaFetch = new MediaFetch(
-				mediaId, expectedOffset, new byte[expectedAmount][0], new byte[expectedAmount][0]
+				mediaId, expectedOffset, emptyClips(expectedAmount), emptyClips(expectedAmount)
 			);
 			rubusClientStub.sendFunction = (request, timeout) -> {
 				assertSame(
@@ -127,7 +128,7 @@ public class FetchControllerTests {
 				assertEquals(expectedAmount, amount, "Unexpected amount value");
 			};
 			MediaFetch mediaFetch = new MediaFetch(
-				mediaId, expectedOffset, new byte[expectedAmount][0], new byte[expectedAmount][0]
+				mediaId, expectedOffset, emptyClips(expectedAmount), emptyClips(expectedAmount)
 			);
 			rubusClientStub.sendFunction = (request, timeout) -> {
 				assertSame(
@@ -192,8 +193,8 @@ public class FetchControllerTests {
 				MediaFetch mediaFetch = new MediaFetch(
 					mediaId,
 					updatedExceptedOffset,
-					new byte[updatedExceptedAmount][0],
-					new byte[updatedExceptedAmount][0]
+					emptyClips(updatedExceptedAmount),
+					emptyClips(updatedExceptedAmount)
 				);
 				rubusClientStub.sendFunction = (request, timeout) -> {
 					assertSame(
@@ -230,8 +231,8 @@ public class FetchControllerTests {
 				MediaFetch mediaFetch = new MediaFetch(
 					mediaId,
 					updatedExceptedOffset,
-					new byte[updatedExceptedAmount][0],
-					new byte[updatedExceptedAmount][0]
+					emptyClips(updatedExceptedAmount),
+					emptyClips(updatedExceptedAmount)
 				);
 				rubusClientStub.sendFunction = (request, timeout) -> {
 					assertSame(
@@ -263,7 +264,7 @@ public class FetchControllerTests {
 		@BeforeEach
 		void beforeEach() {
 			videoPlayerStub.isBuffering = false;
-			videoPlayerStub.playbackClip = new EncodedPlaybackClip(new byte[0], new byte[0]);
+			videoPlayerStub.playbackClip = emptyClip();
 		}
 
 		@Nested
@@ -279,7 +280,7 @@ public class FetchControllerTests {
 					assertEquals(expectedAmount, amount, "Unexpected amount value");
 				};
 				MediaFetch mediaFetch = new MediaFetch(
-					mediaId, expectedOffset, new byte[expectedAmount][0], new byte[expectedAmount][0]
+					mediaId, expectedOffset, emptyClips(expectedAmount), emptyClips(expectedAmount)
 				);
 				rubusClientStub.sendFunction = (request, timeout) -> {
 					assertSame(
@@ -314,7 +315,7 @@ public class FetchControllerTests {
 					assertEquals(expectedAmount, amount, "Unexpected amount value");
 				};
 				MediaFetch mediaFetch = new MediaFetch(
-					mediaId, expectedOffset, new byte[expectedAmount][0], new byte[expectedAmount][0]
+					mediaId, expectedOffset, emptyClips(expectedAmount), emptyClips(expectedAmount)
 				);
 				rubusClientStub.sendFunction = (request, timeout) -> {
 					assertSame(
@@ -363,7 +364,7 @@ public class FetchControllerTests {
 				void playingNextToLastClip() throws IllegalAccessException {
 					videoPlayerStub.progress = videoPlayerStub.getVideoDuration() - 2;
 					videoPlayerStub.buffer =
-						new EncodedPlaybackClip[]{new EncodedPlaybackClip(new byte[0], new byte[0])};
+						new EncodedPlaybackClip[]{emptyClip()};
 
 					controller.update(videoPlayerStub);
 
@@ -379,7 +380,7 @@ public class FetchControllerTests {
 				void playingFromStart() throws IllegalAccessException {
 					videoPlayerStub.duration = bufferSize + 1;
 					videoPlayerStub.buffer = new EncodedPlaybackClip[bufferSize];
-					Arrays.setAll(videoPlayerStub.buffer, i -> new EncodedPlaybackClip(new byte[0], new byte[0]));
+					Arrays.setAll(videoPlayerStub.buffer, i -> emptyClip());
 
 					controller.update(videoPlayerStub);
 
@@ -399,7 +400,7 @@ public class FetchControllerTests {
 				void playingFromStart() throws IllegalAccessException {
 					videoPlayerStub.duration = bufferSize + 2;
 					videoPlayerStub.buffer = new EncodedPlaybackClip[bufferSize];
-					Arrays.setAll(videoPlayerStub.getBuffer(), i -> new EncodedPlaybackClip(new byte[0], new byte[0]));
+					Arrays.setAll(videoPlayerStub.getBuffer(), i -> emptyClip());
 
 					controller.update(videoPlayerStub);
 
@@ -415,7 +416,7 @@ public class FetchControllerTests {
 				void playingFromMiddle() throws IllegalAccessException {
 					videoPlayerStub.progress = 5;
 					videoPlayerStub.buffer = new EncodedPlaybackClip[bufferSize];
-					Arrays.setAll(videoPlayerStub.getBuffer(), i -> new EncodedPlaybackClip(new byte[0], new byte[0]));
+					Arrays.setAll(videoPlayerStub.getBuffer(), i -> emptyClip());
 					videoPlayerStub.duration = videoPlayerStub.getProgress() + bufferSize + 2;
 
 					controller.update(videoPlayerStub);
@@ -436,7 +437,7 @@ public class FetchControllerTests {
 			@Test
 			void hasOneClip() throws InterruptedException, IllegalAccessException {
 				videoPlayerStub.buffer =
-					new EncodedPlaybackClip[] { new EncodedPlaybackClip(new byte[0], new byte[0]) };
+					new EncodedPlaybackClip[] { emptyClip() };
 				int initialBufferSize = videoPlayerStub.getBuffer().length;
 				int expectedOffset = videoPlayerStub.getProgress() + initialBufferSize + 1;
 				int expectedAmount = videoPlayerStub.getVideoDuration() - expectedOffset;
@@ -446,7 +447,7 @@ public class FetchControllerTests {
 					assertEquals(expectedAmount, amount, "Unexpected amount value");
 				};
 				MediaFetch mediaFetch = new MediaFetch(
-					mediaId, expectedOffset, new byte[expectedAmount][0], new byte[expectedAmount][0]
+					mediaId, expectedOffset, emptyClips(expectedAmount), emptyClips(expectedAmount)
 				);
 				rubusClientStub.sendFunction = (request, timeout) -> {
 					assertSame(
@@ -474,7 +475,7 @@ public class FetchControllerTests {
 			void lacksOneClip() throws InterruptedException, IllegalAccessException {
 				videoPlayerStub.duration = bufferSize + 1;
 				videoPlayerStub.buffer = new EncodedPlaybackClip[bufferSize - 1];
-				Arrays.setAll(videoPlayerStub.buffer, i -> new EncodedPlaybackClip(new byte[0], new byte[0]));
+				Arrays.setAll(videoPlayerStub.buffer, i -> emptyClip());
 				int initialBufferSize = videoPlayerStub.getBuffer().length;
 				int expectedOffset = videoPlayerStub.getProgress() + initialBufferSize + 1;
 				int expectedAmount = videoPlayerStub.getVideoDuration() - expectedOffset;
@@ -484,7 +485,7 @@ public class FetchControllerTests {
 					assertEquals(expectedAmount, amount, "Unexpected amount value");
 				};
 				MediaFetch mediaFetch = new MediaFetch(
-					mediaId, expectedOffset, new byte[expectedAmount][0], new byte[expectedAmount][0]
+					mediaId, expectedOffset, emptyClips(expectedAmount), emptyClips(expectedAmount)
 				);
 				rubusClientStub.sendFunction = (request, timeout) -> {
 					assertSame(
@@ -516,7 +517,7 @@ public class FetchControllerTests {
 				) throws IllegalAccessException, InterruptedException {
 					videoPlayerStub.progress = 5;
 					videoPlayerStub.buffer = new EncodedPlaybackClip[3];
-					Arrays.setAll(videoPlayerStub.buffer, i -> new EncodedPlaybackClip(new byte[0], new byte[0]));
+					Arrays.setAll(videoPlayerStub.buffer, i -> emptyClip());
 					int initialBufferSize = videoPlayerStub.getBuffer().length;
 					int exceptedOffset = videoPlayerStub.getProgress() + initialBufferSize + 1;
 					int exceptedAmount = videoPlayerStub.getVideoDuration() - exceptedOffset;
@@ -526,7 +527,7 @@ public class FetchControllerTests {
 						assertEquals(exceptedAmount, amount, "Unexpected amount value");
 					};
 					MediaFetch mediaFetch = new MediaFetch(
-						mediaId, exceptedOffset, new byte[exceptedAmount][0], new byte[exceptedAmount][0]
+						mediaId, exceptedOffset, emptyClips(exceptedAmount), emptyClips(exceptedAmount)
 					);
 					CountDownLatch countDownLatch = new CountDownLatch(1);
 					rubusClientStub.sendFunction = (request, timeout) -> {
@@ -544,7 +545,7 @@ public class FetchControllerTests {
 
 					videoPlayerStub.progress += 1;
 					videoPlayerStub.buffer = new EncodedPlaybackClip[initialBufferSize - 1];
-					Arrays.setAll(videoPlayerStub.buffer, i -> new EncodedPlaybackClip(new byte[0], new byte[0]));
+					Arrays.setAll(videoPlayerStub.buffer, i -> emptyClip());
 					int updatedBufferSize = videoPlayerStub.getBuffer().length;
 
 					controller.update(videoPlayerStub);
@@ -703,4 +704,14 @@ public class FetchControllerTests {
 			);
 		}
 	}
+
+	private static EncodedPlaybackClip emptyClip() {
+		return new EncodedPlaybackClip(ByteBuffer.allocate(0), ByteBuffer.allocate(0));
+	}
+
+	private static ByteBuffer[] emptyClips(int amount) {
+		ByteBuffer[] clips = new ByteBuffer[amount];
+		Arrays.setAll(clips, i -> ByteBuffer.allocate(0));
+		return clips;
+	}
 }
@@ -19,10 +19,17 @@
 
 package frontend.converters;
 
+import frontend.adapters.ArraySeekableByteChannel;
 import frontend.models.MediaFetch;
+import org.junit.jupiter.api.Test;
 
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.SeekableByteChannel;
 import java.util.Arrays;
 
+import static org.junit.jupiter.api.Assertions.assertSame;
+
 public class MediaFetchBinaryConverterTests extends BinaryConverterTests<MediaFetch> {
 
 	@Override
@@ -30,13 +37,13 @@ public class MediaFetchBinaryConverterTests extends BinaryConverterTests<MediaFe
 		return new MediaFetch(
 			"abcd",
 			3,
-			new byte[][] {
-				{0, 1, 2, 3},
-				{4, 5, 6, 7}
+			new ByteBuffer[] {
+				ByteBuffer.wrap(new byte[] {0, 1, 2, 3}),
+				ByteBuffer.wrap(new byte[] {4, 5, 6, 7})
 			},
-			new byte[][] {
-				{10, 11, 12, 13},
-				{14, 15, 16, 17}
+			new ByteBuffer[] {
+				ByteBuffer.wrap(new byte[] {10, 11, 12, 13}),
+				ByteBuffer.wrap(new byte[] {14, 15, 16, 17})
 			}
 		);
 	}
@@ -53,4 +60,17 @@ public class MediaFetchBinaryConverterTests extends BinaryConverterTests<MediaFe
 			Arrays.deepEquals(m1.video(), m2.video()) &&
 			Arrays.deepEquals(m1.audio(), m2.audio());
 	}
+
+	@Test
+	void decodedClipsAreViewsOfMessage() throws IOException {
+		BinaryConverter<MediaFetch> converter = getConverter();
+		ByteBuffer message;
+		try (SeekableByteChannel conversionOutput = converter.convert(getModel())) {
+			message = ByteBuffer.allocate((int) conversionOutput.size());
+			while (message.hasRemaining() && conversionOutput.read(message) != -1);
+		}
+		MediaFetch mediaFetch = converter.convert(new ArraySeekableByteChannel(message.array()));
+		for (ByteBuffer clip: mediaFetch.video()) assertSame(message.array(), clip.array());
+		for (ByteBuffer clip: mediaFetch.audio()) assertSame(message.array(), clip.array());
+	}
 }
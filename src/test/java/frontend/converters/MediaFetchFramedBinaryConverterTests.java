@@ -0,0 +1,74 @@
+/*
+ * Rubus is a protocol for video and audio streaming and
+ * the client and server reference implementations.
+ * Copyright (C) 2025 Yegore Vlussove
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package frontend.converters;
+
+import frontend.adapters.ArraySeekableByteChannel;
+import frontend.models.MediaFetch;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+public class MediaFetchFramedBinaryConverterTests extends MediaFetchBinaryConverterTests {
+
+	@Override
+	public MediaFetch getModel() {
+		return new MediaFetch(
+			"7993e94c-69c0-44bf-903e-d1c78137943a",
+			3,
+			new ByteBuffer[] {
+				ByteBuffer.wrap(new byte[] {0, 1, 2, 3}),
+				ByteBuffer.wrap(new byte[] {4, 5, 6, 7})
+			},
+			new ByteBuffer[] {
+				ByteBuffer.wrap(new byte[] {10, 11, 12, 13}),
+				ByteBuffer.wrap(new byte[] {14, 15, 16, 17})
+			}
+		);
+	}
+
+	@Override
+	public BinaryConverter<MediaFetch> getConverter() {
+		return new MediaFetchFramedBinaryConverter();
+	}
+
+	@ParameterizedTest
+	@ValueSource(ints = {Integer.MAX_VALUE / 8, 1})
+	void oversizedMessageTest(int clipAmount) {
+		// The header claims more clips, or larger clips, than the message holds
+		ByteBuffer message = ByteBuffer.allocate(30 + 8)
+			.putInt(MediaFetchFramedBinaryConverter.MAGIC)
+			.putShort(MediaFetchFramedBinaryConverter.VERSION)
+			.putLong(0)
+			.putLong(0)
+			.putInt(0)
+			.putInt(clipAmount)
+			.putInt(Integer.MAX_VALUE)
+			.putInt(Integer.MAX_VALUE);
+		assertThrows(
+			IOException.class,
+			() -> getConverter().convert(new ArraySeekableByteChannel(message.array())),
+			"The oversized message was accepted"
+		);
+	}
+}
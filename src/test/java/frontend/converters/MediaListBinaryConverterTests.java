@@ -22,15 +22,19 @@ package frontend.converters;
 import frontend.models.MediaList;
 
 import java.util.Map;
+import java.util.Objects;
 
 public class MediaListBinaryConverterTests extends BinaryConverterTests<MediaList> {
 
 	@Override
 	public MediaList getModel() {
-		return new MediaList(Map.of(
-			"abcd", "title1",
-			"0123", "title2"
-		));
+		return new MediaList(
+			Map.of(
+				"abcd", "title1",
+				"0123", "title2"
+			),
+			"0123"
+		);
 	}
 
 	@Override
@@ -40,6 +44,6 @@ public class MediaListBinaryConverterTests extends BinaryConverterTests<MediaLis
 
 	@Override
 	public boolean testEquality(MediaList m1, MediaList m2) {
-		return m1.media().equals(m2.media());
+		return m1.media().equals(m2.media()) && Objects.equals(m1.cursor(), m2.cursor());
 	}
 }
\ No newline at end of file
@@ -146,6 +146,33 @@ public class HttpRubusRequestTests {
 							.build(),
 						new String[] {"request_type=LIST", "search_query=%26"},
 						host + ":" + port
+					),
+					Arguments.of(
+						new HttpRubusRequest.Builder()
+							.host(host)
+							.port(port)
+							.LIST("qwerty", 20, null)
+							.build(),
+						new String[] {"limit=20", "request_type=LIST", "search_query=qwerty"},
+						host + ":" + port
+					),
+					Arguments.of(
+						new HttpRubusRequest.Builder()
+							.host(altHost)
+							.port(altPort)
+							.LIST("", 5, "abcd")
+							.build(),
+						new String[] {"cursor=abcd", "limit=5", "request_type=LIST", "search_query="},
+						altHost + ":" + altPort
+					),
+					Arguments.of(
+						new HttpRubusRequest.Builder()
+							.host(host)
+							.port(port)
+							.LIST_PREFIX("qwe", 10)
+							.build(),
+						new String[] {"limit=10", "request_type=LIST", "search_mode=prefix", "search_query=qwe"},
+						host + ":" + port
 					)
 				);
 			}
@@ -400,4 +427,12 @@ public class HttpRubusRequestTests {
 			);
 		}
 	}
+
+	@Test
+	void requestTypeTest() {
+		HttpRubusRequest.Builder httpRubusRequestBuilder = new HttpRubusRequest.Builder().host(host).port(port);
+		assertEquals("LIST", httpRubusRequestBuilder.LIST().build().getRequestType());
+		assertEquals("INFO", httpRubusRequestBuilder.INFO("id").build().getRequestType());
+		assertEquals("FETCH", httpRubusRequestBuilder.FETCH("id", 0, 1).build().getRequestType());
+	}
 }
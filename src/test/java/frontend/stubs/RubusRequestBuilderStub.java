@@ -23,6 +23,7 @@ import frontend.exceptions.NotImplementedExceptions;
 import frontend.network.RubusRequest;
 import jakarta.annotation.Nonnull;
 
+import java.util.function.BiConsumer;
 import java.util.function.Consumer;
 
 public class RubusRequestBuilderStub implements RubusRequest.Builder {
@@ -42,6 +43,12 @@ public class RubusRequestBuilderStub implements RubusRequest.Builder {
 
 	public Consumer<String> listConsumer = q -> { throw new NotImplementedExceptions(); };
 
+	public TriConsumer<String, Integer, String> pagedListConsumer = (q, l, c) -> {
+		throw new NotImplementedExceptions();
+	};
+
+	public BiConsumer<String, Integer> prefixListConsumer = (p, l) -> { throw new NotImplementedExceptions(); };
+
 	public Consumer<String> infoConsumer = id -> { throw new NotImplementedExceptions(); };
 
 	public TriConsumer<String, Integer, Integer> fetchConsumer = (id, i1, i2) -> {
@@ -72,6 +79,18 @@ public class RubusRequestBuilderStub implements RubusRequest.Builder {
 		return this;
 	}
 
+	@Override
+	public RubusRequest.Builder LIST(@Nonnull String searchQuery, int limit, String cursor) {
+		pagedListConsumer.accept(searchQuery, limit, cursor);
+		return this;
+	}
+
+	@Override
+	public RubusRequest.Builder LIST_PREFIX(@Nonnull String prefix, int limit) {
+		prefixListConsumer.accept(prefix, limit);
+		return this;
+	}
+
 	@Override
 	public RubusRequest.Builder INFO(@Nonnull String mediaId) {
 		infoConsumer.accept(mediaId);